@@ -0,0 +1,60 @@
+#!/usr/bin/python
+
+###############################################################################
+#
+# compares two result files of sequence_bench
+#
+# usage:
+#    ./compare_bench.py <baseline.json> <current.json> [threshold_percent]
+#
+# prints per-benchmark speed ratios; exits with 1 if any benchmark
+# got slower than the threshold (default: 10%)
+#
+# (c) 2013-2017 Andre Mueller
+#
+###############################################################################
+
+from __future__ import print_function
+
+import json
+from sys import argv, exit
+
+
+def load(filename):
+    with open(filename, 'r') as f:
+        data = json.load(f)
+    return dict(((b["sequence"], b["value_type"], b["kernel"]),
+                 b["ns_per_element"]) for b in data["benchmarks"])
+
+
+if len(argv) < 3:
+    print("usage: " + argv[0] + " <baseline.json> <current.json> [threshold_percent]")
+    exit(2)
+
+base = load(argv[1])
+curr = load(argv[2])
+threshold = float(argv[3]) if len(argv) > 3 else 10.0
+
+regressions = 0
+for key in sorted(base.keys()):
+    if key not in curr:
+        continue
+    old = base[key]
+    new = curr[key]
+    change = 100.0 * (new - old) / old if old > 0 else 0.0
+    mark = ""
+    if change > threshold:
+        mark = "  <-- SLOWER"
+        regressions += 1
+    elif change < -threshold:
+        mark = "  faster"
+    print("%-22s %-7s %-18s %9.3f -> %9.3f ns  %+7.1f%%%s" %
+          (key[0], key[1], key[2], old, new, change, mark))
+
+missing = [k for k in base.keys() if k not in curr]
+for key in sorted(missing):
+    print("%-22s %-7s %-18s missing in %s" % (key[0], key[1], key[2], argv[2]))
+
+if regressions > 0:
+    print(str(regressions) + " benchmark(s) slower than " + str(threshold) + "%")
+    exit(1)
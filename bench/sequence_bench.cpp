@@ -0,0 +1,501 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+/*
+ * micro-benchmarks for all sequence generators and decorators
+ *
+ * build & run (from repository root):
+ *   g++ -std=c++14 -O3 -march=native -I include bench/sequence_bench.cpp \
+ *       -o sequence_bench
+ *   ./sequence_bench [-o results.json] [-t <min. ms per measurement>]
+ *
+ * results are written as JSON (to stdout by default);
+ * two result files can be compared with bench/compare_bench.py
+ */
+
+#include "linear.h"
+#include "geometric.h"
+#include "fibonacci.h"
+#include "combined.h"
+#include "repeated.h"
+#include "tiled.h"
+#include "compressed.h"
+#include "adaptors.h"
+#include "segmented.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace bench {
+
+
+/*****************************************************************************
+ *
+ * MEASUREMENT
+ *
+ *****************************************************************************/
+using clock_t_ = std::chrono::steady_clock;
+
+double min_seconds = 0.02;
+constexpr int samples = 5;
+
+
+//-------------------------------------------------------------------
+/// prevents the compiler from optimizing away 'x'
+template<class T>
+inline void
+do_not_optimize(const T& x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(x) : "memory");
+#else
+    static volatile char sink;
+    sink = *reinterpret_cast<const volatile char*>(&x);
+#endif
+}
+
+
+//-------------------------------------------------------------------
+/**
+ * @brief runs 'f' (which processes 'elements' values per call)
+ *        often enough to get stable timings
+ * @return best ns per element over several samples
+ */
+template<class F>
+double
+ns_per_element(std::size_t elements, F&& f)
+{
+    if(elements < 1) elements = 1;
+
+    //calibrate number of calls per sample
+    constexpr std::size_t max_calls = std::size_t(1) << 24;
+    std::size_t calls = 1;
+    for(;;) {
+        const auto t0 = clock_t_::now();
+        for(std::size_t i = 0; i < calls; ++i) f();
+        const auto s = std::chrono::duration<double>(clock_t_::now() - t0).count();
+        if(s >= min_seconds || calls >= max_calls) break;
+        const auto factor = (s > 0)
+            ? std::max(2.0, std::min(100.0, 1.2 * min_seconds / s)) : 100.0;
+        calls = std::min(max_calls, std::size_t(double(calls) * factor));
+    }
+
+    double best = 1e300;
+    for(int k = 0; k < samples; ++k) {
+        const auto t0 = clock_t_::now();
+        for(std::size_t i = 0; i < calls; ++i) f();
+        const auto s = std::chrono::duration<double>(clock_t_::now() - t0).count();
+        best = std::min(best, s);
+    }
+    return (best * 1e9) / double(calls * elements);
+}
+
+
+
+/*****************************************************************************
+ *
+ * RESULTS
+ *
+ *****************************************************************************/
+struct result
+{
+    std::string sequence;
+    std::string value_type;
+    std::string kernel;
+    std::size_t elements;
+    double ns_per_element;
+};
+
+
+//-------------------------------------------------------------------
+class suite
+{
+public:
+    void
+    add(std::string sequence, std::string valueType,
+        std::string kernel, std::size_t elements, double ns)
+    {
+        std::cerr << sequence << " <" << valueType << "> " << kernel
+                  << ": " << ns << " ns/element\n";
+
+        results_.push_back(result{std::move(sequence), std::move(valueType),
+                                  std::move(kernel), elements, ns});
+    }
+
+    //---------------------------------------------------------------
+    void
+    write_json(std::ostream& os) const
+    {
+        os << "{\n  \"context\": {\n"
+           << "    \"compiler\": \"" << compiler() << "\",\n"
+           << "    \"cplusplus\": " << __cplusplus << ",\n"
+           << "    \"timestamp\": " << std::time(nullptr) << ",\n"
+           << "    \"min_seconds\": " << min_seconds << ",\n"
+           << "    \"samples\": " << samples << "\n"
+           << "  },\n  \"benchmarks\": [";
+
+        const char* sep = "\n";
+        for(const auto& r : results_) {
+            os << sep
+               << "    {\"sequence\": \"" << r.sequence << "\""
+               << ", \"value_type\": \"" << r.value_type << "\""
+               << ", \"kernel\": \"" << r.kernel << "\""
+               << ", \"elements\": " << r.elements
+               << ", \"ns_per_element\": " << r.ns_per_element
+               << ", \"elements_per_second\": "
+               << (r.ns_per_element > 0 ? 1e9 / r.ns_per_element : 0.0)
+               << "}";
+            sep = ",\n";
+        }
+        os << "\n  ]\n}\n";
+    }
+
+private:
+    static std::string
+    compiler() {
+#if defined(__clang__)
+        return "clang " __clang_version__;
+#elif defined(__GNUC__)
+        return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+        return "msvc " + std::to_string(_MSC_VER);
+#else
+        return "unknown";
+#endif
+    }
+
+    std::vector<result> results_;
+};
+
+
+
+/*****************************************************************************
+ *
+ * KERNELS
+ *
+ *****************************************************************************/
+template<class T> const char* type_name();
+template<> const char* type_name<int>()           { return "int"; }
+template<> const char* type_name<std::int64_t>()  { return "int64"; }
+template<> const char* type_name<std::uint64_t>() { return "uint64"; }
+template<> const char* type_name<float>()         { return "float"; }
+template<> const char* type_name<double>()        { return "double"; }
+
+
+//-------------------------------------------------------------------
+template<class S, class = void>
+struct is_random_access : std::false_type {};
+
+template<class S>
+struct is_random_access<S, decltype(
+    (void)std::declval<const S&>()[0], (void)(std::declval<S&>() += 1))>
+: std::true_type {};
+
+
+//-------------------------------------------------------------------
+/// pseudo-random offsets in [0,n)
+inline std::vector<std::size_t>
+random_offsets(std::size_t n, std::size_t count = 4096)
+{
+    auto v = std::vector<std::size_t>(count);
+    std::uint64_t x = 0x9E3779B97F4A7C15ull;
+    for(auto& i : v) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        i = n > 0 ? std::size_t(x % n) : 0;
+    }
+    return v;
+}
+
+
+//-------------------------------------------------------------------
+template<class S>
+void
+random_access_kernels(suite& res, const std::string& name, const S& s,
+                      std::true_type)
+{
+    using value_t = std::decay_t<decltype(*s)>;
+    const auto n = std::size_t(am::seq_detail::remaining_size(s));
+    const auto idx = random_offsets(n);
+    const auto tname = type_name<value_t>();
+
+    res.add(name, tname, "subscript_random", idx.size(),
+        ns_per_element(idx.size(), [&] {
+            for(auto i : idx) do_not_optimize(s[i]);
+        }));
+
+    res.add(name, tname, "jump_ahead_random", idx.size(),
+        ns_per_element(idx.size(), [&] {
+            for(auto i : idx) {
+                auto t = s;
+                t += i;
+                do_not_optimize(*t);
+            }
+        }));
+}
+
+template<class S>
+void
+random_access_kernels(suite&, const std::string&, const S&, std::false_type)
+{}
+
+
+//-------------------------------------------------------------------
+/**
+ * @brief runs all kernels that 's' supports
+ */
+template<class S>
+void
+run(suite& res, const std::string& name, const S& s)
+{
+    using value_t = std::decay_t<decltype(*s)>;
+    const auto n = std::size_t(am::seq_detail::remaining_size(s));
+    const auto tname = type_name<value_t>();
+
+    //values are stored so that loops can't be replaced by closed forms
+    auto buf = std::vector<value_t>(n);
+    const auto out = buf.data();
+
+    res.add(name, tname, "range_for", n,
+        ns_per_element(n, [&] {
+            auto o = out;
+            for(auto x : s) *o++ = x;
+            do_not_optimize(out);
+        }));
+
+    res.add(name, tname, "increment", n,
+        ns_per_element(n, [&] {
+            auto o = out;
+            for(auto t = s; !t.empty(); ++t) *o++ = *t;
+            do_not_optimize(out);
+        }));
+
+    res.add(name, tname, "segmented_fill", n,
+        ns_per_element(n, [&] {
+            am::fill(s, out, out + n);
+            do_not_optimize(out);
+        }));
+
+    res.add(name, tname, "size", 1,
+        ns_per_element(1, [&] {
+            do_not_optimize(s);
+            do_not_optimize(s.size());
+        }));
+
+    res.add(name, tname, "end", 1,
+        ns_per_element(1, [&] {
+            do_not_optimize(s);
+            auto e = s.end();
+            do_not_optimize(e);
+        }));
+
+    random_access_kernels(res, name, s, is_random_access<S>{});
+}
+
+
+
+/*****************************************************************************
+ *
+ * SEQUENCES
+ *
+ *****************************************************************************/
+constexpr std::size_t N = 1 << 16;
+
+
+//-------------------------------------------------------------------
+/// plain index loop that computes the same values as a linear sequence
+template<class T>
+void
+run_baseline(suite& res)
+{
+    auto buf = std::vector<T>(N);
+    const auto out = buf.data();
+
+    res.add("raw_loop", type_name<T>(), "index_loop", N,
+        ns_per_element(N, [&] {
+            for(std::size_t i = 0; i < N; ++i) out[i] = T(3) + T(i) * T(2);
+            do_not_optimize(out);
+        }));
+
+    auto src = std::vector<T>(N, T(1));
+    res.add("raw_loop", type_name<T>(), "array_copy", N,
+        ns_per_element(N, [&] {
+            std::copy(src.begin(), src.end(), out);
+            do_not_optimize(out);
+        }));
+}
+
+
+//-------------------------------------------------------------------
+template<class T>
+void
+run_generators(suite& res)
+{
+    using namespace am;
+
+    run_baseline<T>(res);
+
+    run(res, "ascending", ascending_sequence<T>{T(0), T(N-1)});
+    run(res, "descending", descending_sequence<T>{T(N-1), T(0)});
+    run(res, "linear", linear_sequence<T>{T(3), T(2), T(3 + 2*(N-1))});
+
+    run(res, "tiled", make_tiled_sequence(
+                          linear_sequence<T>{T(0), T(1), T(255)},
+                          N / 256, T(1000)));
+
+    run(res, "transformed", make_transformed_sequence(
+                                linear_sequence<T>{T(0), T(1), T(N-1)},
+                                [](T x) { return x * T(3); }));
+}
+
+
+//-------------------------------------------------------------------
+template<class T>
+void
+run_decorators(suite& res)
+{
+    using namespace am;
+    using lin_t = linear_sequence<T>;
+
+    const auto seg = [](std::size_t i, std::size_t len) {
+        return lin_t{T(i), T(1), T(i + len - 1)};
+    };
+
+    //combined depth 1..3
+    {
+        auto c1 = make_combined_sequence(seg(0, N/2), seg(7, N/2));
+        run(res, "combined_depth1", c1);
+
+        auto c2 = make_combined_sequence(
+            make_combined_sequence(seg(0, N/4), seg(1, N/4)),
+            make_combined_sequence(seg(2, N/4), seg(3, N/4)));
+        run(res, "combined_depth2", c2);
+
+        auto c3 = make_combined_sequence(c2, c2);
+        run(res, "combined_depth3", c3);
+
+        run(res, "combined_variadic4", make_combined_sequence(
+            seg(0, N/4), seg(1, N/4), seg(2, N/4), seg(3, N/4)));
+    }
+
+    //repeated depth 1..3
+    {
+        run(res, "repeated_depth1",
+            make_repeated_sequence(seg(0, 256), N/256 - 1));
+
+        run(res, "repeated_depth2",
+            make_repeated_sequence(
+                make_repeated_sequence(seg(0, 256), 15), N/4096 - 1));
+
+        run(res, "repeated_depth3",
+            make_repeated_sequence(
+                make_repeated_sequence(
+                    make_repeated_sequence(seg(0, 256), 3), 3), N/4096 - 1));
+
+        run(res, "repeated_cached",
+            make_cached_repeated_sequence(seg(0, 256), N/256 - 1));
+
+        run(res, "repeated_compact",
+            make_compact_repeated_sequence(seg(0, 256), N/256 - 1));
+    }
+}
+
+
+//-------------------------------------------------------------------
+template<class T>
+void
+run_compressed(suite& res)
+{
+    auto data = std::vector<T>{};
+    am::copy(am::make_combined_sequence(
+                 am::make_repeated_sequence(
+                     am::linear_sequence<T>{T(0), T(1), T(99)}, N/200 - 1),
+                 am::linear_sequence<T>{T(5), T(3), T(5 + 3*(N/2 - 1))}),
+             std::back_inserter(data));
+
+    run(res, "compressed", am::compress(data.data(), data.size()));
+}
+
+
+//-------------------------------------------------------------------
+template<class T>
+void
+run_floating(suite& res)
+{
+    using namespace am;
+
+    run_generators<T>(res);
+    //ratio 2: jump-ahead (pow) and stepping agree exactly, so that
+    //range-for (which compares with end()) terminates
+    run(res, "geometric", geometric_sequence<T>{T(1), T(2), T(1e30)});
+}
+
+
+}  // namespace bench
+
+
+
+//-------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+    using namespace bench;
+
+    std::string outfile;
+    for(int i = 1; i < argc; ++i) {
+        if(!std::strcmp(argv[i], "-o") && i+1 < argc) {
+            outfile = argv[++i];
+        }
+        else if(!std::strcmp(argv[i], "-t") && i+1 < argc) {
+            min_seconds = std::atof(argv[++i]) / 1000.0;
+        }
+        else {
+            std::cerr << "usage: " << argv[0]
+                      << " [-o <results.json>] [-t <min. ms per measurement>]\n";
+            return 1;
+        }
+    }
+
+    suite res;
+
+    run_generators<int>(res);
+    run_generators<std::int64_t>(res);
+    run_floating<float>(res);
+    run_floating<double>(res);
+
+    run(res, "fibonacci", am::fibonacci_sequence<std::uint64_t>{90});
+
+    run_decorators<int>(res);
+    run_decorators<std::int64_t>(res);
+    run_decorators<double>(res);
+
+    run_compressed<int>(res);
+    run_compressed<std::int64_t>(res);
+
+    if(outfile.empty()) {
+        res.write_json(std::cout);
+    }
+    else {
+        std::ofstream os{outfile};
+        res.write_json(os);
+        if(!os) {
+            std::cerr << "could not write to " << outfile << '\n';
+            return 1;
+        }
+    }
+}
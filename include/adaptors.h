@@ -0,0 +1,1440 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AMLIB_NUMERIC_SEQUENCE_ADAPTORS_H_
+#define AMLIB_NUMERIC_SEQUENCE_ADAPTORS_H_
+
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "segmented.h"
+#include "stats.h"
+
+
+namespace am {
+
+
+namespace seq_detail {
+
+/*************************************************************************//***
+ *
+ * @brief wraps a function object so that it is always copy assignable
+ *        (lambdas are not) which is required for sequences that are
+ *        re-assigned by decorators (repeated, combined, ...)
+ *
+ *****************************************************************************/
+template<class F, bool = std::is_copy_assignable<F>::value>
+class assignable_function
+{
+public:
+    explicit
+    assignable_function(F f): f_(std::move(f)) {}
+
+    const F& get() const noexcept { return f_; }
+
+private:
+    F f_;
+};
+
+//---------------------------------------------------------
+template<class F>
+class assignable_function<F,false>
+{
+public:
+    explicit
+    assignable_function(F f) {
+        ::new(static_cast<void*>(&mem_)) F(std::move(f));
+    }
+
+    assignable_function(const assignable_function& src) {
+        ::new(static_cast<void*>(&mem_)) F(src.get());
+    }
+
+    assignable_function&
+    operator = (const assignable_function& src) {
+        if(this != &src) {
+            ref().~F();
+            ::new(static_cast<void*>(&mem_)) F(src.get());
+        }
+        return *this;
+    }
+
+    ~assignable_function() {
+        ref().~F();
+    }
+
+    const F& get() const noexcept {
+        return *reinterpret_cast<const F*>(&mem_);
+    }
+
+private:
+    F& ref() noexcept {
+        return *reinterpret_cast<F*>(&mem_);
+    }
+
+    std::aligned_storage_t<sizeof(F),alignof(F)> mem_;
+};
+
+
+
+/*************************************************************************//***
+ *
+ * @brief pulls up to 'max' values of 's' in blocks through a stack buffer;
+ *        calls f(block, count, offset) for each block
+ * @return number of values pulled
+ *
+ *****************************************************************************/
+template<class Sequence, class F>
+inline std::size_t
+for_each_batch(Sequence& s, std::size_t max, F&& f)
+{
+    constexpr std::size_t block = 64;
+    std::decay_t<typename Sequence::value_type> buf[block];
+
+    std::size_t n = 0;
+    while(n < max) {
+        const auto want = std::min(max - n, block);
+        const auto m = am::next_batch(s, buf, want);
+        f(buf, m, n);
+        n += m;
+        if(m < want) break;
+    }
+    return n;
+}
+
+}  // namespace seq_detail
+
+
+
+
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief applies a function to each value of an underlying sequence
+ *
+ *****************************************************************************/
+template<class Sequence, class Function>
+class transformed_sequence :
+    private seq_stats::tracked<transformed_sequence<Sequence,Function>>
+{
+public:
+    //---------------------------------------------------------------
+    using sequence_type = Sequence;
+    using function_type = Function;
+    //-----------------------------------------------------
+    using iterator_category = std::input_iterator_tag;
+    using difference_type = typename sequence_type::difference_type;
+    using size_type = typename sequence_type::size_type;
+    //-----------------------------------------------------
+    using value_type = std::decay_t<decltype(std::declval<const Function&>()(
+                           std::declval<typename sequence_type::value_type>()))>;
+    using reference = const value_type&;
+    using pointer = value_type*;
+
+
+    //---------------------------------------------------------------
+    explicit
+    transformed_sequence(sequence_type s, function_type f):
+        s_{std::move(s)}, f_{std::move(f)}
+    {}
+
+
+    //---------------------------------------------------------------
+    value_type
+    operator * () const {
+        return f_.get()(*s_);
+    }
+    //-----------------------------------------------------
+    value_type
+    operator [] (size_type offset) const {
+        AMLIB_SEQUENCE_COUNT(subscript);
+        return f_.get()(s_[offset]);
+    }
+
+
+    //---------------------------------------------------------------
+    transformed_sequence&
+    operator ++ () {
+        AMLIB_SEQUENCE_COUNT(increment);
+        ++s_;
+        return *this;
+    }
+    //-----------------------------------------------------
+    transformed_sequence&
+    operator += (size_type offset) {
+        AMLIB_SEQUENCE_COUNT(advance);
+        s_ += offset;
+        return *this;
+    }
+    //-----------------------------------------------------
+    transformed_sequence
+    operator + (size_type offset) const {
+        auto res = *this;
+        res += offset;
+        return res;
+    }
+    //-----------------------------------------------------
+    /**
+     * @brief writes up to 'max' values to 'out' and advances past them;
+     *        the underlying sequence is pulled in blocks
+     */
+    size_type
+    next_batch(value_type* out, size_type max) {
+        const auto& fn = f_.get();
+        return seq_detail::for_each_batch(s_, max,
+            [&](const auto* in, std::size_t m, std::size_t offset) {
+                for(std::size_t i = 0; i < m; ++i) {
+                    out[offset + i] = fn(in[i]);
+                }
+            });
+    }
+
+
+    //---------------------------------------------------------------
+    const sequence_type&
+    base() const noexcept {
+        return s_;
+    }
+
+
+    //---------------------------------------------------------------
+    value_type
+    front() const {
+        return *(*this);
+    }
+    //-----------------------------------------------------
+    value_type
+    back() const {
+        return f_.get()(s_.back());
+    }
+    //-----------------------------------------------------
+    template<class S = sequence_type,
+             class = std::enable_if_t<seq_detail::has_size<S>::value>>
+    size_type
+    size() const {
+        AMLIB_SEQUENCE_COUNT(size);
+        return seq_detail::remaining_size(s_);
+    }
+    //-----------------------------------------------------
+    bool
+    empty() const {
+        return s_.empty();
+    }
+    //-----------------------------------------------------
+    explicit operator
+    bool() const {
+        return !empty();
+    }
+
+
+    //---------------------------------------------------------------
+    const transformed_sequence&
+    begin() const noexcept {
+        return *this;
+    }
+    //-----------------------------------------------------
+    transformed_sequence
+    end() const {
+        AMLIB_SEQUENCE_COUNT(end);
+        return transformed_sequence{s_.end(), f_.get()};
+    }
+
+
+    //---------------------------------------------------------------
+    bool
+    operator == (const transformed_sequence& o) const {
+        AMLIB_SEQUENCE_COUNT(compare);
+        return (s_ == o.s_);
+    }
+    //-----------------------------------------------------
+    bool
+    operator != (const transformed_sequence& o) const {
+        return !(*this == o);
+    }
+
+
+    //---------------------------------------------------------------
+    /// transforms each segment of the underlying sequence
+    template<class F>
+    friend void
+    for_each_segment(const transformed_sequence& s, F&& f) {
+        const auto& fn = s.f_.get();
+        for_each_segment(s.s_, [&](const auto& segment) {
+            using seg_t = std::decay_t<decltype(segment)>;
+            f(transformed_sequence<seg_t,function_type>{segment, fn});
+        });
+    }
+
+
+private:
+    sequence_type s_;
+    seq_detail::assignable_function<function_type> f_;
+};
+
+
+
+
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief only yields values of an underlying sequence
+ *        that satisfy a predicate
+ *
+ *****************************************************************************/
+template<class Sequence, class Predicate>
+class filtered_sequence :
+    private seq_stats::tracked<filtered_sequence<Sequence,Predicate>>
+{
+public:
+    //---------------------------------------------------------------
+    using sequence_type = Sequence;
+    using predicate_type = Predicate;
+    //-----------------------------------------------------
+    using iterator_category = std::input_iterator_tag;
+    using difference_type = typename sequence_type::difference_type;
+    using size_type = typename sequence_type::size_type;
+    //-----------------------------------------------------
+    using value_type = typename sequence_type::value_type;
+    using reference = const value_type&;
+    using pointer = value_type*;
+
+
+    //---------------------------------------------------------------
+    explicit
+    filtered_sequence(sequence_type s, predicate_type p):
+        s_{std::move(s)}, p_{std::move(p)}
+    {
+        skip();
+    }
+
+
+    //---------------------------------------------------------------
+    decltype(auto)
+    operator * () const {
+        return *s_;
+    }
+
+
+    //---------------------------------------------------------------
+    filtered_sequence&
+    operator ++ () {
+        AMLIB_SEQUENCE_COUNT(increment);
+        ++s_;
+        skip();
+        return *this;
+    }
+    //-----------------------------------------------------
+    filtered_sequence&
+    operator += (size_type offset) {
+        AMLIB_SEQUENCE_COUNT(advance);
+        for(; offset > 0 && !empty(); --offset) ++(*this);
+        return *this;
+    }
+    //-----------------------------------------------------
+    filtered_sequence
+    operator + (size_type offset) const {
+        auto res = *this;
+        res += offset;
+        return res;
+    }
+    //-----------------------------------------------------
+    /**
+     * @brief writes up to 'max' values to 'out' and advances past them;
+     *        the underlying sequence is pulled in blocks that are
+     *        compacted without branching on the predicate
+     */
+    size_type
+    next_batch(value_type* out, size_type max)
+    {
+        const auto& pred = p_.get();
+        size_type n = 0;
+        //never pull more values than there is space left
+        while(n < max && !s_.empty()) {
+            seq_detail::for_each_batch(s_, max - n,
+                [&](const auto* in, std::size_t m, std::size_t) {
+                    for(std::size_t i = 0; i < m; ++i) {
+                        out[n] = in[i];
+                        n += pred(in[i]) ? 1 : 0;
+                    }
+                });
+            skip();
+        }
+        return n;
+    }
+
+
+    //---------------------------------------------------------------
+    const sequence_type&
+    base() const noexcept {
+        return s_;
+    }
+
+
+    //---------------------------------------------------------------
+    decltype(auto)
+    front() const {
+        return *s_;
+    }
+    //-----------------------------------------------------
+    bool
+    empty() const {
+        return s_.empty();
+    }
+    //-----------------------------------------------------
+    explicit operator
+    bool() const {
+        return !empty();
+    }
+
+
+    //---------------------------------------------------------------
+    const filtered_sequence&
+    begin() const noexcept {
+        return *this;
+    }
+    //-----------------------------------------------------
+    filtered_sequence
+    end() const {
+        AMLIB_SEQUENCE_COUNT(end);
+        return filtered_sequence{s_.end(), p_.get()};
+    }
+
+
+    //---------------------------------------------------------------
+    bool
+    operator == (const filtered_sequence& o) const {
+        AMLIB_SEQUENCE_COUNT(compare);
+        return (empty() && o.empty()) || (s_ == o.s_);
+    }
+    //-----------------------------------------------------
+    bool
+    operator != (const filtered_sequence& o) const {
+        return !(*this == o);
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    void
+    skip() {
+        while(!s_.empty() && !p_.get()(*s_)) ++s_;
+    }
+
+    //---------------------------------------------------------------
+    sequence_type s_;
+    seq_detail::assignable_function<predicate_type> p_;
+};
+
+
+
+
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief yields at most n values of an underlying sequence
+ *
+ *****************************************************************************/
+template<class Sequence>
+class taken_sequence :
+    private seq_stats::tracked<taken_sequence<Sequence>>
+{
+public:
+    //---------------------------------------------------------------
+    using sequence_type = Sequence;
+    //-----------------------------------------------------
+    using iterator_category = std::input_iterator_tag;
+    using difference_type = typename sequence_type::difference_type;
+    using size_type = typename sequence_type::size_type;
+    //-----------------------------------------------------
+    using value_type = typename sequence_type::value_type;
+    using reference = const value_type&;
+    using pointer = value_type*;
+
+
+    //---------------------------------------------------------------
+    explicit
+    taken_sequence(sequence_type s = sequence_type(), size_type n = 0):
+        s_{std::move(s)}, n_{n}
+    {}
+
+
+    //---------------------------------------------------------------
+    decltype(auto)
+    operator * () const {
+        return *s_;
+    }
+    //-----------------------------------------------------
+    decltype(auto)
+    operator [] (size_type offset) const {
+        AMLIB_SEQUENCE_COUNT(subscript);
+        return s_[offset];
+    }
+
+
+    //---------------------------------------------------------------
+    taken_sequence&
+    operator ++ () {
+        AMLIB_SEQUENCE_COUNT(increment);
+        ++s_;
+        --n_;
+        return *this;
+    }
+    //-----------------------------------------------------
+    taken_sequence&
+    operator += (size_type offset) {
+        AMLIB_SEQUENCE_COUNT(advance);
+        if(offset >= n_) {
+            n_ = 0;
+        } else {
+            s_ += offset;
+            n_ -= offset;
+        }
+        return *this;
+    }
+    //-----------------------------------------------------
+    taken_sequence
+    operator + (size_type offset) const {
+        auto res = *this;
+        res += offset;
+        return res;
+    }
+    //-----------------------------------------------------
+    /// writes up to 'max' values to 'out' and advances past them
+    size_type
+    next_batch(value_type* out, size_type max) {
+        const auto n = am::next_batch(s_, out, (max < n_) ? max : n_);
+        n_ -= n;
+        return n;
+    }
+
+
+    //---------------------------------------------------------------
+    const sequence_type&
+    base() const noexcept {
+        return s_;
+    }
+
+
+    //---------------------------------------------------------------
+    decltype(auto)
+    front() const {
+        return *s_;
+    }
+    //-----------------------------------------------------
+    value_type
+    back() const {
+        return s_[size()-1];
+    }
+    //-----------------------------------------------------
+    template<class S = sequence_type,
+             class = std::enable_if_t<seq_detail::has_size<S>::value>>
+    size_type
+    size() const {
+        AMLIB_SEQUENCE_COUNT(size);
+        const auto n = seq_detail::remaining_size(s_);
+        return n < n_ ? n : n_;
+    }
+    //-----------------------------------------------------
+    bool
+    empty() const {
+        return (n_ < 1) || s_.empty();
+    }
+    //-----------------------------------------------------
+    explicit operator
+    bool() const {
+        return !empty();
+    }
+
+
+    //---------------------------------------------------------------
+    const taken_sequence&
+    begin() const noexcept {
+        return *this;
+    }
+    //-----------------------------------------------------
+    taken_sequence
+    end() const {
+        AMLIB_SEQUENCE_COUNT(end);
+        return taken_sequence{s_, 0};
+    }
+
+
+    //---------------------------------------------------------------
+    bool
+    operator == (const taken_sequence& o) const {
+        AMLIB_SEQUENCE_COUNT(compare);
+        return (empty() && o.empty()) || ((n_ == o.n_) && (s_ == o.s_));
+    }
+    //-----------------------------------------------------
+    bool
+    operator != (const taken_sequence& o) const {
+        return !(*this == o);
+    }
+
+
+private:
+    sequence_type s_;
+    size_type n_;
+};
+
+
+
+
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief yields every k-th value of an underlying sequence;
+ *        uses the underlying sequence's operator += to skip values
+ *        if it has a size, otherwise steps with ++
+ *
+ *****************************************************************************/
+template<class Sequence>
+class strided_sequence :
+    private seq_stats::tracked<strided_sequence<Sequence>>
+{
+    using sized = seq_detail::has_size<Sequence>;
+
+public:
+    //---------------------------------------------------------------
+    using sequence_type = Sequence;
+    //-----------------------------------------------------
+    using iterator_category = std::input_iterator_tag;
+    using difference_type = typename sequence_type::difference_type;
+    using size_type = typename sequence_type::size_type;
+    //-----------------------------------------------------
+    using value_type = typename sequence_type::value_type;
+    using reference = const value_type&;
+    using pointer = value_type*;
+
+
+    //---------------------------------------------------------------
+    explicit
+    strided_sequence(sequence_type s = sequence_type(), size_type k = 1):
+        s_{std::move(s)}, k_{k > 0 ? k : 1},
+        n_{initial_count(s_, k_, sized{})}
+    {}
+
+
+    //---------------------------------------------------------------
+    decltype(auto)
+    operator * () const {
+        return *s_;
+    }
+    //-----------------------------------------------------
+    decltype(auto)
+    operator [] (size_type offset) const {
+        AMLIB_SEQUENCE_COUNT(subscript);
+        return s_[offset * k_];
+    }
+
+
+    //---------------------------------------------------------------
+    strided_sequence&
+    operator ++ () {
+        AMLIB_SEQUENCE_COUNT(increment);
+        advance(1, sized{});
+        return *this;
+    }
+    //-----------------------------------------------------
+    strided_sequence&
+    operator += (size_type offset) {
+        AMLIB_SEQUENCE_COUNT(advance);
+        advance(offset, sized{});
+        return *this;
+    }
+    //-----------------------------------------------------
+    strided_sequence
+    operator + (size_type offset) const {
+        auto res = *this;
+        res += offset;
+        return res;
+    }
+
+
+    //---------------------------------------------------------------
+    const sequence_type&
+    base() const noexcept {
+        return s_;
+    }
+    //-----------------------------------------------------
+    size_type
+    stride() const noexcept {
+        return k_;
+    }
+
+
+    //---------------------------------------------------------------
+    decltype(auto)
+    front() const {
+        return *s_;
+    }
+    //-----------------------------------------------------
+    value_type
+    back() const {
+        return (*this)[n_-1];
+    }
+    //-----------------------------------------------------
+    template<class S = sequence_type,
+             class = std::enable_if_t<seq_detail::has_size<S>::value>>
+    size_type
+    size() const noexcept {
+        AMLIB_SEQUENCE_COUNT(size);
+        return n_;
+    }
+    //-----------------------------------------------------
+    bool
+    empty() const {
+        return sized::value ? (n_ < 1) : s_.empty();
+    }
+    //-----------------------------------------------------
+    explicit operator
+    bool() const {
+        return !empty();
+    }
+
+
+    //---------------------------------------------------------------
+    const strided_sequence&
+    begin() const noexcept {
+        return *this;
+    }
+    //-----------------------------------------------------
+    strided_sequence
+    end() const {
+        AMLIB_SEQUENCE_COUNT(end);
+        auto res = *this;
+        res.n_ = 0;
+        if(!sized::value) res.s_ = s_.end();
+        return res;
+    }
+
+
+    //---------------------------------------------------------------
+    bool
+    operator == (const strided_sequence& o) const {
+        AMLIB_SEQUENCE_COUNT(compare);
+        return sized::value
+            ? (n_ == o.n_) && ((n_ < 1) || (s_ == o.s_))
+            : (s_ == o.s_);
+    }
+    //-----------------------------------------------------
+    bool
+    operator != (const strided_sequence& o) const {
+        return !(*this == o);
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    /// sized sources: count values up front, skip with +=
+    static size_type
+    initial_count(const sequence_type& s, size_type k, std::true_type) {
+        return (seq_detail::remaining_size(s) + k - 1) / k;
+    }
+    //-----------------------------------------------------
+    void
+    advance(size_type offset, std::true_type) {
+        if(offset >= n_) {
+            n_ = 0;
+        } else {
+            s_ += offset * k_;
+            n_ -= offset;
+        }
+    }
+
+    //---------------------------------------------------------------
+    /// sources without size: step with ++ until the source ends
+    static size_type
+    initial_count(const sequence_type&, size_type, std::false_type) noexcept {
+        return 0;
+    }
+    //-----------------------------------------------------
+    void
+    advance(size_type offset, std::false_type) {
+        for(auto n = offset * k_; n > 0 && !s_.empty(); --n) ++s_;
+    }
+
+
+    //---------------------------------------------------------------
+    sequence_type s_;
+    size_type k_;
+    size_type n_;
+};
+
+
+
+
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief yields pairs of values from two sequences;
+ *        ends as soon as one of the sequences ends
+ *
+ *****************************************************************************/
+template<class Sequence1, class Sequence2>
+class zipped_sequence :
+    private seq_stats::tracked<zipped_sequence<Sequence1,Sequence2>>
+{
+public:
+    //---------------------------------------------------------------
+    using first_sequence_type = Sequence1;
+    using second_sequence_type = Sequence2;
+    //-----------------------------------------------------
+    using iterator_category = std::input_iterator_tag;
+    //-----------------------------------------------------
+    using difference_type = std::common_type_t<
+        typename first_sequence_type::difference_type,
+        typename second_sequence_type::difference_type>;
+    //-----------------------------------------------------
+    using size_type = std::common_type_t<
+        typename first_sequence_type::size_type,
+        typename second_sequence_type::size_type>;
+    //-----------------------------------------------------
+    using value_type = std::pair<
+        std::decay_t<typename first_sequence_type::value_type>,
+        std::decay_t<typename second_sequence_type::value_type>>;
+    //-----------------------------------------------------
+    using reference = const value_type&;
+    using pointer = value_type*;
+
+
+    //---------------------------------------------------------------
+    explicit
+    zipped_sequence(first_sequence_type s1 = first_sequence_type(),
+                    second_sequence_type s2 = second_sequence_type())
+    :
+        s1_{std::move(s1)}, s2_{std::move(s2)}
+    {}
+
+
+    //---------------------------------------------------------------
+    value_type
+    operator * () const {
+        return value_type{*s1_, *s2_};
+    }
+    //-----------------------------------------------------
+    value_type
+    operator [] (size_type offset) const {
+        AMLIB_SEQUENCE_COUNT(subscript);
+        return value_type{s1_[offset], s2_[offset]};
+    }
+
+
+    //---------------------------------------------------------------
+    zipped_sequence&
+    operator ++ () {
+        AMLIB_SEQUENCE_COUNT(increment);
+        ++s1_;
+        ++s2_;
+        return *this;
+    }
+    //-----------------------------------------------------
+    zipped_sequence&
+    operator += (size_type offset) {
+        AMLIB_SEQUENCE_COUNT(advance);
+        s1_ += offset;
+        s2_ += offset;
+        return *this;
+    }
+    //-----------------------------------------------------
+    zipped_sequence
+    operator + (size_type offset) const {
+        auto res = *this;
+        res += offset;
+        return res;
+    }
+    //-----------------------------------------------------
+    /**
+     * @brief writes up to 'max' values to 'out' and advances past them;
+     *        both sequences are pulled into parallel blocks
+     *
+     *        once one sequence is exhausted, the other one may have been
+     *        advanced past the last zipped value (the zip is empty anyway)
+     */
+    size_type
+    next_batch(value_type* out, size_type max)
+    {
+        constexpr std::size_t block = 64;
+        typename value_type::first_type in1[block];
+        typename value_type::second_type in2[block];
+
+        size_type n = 0;
+        while(n < max) {
+            const auto want = std::min(std::size_t(max - n), block);
+            const auto m1 = am::next_batch(s1_, in1, want);
+            const auto m2 = am::next_batch(s2_, in2, m1);
+            for(std::size_t i = 0; i < m2; ++i) {
+                out[n + i] = value_type{in1[i], in2[i]};
+            }
+            n += m2;
+            if(m2 < want) break;
+        }
+        return n;
+    }
+
+
+    //---------------------------------------------------------------
+    value_type
+    front() const {
+        return *(*this);
+    }
+    //-----------------------------------------------------
+    value_type
+    back() const {
+        return (*this)[size()-1];
+    }
+    //-----------------------------------------------------
+    template<class S1 = first_sequence_type, class S2 = second_sequence_type,
+             class = std::enable_if_t<seq_detail::has_size<S1>::value &&
+                                      seq_detail::has_size<S2>::value>>
+    size_type
+    size() const {
+        AMLIB_SEQUENCE_COUNT(size);
+        const size_type n1 = seq_detail::remaining_size(s1_);
+        const size_type n2 = seq_detail::remaining_size(s2_);
+        return n1 < n2 ? n1 : n2;
+    }
+    //-----------------------------------------------------
+    bool
+    empty() const {
+        return s1_.empty() || s2_.empty();
+    }
+    //-----------------------------------------------------
+    explicit operator
+    bool() const {
+        return !empty();
+    }
+
+
+    //---------------------------------------------------------------
+    const zipped_sequence&
+    begin() const noexcept {
+        return *this;
+    }
+    //-----------------------------------------------------
+    zipped_sequence
+    end() const {
+        AMLIB_SEQUENCE_COUNT(end);
+        return zipped_sequence{s1_.end(), s2_.end()};
+    }
+
+
+    //---------------------------------------------------------------
+    bool
+    operator == (const zipped_sequence& o) const {
+        AMLIB_SEQUENCE_COUNT(compare);
+        return (empty() && o.empty()) || ((s1_ == o.s1_) && (s2_ == o.s2_));
+    }
+    //-----------------------------------------------------
+    bool
+    operator != (const zipped_sequence& o) const {
+        return !(*this == o);
+    }
+
+
+private:
+    first_sequence_type s1_;
+    second_sequence_type s2_;
+};
+
+
+
+
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief yields pairs (index, value) of an underlying sequence
+ *
+ *****************************************************************************/
+template<class Sequence>
+class enumerated_sequence :
+    private seq_stats::tracked<enumerated_sequence<Sequence>>
+{
+public:
+    //---------------------------------------------------------------
+    using sequence_type = Sequence;
+    //-----------------------------------------------------
+    using iterator_category = std::input_iterator_tag;
+    using difference_type = typename sequence_type::difference_type;
+    using size_type = typename sequence_type::size_type;
+    //-----------------------------------------------------
+    using value_type = std::pair<size_type,
+        std::decay_t<typename sequence_type::value_type>>;
+    using reference = const value_type&;
+    using pointer = value_type*;
+
+
+    //---------------------------------------------------------------
+    explicit
+    enumerated_sequence(sequence_type s = sequence_type(),
+                        size_type first = 0)
+    :
+        s_{std::move(s)}, i_{first}
+    {}
+
+
+    //---------------------------------------------------------------
+    value_type
+    operator * () const {
+        return value_type{i_, *s_};
+    }
+    //-----------------------------------------------------
+    value_type
+    operator [] (size_type offset) const {
+        AMLIB_SEQUENCE_COUNT(subscript);
+        return value_type{i_ + offset, s_[offset]};
+    }
+
+
+    //---------------------------------------------------------------
+    enumerated_sequence&
+    operator ++ () {
+        AMLIB_SEQUENCE_COUNT(increment);
+        ++s_;
+        ++i_;
+        return *this;
+    }
+    //-----------------------------------------------------
+    enumerated_sequence&
+    operator += (size_type offset) {
+        AMLIB_SEQUENCE_COUNT(advance);
+        s_ += offset;
+        i_ += offset;
+        return *this;
+    }
+    //-----------------------------------------------------
+    enumerated_sequence
+    operator + (size_type offset) const {
+        auto res = *this;
+        res += offset;
+        return res;
+    }
+    //-----------------------------------------------------
+    /**
+     * @brief writes up to 'max' values to 'out' and advances past them;
+     *        the underlying sequence is pulled in blocks
+     */
+    size_type
+    next_batch(value_type* out, size_type max) {
+        const auto first = i_;
+        const auto n = seq_detail::for_each_batch(s_, max,
+            [&](const auto* in, std::size_t m, std::size_t offset) {
+                for(std::size_t i = 0; i < m; ++i) {
+                    out[offset + i] = value_type{first + offset + i, in[i]};
+                }
+            });
+        i_ += n;
+        return n;
+    }
+
+
+    //---------------------------------------------------------------
+    const sequence_type&
+    base() const noexcept {
+        return s_;
+    }
+    //-----------------------------------------------------
+    size_type
+    index() const noexcept {
+        return i_;
+    }
+
+
+    //---------------------------------------------------------------
+    value_type
+    front() const {
+        return *(*this);
+    }
+    //-----------------------------------------------------
+    value_type
+    back() const {
+        return (*this)[size()-1];
+    }
+    //-----------------------------------------------------
+    template<class S = sequence_type,
+             class = std::enable_if_t<seq_detail::has_size<S>::value>>
+    size_type
+    size() const {
+        AMLIB_SEQUENCE_COUNT(size);
+        return seq_detail::remaining_size(s_);
+    }
+    //-----------------------------------------------------
+    bool
+    empty() const {
+        return s_.empty();
+    }
+    //-----------------------------------------------------
+    explicit operator
+    bool() const {
+        return !empty();
+    }
+
+
+    //---------------------------------------------------------------
+    const enumerated_sequence&
+    begin() const noexcept {
+        return *this;
+    }
+    //-----------------------------------------------------
+    /// the index of end() is unspecified; comparisons ignore it
+    enumerated_sequence
+    end() const {
+        AMLIB_SEQUENCE_COUNT(end);
+        return enumerated_sequence{s_.end()};
+    }
+
+
+    //---------------------------------------------------------------
+    bool
+    operator == (const enumerated_sequence& o) const {
+        AMLIB_SEQUENCE_COUNT(compare);
+        return s_ == o.s_;
+    }
+    //-----------------------------------------------------
+    bool
+    operator != (const enumerated_sequence& o) const {
+        return !(*this == o);
+    }
+
+
+private:
+    sequence_type s_;
+    size_type i_;
+};
+
+
+
+
+
+
+
+
+/*****************************************************************************
+ *
+ * NON-MEMBER BEGIN/END
+ *
+ *****************************************************************************/
+template<class S, class F>
+inline decltype(auto)
+begin(const transformed_sequence<S,F>& s) {
+    return s.begin();
+}
+//-----------------------------------------------------
+template<class S, class F>
+inline decltype(auto)
+end(const transformed_sequence<S,F>& s) {
+    return s.end();
+}
+
+//---------------------------------------------------------------
+template<class S, class P>
+inline decltype(auto)
+begin(const filtered_sequence<S,P>& s) {
+    return s.begin();
+}
+//-----------------------------------------------------
+template<class S, class P>
+inline decltype(auto)
+end(const filtered_sequence<S,P>& s) {
+    return s.end();
+}
+
+//---------------------------------------------------------------
+template<class S>
+inline decltype(auto)
+begin(const taken_sequence<S>& s) {
+    return s.begin();
+}
+//-----------------------------------------------------
+template<class S>
+inline decltype(auto)
+end(const taken_sequence<S>& s) {
+    return s.end();
+}
+
+//---------------------------------------------------------------
+template<class S>
+inline decltype(auto)
+begin(const strided_sequence<S>& s) {
+    return s.begin();
+}
+//-----------------------------------------------------
+template<class S>
+inline decltype(auto)
+end(const strided_sequence<S>& s) {
+    return s.end();
+}
+
+//---------------------------------------------------------------
+template<class S1, class S2>
+inline decltype(auto)
+begin(const zipped_sequence<S1,S2>& s) {
+    return s.begin();
+}
+//-----------------------------------------------------
+template<class S1, class S2>
+inline decltype(auto)
+end(const zipped_sequence<S1,S2>& s) {
+    return s.end();
+}
+
+//---------------------------------------------------------------
+template<class S>
+inline decltype(auto)
+begin(const enumerated_sequence<S>& s) {
+    return s.begin();
+}
+//-----------------------------------------------------
+template<class S>
+inline decltype(auto)
+end(const enumerated_sequence<S>& s) {
+    return s.end();
+}
+
+
+
+
+
+
+
+
+/*****************************************************************************
+ *
+ * FACTORIES
+ *
+ *****************************************************************************/
+template<class Sequence, class Function>
+inline auto
+make_transformed_sequence(Sequence&& s, Function&& f)
+{
+    return transformed_sequence<std::decay_t<Sequence>,std::decay_t<Function>>{
+               std::forward<Sequence>(s), std::forward<Function>(f)};
+}
+
+//---------------------------------------------------------
+template<class Sequence, class Predicate>
+inline auto
+make_filtered_sequence(Sequence&& s, Predicate&& p)
+{
+    return filtered_sequence<std::decay_t<Sequence>,std::decay_t<Predicate>>{
+               std::forward<Sequence>(s), std::forward<Predicate>(p)};
+}
+
+//---------------------------------------------------------
+template<class Sequence>
+inline auto
+make_taken_sequence(Sequence&& s, std::size_t n)
+{
+    return taken_sequence<std::decay_t<Sequence>>{std::forward<Sequence>(s), n};
+}
+
+//---------------------------------------------------------
+template<class Sequence>
+inline auto
+make_strided_sequence(Sequence&& s, std::size_t k)
+{
+    return strided_sequence<std::decay_t<Sequence>>{std::forward<Sequence>(s), k};
+}
+
+//---------------------------------------------------------
+template<class Sequence1, class Sequence2>
+inline auto
+make_zipped_sequence(Sequence1&& s1, Sequence2&& s2)
+{
+    return zipped_sequence<std::decay_t<Sequence1>,std::decay_t<Sequence2>>{
+               std::forward<Sequence1>(s1), std::forward<Sequence2>(s2)};
+}
+
+//---------------------------------------------------------
+template<class Sequence>
+inline auto
+make_enumerated_sequence(Sequence&& s)
+{
+    return enumerated_sequence<std::decay_t<Sequence>>{std::forward<Sequence>(s)};
+}
+
+
+
+
+
+
+
+
+/*****************************************************************************
+ *
+ * PIPE SYNTAX
+ *
+ * seq | transform(f) | filter(p) | take(n) | drop(n) | stride(k) |
+ *       zip(seq2) | enumerate()
+ *
+ *****************************************************************************/
+namespace seq_detail {
+
+template<class F>
+struct transform_closure {
+    F f;
+
+    template<class S>
+    friend auto operator | (S&& s, const transform_closure& c) {
+        return make_transformed_sequence(std::forward<S>(s), c.f);
+    }
+};
+
+//---------------------------------------------------------
+template<class P>
+struct filter_closure {
+    P p;
+
+    template<class S>
+    friend auto operator | (S&& s, const filter_closure& c) {
+        return make_filtered_sequence(std::forward<S>(s), c.p);
+    }
+};
+
+//---------------------------------------------------------
+struct take_closure {
+    std::size_t n;
+
+    template<class S>
+    friend auto operator | (S&& s, const take_closure& c) {
+        return make_taken_sequence(std::forward<S>(s), c.n);
+    }
+};
+
+//---------------------------------------------------------
+struct drop_closure {
+    std::size_t n;
+
+    template<class S>
+    friend auto operator | (S&& s, const drop_closure& c) {
+        std::decay_t<S> res = std::forward<S>(s);
+        res += c.n;
+        return res;
+    }
+};
+
+//---------------------------------------------------------
+struct stride_closure {
+    std::size_t k;
+
+    template<class S>
+    friend auto operator | (S&& s, const stride_closure& c) {
+        return make_strided_sequence(std::forward<S>(s), c.k);
+    }
+};
+
+//---------------------------------------------------------
+template<class S2>
+struct zip_closure {
+    S2 s2;
+
+    template<class S1>
+    friend auto operator | (S1&& s1, const zip_closure& c) {
+        return make_zipped_sequence(std::forward<S1>(s1), c.s2);
+    }
+};
+
+//---------------------------------------------------------
+struct enumerate_closure {
+    template<class S>
+    friend auto operator | (S&& s, const enumerate_closure&) {
+        return make_enumerated_sequence(std::forward<S>(s));
+    }
+};
+
+}  // namespace seq_detail
+
+
+
+//-------------------------------------------------------------------
+template<class Function>
+inline auto
+transform(Function&& f) {
+    return seq_detail::transform_closure<std::decay_t<Function>>{
+               std::forward<Function>(f)};
+}
+
+//---------------------------------------------------------
+template<class Predicate>
+inline auto
+filter(Predicate&& p) {
+    return seq_detail::filter_closure<std::decay_t<Predicate>>{
+               std::forward<Predicate>(p)};
+}
+
+//---------------------------------------------------------
+inline auto
+take(std::size_t n) {
+    return seq_detail::take_closure{n};
+}
+
+//---------------------------------------------------------
+/// skips the first n values (using the sequence's operator +=)
+inline auto
+drop(std::size_t n) {
+    return seq_detail::drop_closure{n};
+}
+
+//---------------------------------------------------------
+inline auto
+stride(std::size_t k) {
+    return seq_detail::stride_closure{k};
+}
+
+//---------------------------------------------------------
+template<class Sequence>
+inline auto
+zip(Sequence&& s) {
+    return seq_detail::zip_closure<std::decay_t<Sequence>>{
+               std::forward<Sequence>(s)};
+}
+
+//---------------------------------------------------------
+template<class Sequence1, class Sequence2>
+inline auto
+zip(Sequence1&& s1, Sequence2&& s2) {
+    return make_zipped_sequence(std::forward<Sequence1>(s1),
+                                std::forward<Sequence2>(s2));
+}
+
+//---------------------------------------------------------
+inline auto
+enumerate() {
+    return seq_detail::enumerate_closure{};
+}
+
+
+}  // namespace am
+
+
+#endif
@@ -0,0 +1,515 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AMLIB_NUMERIC_ANY_SEQUENCE_H_
+#define AMLIB_NUMERIC_ANY_SEQUENCE_H_
+
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "segmented.h"
+#include "stats.h"
+
+
+namespace am {
+
+
+namespace seq_detail {
+
+
+/*****************************************************************************
+ *
+ * @brief virtual interface of type-erased sequences with value type T
+ *
+ *****************************************************************************/
+template<class T>
+class any_sequence_concept
+{
+public:
+    virtual ~any_sequence_concept() = default;
+
+    /// copy in 'buf' if it fits, on the heap otherwise
+    virtual any_sequence_concept*
+    copy_to(void* buf, std::size_t bufSize) const = 0;
+
+    /// only called for objects that fit into 'buf'
+    virtual any_sequence_concept*
+    move_to(void* buf) noexcept = 0;
+
+    virtual std::size_t next_batch(T* out, std::size_t max) = 0;
+    virtual void advance(std::size_t offset) = 0;
+    virtual std::uint64_t size() const = 0;
+    virtual bool empty() const = 0;
+};
+
+
+
+//-------------------------------------------------------------------
+template<class M>
+constexpr bool
+fits_inline(std::size_t bufSize) noexcept
+{
+    return sizeof(M) <= bufSize &&
+           alignof(M) <= alignof(std::max_align_t) &&
+           std::is_nothrow_move_constructible<M>::value;
+}
+
+
+
+/*****************************************************************************
+ *
+ * @brief wraps a concrete sequence
+ *
+ *****************************************************************************/
+template<class T, class Sequence>
+class any_sequence_model final :
+    public any_sequence_concept<T>
+{
+    using base_t = any_sequence_concept<T>;
+    using seq_value_t = std::decay_t<decltype(*std::declval<const Sequence&>())>;
+
+public:
+    //---------------------------------------------------------------
+    explicit
+    any_sequence_model(Sequence s):
+        s_(std::move(s))
+    {}
+
+
+    //---------------------------------------------------------------
+    base_t*
+    copy_to(void* buf, std::size_t bufSize) const override {
+        if(fits_inline<any_sequence_model>(bufSize)) {
+            return ::new(buf) any_sequence_model(*this);
+        }
+        return new any_sequence_model(*this);
+    }
+    //-----------------------------------------------------
+    base_t*
+    move_to(void* buf) noexcept override {
+        return ::new(buf) any_sequence_model(std::move(*this));
+    }
+
+
+    //---------------------------------------------------------------
+    std::size_t
+    next_batch(T* out, std::size_t max) override {
+        return batch(out, max, std::is_same<seq_value_t,T>{});
+    }
+    //-----------------------------------------------------
+    void
+    advance(std::size_t offset) override {
+        s_ += offset;
+    }
+    //-----------------------------------------------------
+    std::uint64_t
+    size() const override {
+        return count(has_size<Sequence>{});
+    }
+    //-----------------------------------------------------
+    bool
+    empty() const override {
+        return s_.empty();
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    std::size_t
+    batch(T* out, std::size_t max, std::true_type) {
+        return am::next_batch(s_, out, max);
+    }
+    //-----------------------------------------------------
+    /// converts values through a small block
+    std::size_t
+    batch(T* out, std::size_t max, std::false_type)
+    {
+        constexpr std::size_t blockSize = 64;
+        seq_value_t block[blockSize];
+        std::size_t n = 0;
+        while(n < max) {
+            const auto k = std::min(blockSize, max - n);
+            const auto m = am::next_batch(s_, block, k);
+            std::copy_n(block, m, out + n);
+            n += m;
+            if(m < k) break;
+        }
+        return n;
+    }
+
+
+    //---------------------------------------------------------------
+    std::uint64_t
+    count(std::true_type) const {
+        return std::uint64_t(remaining_size(s_));
+    }
+    //-----------------------------------------------------
+    /// sequences without size (filtered, ...) are counted
+    std::uint64_t
+    count(std::false_type) const {
+        std::uint64_t n = 0;
+        for(auto s = s_; !s.empty(); ++s) ++n;
+        return n;
+    }
+
+
+    //---------------------------------------------------------------
+    Sequence s_;
+};
+
+
+}  // namespace seq_detail
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief type-erased sequence of values of type T
+ *
+ *        holds any sequence with (a value type convertible to) T, empty(),
+ *        operator += and either size() or a finite number of values;
+ *        sequences of up to BufferSize bytes are stored inline (no heap
+ *        allocation)
+ *
+ *        values are pulled in blocks of 'block_size' through one virtual
+ *        next_batch call, so * and ++ do not dispatch per element;
+ *        next_batch on the any_sequence itself forwards whole batches
+ *
+ *        copies are independent (e.g. for parallel_fill which copies
+ *        and advances one sequence per chunk); == compares the remaining
+ *        sizes, i.e. it is meant for positions within the same sequence
+ *
+ *****************************************************************************/
+template<class T, std::size_t BufferSize = 16 * sizeof(void*)>
+class any_sequence :
+    private seq_stats::tracked<any_sequence<T,BufferSize>>
+{
+    using base_t = seq_stats::tracked<any_sequence<T,BufferSize>>;
+    using concept_t = seq_detail::any_sequence_concept<T>;
+
+    template<class S>
+    using model_t = seq_detail::any_sequence_model<T,std::decay_t<S>>;
+
+public:
+    //---------------------------------------------------------------
+    using iterator_category = std::input_iterator_tag;
+    using value_type = T;
+    using reference = const value_type&;
+    using pointer = const value_type*;
+    using size_type = std::uint64_t;
+    using difference_type = std::int64_t;
+
+    static constexpr std::size_t buffer_size = BufferSize;
+    static constexpr std::size_t block_size = 16;
+
+
+    //---------------------------------------------------------------
+    /// empty sequence
+    any_sequence() noexcept :
+        base_t{}, m_{nullptr}, pos_{0}, num_{0}
+    {}
+    //-----------------------------------------------------
+    template<class Sequence, class = std::enable_if_t<
+        !std::is_same<std::decay_t<Sequence>,any_sequence>::value>>
+    any_sequence(Sequence&& s):
+        base_t{}, m_{nullptr}, pos_{0}, num_{0}
+    {
+        using m = model_t<Sequence>;
+        emplace<m>(std::forward<Sequence>(s), std::integral_constant<bool,
+                   seq_detail::fits_inline<m>(BufferSize)>{});
+    }
+    //-----------------------------------------------------
+    any_sequence(const any_sequence& o):
+        base_t(o),
+        m_{o.m_ ? o.m_->copy_to(buf_, BufferSize) : nullptr},
+        pos_{o.pos_}, num_{o.num_}
+    {
+        std::copy(o.block_ + pos_, o.block_ + num_, block_ + pos_);
+    }
+    //-----------------------------------------------------
+    any_sequence(any_sequence&& o) noexcept :
+        base_t(std::move(o)), m_{nullptr}, pos_{0}, num_{0}
+    {
+        take(o);
+    }
+
+
+    //---------------------------------------------------------------
+    any_sequence&
+    operator = (const any_sequence& o) {
+        if(this != &o) *this = any_sequence(o);
+        return *this;
+    }
+    //-----------------------------------------------------
+    any_sequence&
+    operator = (any_sequence&& o) noexcept {
+        if(this != &o) {
+            reset();
+            take(o);
+        }
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    ~any_sequence() {
+        reset();
+    }
+
+
+    //---------------------------------------------------------------
+    reference
+    operator * () const {
+        if(pos_ >= num_) fill();
+        return block_[pos_];
+    }
+    //-----------------------------------------------------
+    pointer
+    operator -> () const {
+        return std::addressof(**this);
+    }
+
+
+    //---------------------------------------------------------------
+    any_sequence&
+    operator ++ () {
+        AMLIB_SEQUENCE_COUNT(increment);
+        if(pos_ < num_ || fill()) ++pos_;
+        return *this;
+    }
+    //-----------------------------------------------------
+    /// one virtual call if 'offset' reaches past the buffered values
+    any_sequence&
+    operator += (size_type offset) {
+        AMLIB_SEQUENCE_COUNT(advance);
+        const auto buffered = size_type(num_ - pos_);
+        if(offset <= buffered) {
+            pos_ += std::size_t(offset);
+        }
+        else {
+            pos_ = num_ = 0;
+            if(m_) m_->advance(std::size_t(offset - buffered));
+        }
+        return *this;
+    }
+    //-----------------------------------------------------
+    any_sequence
+    operator + (size_type offset) const {
+        auto res = *this;
+        res += offset;
+        return res;
+    }
+    //-----------------------------------------------------
+    /**
+     * @brief writes up to 'max' values to 'out' and advances past them;
+     *        buffered values are copied, the rest is pulled with one
+     *        virtual call
+     */
+    std::size_t
+    next_batch(value_type* out, std::size_t max)
+    {
+        const auto n = std::min(num_ - pos_, max);
+        std::copy_n(block_ + pos_, n, out);
+        pos_ += n;
+        if(n >= max || !m_) return n;
+        return n + m_->next_batch(out + n, max - n);
+    }
+
+
+    //---------------------------------------------------------------
+    size_type
+    size() const {
+        AMLIB_SEQUENCE_COUNT(size);
+        return size_type(num_ - pos_) + (m_ ? m_->size() : 0);
+    }
+    //-----------------------------------------------------
+    bool
+    empty() const {
+        return pos_ >= num_ && !fill();
+    }
+    //-----------------------------------------------------
+    explicit operator
+    bool() const {
+        return !empty();
+    }
+
+
+    //---------------------------------------------------------------
+    /// true, if the wrapped sequence is stored without heap allocation
+    bool
+    stored_inline() const noexcept {
+        return !m_ || is_inline();
+    }
+
+
+    //---------------------------------------------------------------
+    const any_sequence&
+    begin() const noexcept {
+        return *this;
+    }
+    //-----------------------------------------------------
+    any_sequence
+    end() const noexcept {
+        AMLIB_SEQUENCE_COUNT(end);
+        return any_sequence{};
+    }
+
+
+    //---------------------------------------------------------------
+    bool
+    operator == (const any_sequence& o) const {
+        AMLIB_SEQUENCE_COUNT(compare);
+        if(empty() || o.empty()) return empty() && o.empty();
+        return size() == o.size();
+    }
+    //-----------------------------------------------------
+    bool
+    operator != (const any_sequence& o) const {
+        return !(*this == o);
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    bool
+    is_inline() const noexcept {
+        return static_cast<const void*>(m_) == static_cast<const void*>(buf_);
+    }
+    //-----------------------------------------------------
+    template<class M, class Sequence>
+    void
+    emplace(Sequence&& s, std::true_type) {
+        m_ = ::new(static_cast<void*>(buf_)) M(std::forward<Sequence>(s));
+    }
+    //-----------------------------------------------------
+    template<class M, class Sequence>
+    void
+    emplace(Sequence&& s, std::false_type) {
+        m_ = new M(std::forward<Sequence>(s));
+    }
+    //-----------------------------------------------------
+    /// refills the value block; false if the sequence is exhausted
+    bool
+    fill() const {
+        pos_ = 0;
+        num_ = m_ ? m_->next_batch(block_, block_size) : 0;
+        return num_ > 0;
+    }
+    //-----------------------------------------------------
+    void
+    reset() noexcept {
+        if(m_) {
+            if(is_inline()) m_->~concept_t(); else delete m_;
+            m_ = nullptr;
+        }
+        pos_ = num_ = 0;
+    }
+    //-----------------------------------------------------
+    /// 'o' is left empty
+    void
+    take(any_sequence& o) noexcept {
+        if(o.m_) {
+            if(o.is_inline()) {
+                m_ = o.m_->move_to(buf_);
+                o.m_->~concept_t();
+            } else {
+                m_ = o.m_;
+            }
+            o.m_ = nullptr;
+        }
+        std::copy(o.block_ + o.pos_, o.block_ + o.num_, block_ + o.pos_);
+        pos_ = o.pos_;
+        num_ = o.num_;
+        o.pos_ = o.num_ = 0;
+    }
+
+
+    //---------------------------------------------------------------
+    alignas(std::max_align_t) unsigned char buf_[BufferSize];
+    concept_t* m_;
+    mutable value_type block_[block_size];
+    mutable std::size_t pos_;
+    mutable std::size_t num_;
+};
+
+//-------------------------------------------------------------------
+template<class T, std::size_t B>
+constexpr std::size_t any_sequence<T,B>::buffer_size;
+
+template<class T, std::size_t B>
+constexpr std::size_t any_sequence<T,B>::block_size;
+
+
+
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+template<class T, std::size_t B>
+inline decltype(auto)
+begin(const any_sequence<T,B>& s) noexcept
+{
+    return s.begin();
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t B>
+inline decltype(auto)
+cbegin(const any_sequence<T,B>& s) noexcept
+{
+    return s.begin();
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t B>
+inline decltype(auto)
+end(const any_sequence<T,B>& s) noexcept
+{
+    return s.end();
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t B>
+inline decltype(auto)
+cend(const any_sequence<T,B>& s) noexcept
+{
+    return s.end();
+}
+
+
+
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+template<class Sequence>
+inline auto
+make_any_sequence(Sequence&& s)
+{
+    using value_t = std::decay_t<decltype(*s)>;
+    return any_sequence<value_t>{std::forward<Sequence>(s)};
+}
+
+
+}  // namespace am
+
+
+#endif
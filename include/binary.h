@@ -0,0 +1,478 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AMLIB_NUMERIC_BINARY_SEQUENCE_H_
+#define AMLIB_NUMERIC_BINARY_SEQUENCE_H_
+
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#  define AMLIB_SEQUENCE_MMAP 1
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#else
+#  define AMLIB_SEQUENCE_MMAP 0
+#endif
+
+#include "segmented.h"
+#include "stats.h"
+
+
+namespace am {
+
+
+/*****************************************************************************
+ *
+ * BINARY FILE FORMAT
+ *
+ * 64 byte header followed by 'count' values in native byte order;
+ * values start at a cache line boundary
+ *
+ *****************************************************************************/
+enum class binary_type : std::uint32_t {
+    signed_integer   = 1,
+    unsigned_integer = 2,
+    floating_point   = 3
+};
+
+
+//-------------------------------------------------------------------
+struct binary_header
+{
+    static constexpr std::uint32_t byte_order_mark = 0x01020304;
+    static constexpr std::uint32_t current_version = 1;
+
+    char          magic[8] = {'A','M','S','E','Q','\0','\0','\0'};
+    std::uint32_t version = current_version;
+    std::uint32_t byteOrder = byte_order_mark;
+    binary_type   type = binary_type::signed_integer;
+    std::uint32_t width = 0;
+    std::uint64_t count = 0;
+    char          reserved[32] = {};
+};
+
+static_assert(sizeof(binary_header) == 64, "binary header must be 64 bytes");
+
+
+
+namespace seq_detail {
+
+
+//-------------------------------------------------------------------
+template<class T>
+constexpr binary_type
+binary_type_of() noexcept
+{
+    static_assert(std::is_arithmetic<T>::value,
+                  "only arithmetic types can be stored in binary files");
+
+    return std::is_floating_point<T>::value ? binary_type::floating_point
+         : std::is_signed<T>::value         ? binary_type::signed_integer
+         :                                    binary_type::unsigned_integer;
+}
+
+
+
+/*************************************************************************//***
+ *
+ * @brief read-only view of a whole file;
+ *        memory-mapped on POSIX systems, read into memory otherwise
+ *
+ *****************************************************************************/
+class file_mapping
+{
+public:
+    //---------------------------------------------------------------
+    explicit
+    file_mapping(const std::string& path)
+    {
+#if AMLIB_SEQUENCE_MMAP
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if(fd < 0) {
+            throw std::runtime_error{"could not open file " + path};
+        }
+        struct stat st;
+        if(::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error{"could not stat file " + path};
+        }
+        size_ = std::size_t(st.st_size);
+        if(size_ > 0) {
+            void* p = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+            if(p == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error{"could not map file " + path};
+            }
+            data_ = static_cast<const unsigned char*>(p);
+        }
+        ::close(fd);
+#else
+        std::FILE* f = std::fopen(path.c_str(), "rb");
+        if(!f) throw std::runtime_error{"could not open file " + path};
+        std::fseek(f, 0, SEEK_END);
+        buffer_.resize(std::size_t(std::ftell(f)));
+        std::fseek(f, 0, SEEK_SET);
+        size_ = std::fread(buffer_.data(), 1, buffer_.size(), f);
+        std::fclose(f);
+        data_ = buffer_.data();
+#endif
+    }
+
+    //-----------------------------------------------------
+    file_mapping(const file_mapping&) = delete;
+    file_mapping& operator = (const file_mapping&) = delete;
+
+    //-----------------------------------------------------
+    ~file_mapping() {
+#if AMLIB_SEQUENCE_MMAP
+        if(data_) {
+            ::munmap(const_cast<unsigned char*>(data_), size_);
+        }
+#endif
+    }
+
+
+    //---------------------------------------------------------------
+    const unsigned char*
+    data() const noexcept {
+        return data_;
+    }
+    //-----------------------------------------------------
+    std::size_t
+    size() const noexcept {
+        return size_;
+    }
+
+
+private:
+    const unsigned char* data_ = nullptr;
+    std::size_t size_ = 0;
+#if !AMLIB_SEQUENCE_MMAP
+    std::vector<unsigned char> buffer_;
+#endif
+};
+
+
+}  // namespace seq_detail
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief zero-copy random access sequence over the values of a binary file
+ *        written by write_binary;
+ *        copies share the underlying file mapping
+ *
+ *****************************************************************************/
+template<class T>
+class mapped_sequence :
+    private seq_stats::tracked<mapped_sequence<T>>
+{
+public:
+    //---------------------------------------------------------------
+    using iterator_category = std::input_iterator_tag;
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+
+
+    //---------------------------------------------------------------
+    mapped_sequence() = default;
+
+    //-----------------------------------------------------
+    explicit
+    mapped_sequence(const std::string& path):
+        file_{std::make_shared<const seq_detail::file_mapping>(path)},
+        cur_{nullptr}, end_{nullptr}
+    {
+        if(file_->size() < sizeof(binary_header)) {
+            throw std::runtime_error{"not a sequence file: " + path};
+        }
+        binary_header h;
+        std::memcpy(&h, file_->data(), sizeof(binary_header));
+
+        if(std::memcmp(h.magic, binary_header{}.magic, sizeof(h.magic)) != 0) {
+            throw std::runtime_error{"not a sequence file: " + path};
+        }
+        if(h.version != binary_header::current_version) {
+            throw std::runtime_error{"unsupported file version: " + path};
+        }
+        if(h.byteOrder != binary_header::byte_order_mark) {
+            throw std::runtime_error{"byte order mismatch: " + path};
+        }
+        if(h.type != seq_detail::binary_type_of<T>() || h.width != sizeof(T)) {
+            throw std::runtime_error{"value type mismatch: " + path};
+        }
+        if((file_->size() - sizeof(binary_header)) / sizeof(T) < h.count) {
+            throw std::runtime_error{"truncated sequence file: " + path};
+        }
+
+        cur_ = reinterpret_cast<const T*>(file_->data() + sizeof(binary_header));
+        end_ = cur_ + h.count;
+    }
+
+
+    //---------------------------------------------------------------
+    reference
+    operator * () const noexcept {
+        return *cur_;
+    }
+    //-----------------------------------------------------
+    pointer
+    operator -> () const noexcept {
+        return cur_;
+    }
+
+    //-----------------------------------------------------
+    reference
+    operator [] (size_type offset) const noexcept {
+        AMLIB_SEQUENCE_COUNT(subscript);
+        return cur_[offset];
+    }
+
+
+    //---------------------------------------------------------------
+    mapped_sequence&
+    operator ++ () noexcept {
+        AMLIB_SEQUENCE_COUNT(increment);
+        ++cur_;
+        return *this;
+    }
+    //-----------------------------------------------------
+    mapped_sequence&
+    operator += (size_type offset) noexcept {
+        AMLIB_SEQUENCE_COUNT(advance);
+        cur_ += std::min(offset, size());
+        return *this;
+    }
+    //-----------------------------------------------------
+    mapped_sequence
+    operator + (size_type offset) const noexcept {
+        auto res = *this;
+        res += offset;
+        return res;
+    }
+    //-----------------------------------------------------
+    /// copies up to 'max' values to 'out' and advances past them
+    size_type
+    next_batch(value_type* out, size_type max) noexcept {
+        const auto n = std::min(size(), max);
+        std::copy_n(cur_, n, out);
+        cur_ += n;
+        return n;
+    }
+
+
+    //---------------------------------------------------------------
+    /// pointer to the current value; remaining values are contiguous
+    pointer
+    data() const noexcept {
+        return cur_;
+    }
+
+
+    //---------------------------------------------------------------
+    bool
+    operator == (const mapped_sequence& o) const noexcept {
+        AMLIB_SEQUENCE_COUNT(compare);
+        return (cur_ == o.cur_) && (end_ == o.end_);
+    }
+    //-----------------------------------------------------
+    bool
+    operator != (const mapped_sequence& o) const noexcept {
+        return !(*this == o);
+    }
+
+
+    //---------------------------------------------------------------
+    size_type
+    size() const noexcept {
+        AMLIB_SEQUENCE_COUNT(size);
+        return size_type(end_ - cur_);
+    }
+    //-----------------------------------------------------
+    bool
+    empty() const noexcept {
+        return cur_ >= end_;
+    }
+
+
+    //---------------------------------------------------------------
+    const mapped_sequence&
+    begin() const noexcept {
+        return *this;
+    }
+    //-----------------------------------------------------
+    mapped_sequence
+    end() const noexcept {
+        AMLIB_SEQUENCE_COUNT(end);
+        auto res = *this;
+        res.cur_ = end_;
+        return res;
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    std::shared_ptr<const seq_detail::file_mapping> file_;
+    const T* cur_ = nullptr;
+    const T* end_ = nullptr;
+};
+
+
+
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+template<class T>
+inline decltype(auto)
+begin(const mapped_sequence<T>& s) noexcept
+{
+    return s.begin();
+}
+
+//---------------------------------------------------------
+template<class T>
+inline decltype(auto)
+cbegin(const mapped_sequence<T>& s) noexcept
+{
+    return s.begin();
+}
+
+//---------------------------------------------------------
+template<class T>
+inline decltype(auto)
+end(const mapped_sequence<T>& s) noexcept
+{
+    return s.end();
+}
+
+//---------------------------------------------------------
+template<class T>
+inline decltype(auto)
+cend(const mapped_sequence<T>& s) noexcept
+{
+    return s.end();
+}
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief opens a binary sequence file written by write_binary;
+ *        throws std::runtime_error if the file does not exist or
+ *        does not contain values of type T
+ *
+ *****************************************************************************/
+template<class T>
+inline mapped_sequence<T>
+open_binary_sequence(const std::string& path)
+{
+    return mapped_sequence<T>{path};
+}
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief writes all remaining values of 'seq' to a binary file
+ *        (header + raw values);
+ *        values are pulled with next_batch into an aligned buffer of
+ *        'chunkBytes' bytes which is written with one system call per chunk
+ *
+ *        if the sequence ends before size() values were pulled, the header
+ *        count is rewritten to the number of values actually written
+ *
+ * @return number of values written;
+ *         throws std::runtime_error on I/O errors
+ *
+ *****************************************************************************/
+template<class Sequence>
+std::size_t
+write_binary(const Sequence& seq, const std::string& path,
+             std::size_t chunkBytes = (std::size_t(1) << 22))
+{
+    using value_t = std::decay_t<decltype(*seq)>;
+
+    const auto n = std::size_t(seq_detail::remaining_size(seq));
+
+    binary_header h;
+    h.type = seq_detail::binary_type_of<value_t>();
+    h.width = sizeof(value_t);
+    h.count = n;
+
+    const auto chunkSize = std::max(std::size_t(1), chunkBytes / sizeof(value_t));
+    //value_t[] is suitably aligned for the value type
+    auto buf = std::unique_ptr<value_t[]>{new value_t[chunkSize]};
+
+    std::unique_ptr<std::FILE,int(*)(std::FILE*)> f{
+        std::fopen(path.c_str(), "wb"), &std::fclose};
+
+    if(!f) throw std::runtime_error{"could not open file " + path};
+
+    //chunks are larger than the stdio buffer anyway
+    std::setvbuf(f.get(), nullptr, _IONBF, 0);
+
+    if(std::fwrite(&h, sizeof(h), 1, f.get()) != 1) {
+        throw std::runtime_error{"could not write to " + path};
+    }
+
+    auto s = seq;
+    std::size_t written = 0;
+    while(written < n) {
+        const auto m = am::next_batch(s, buf.get(), std::min(chunkSize, n - written));
+        if(m < 1) break;
+        if(std::fwrite(buf.get(), sizeof(value_t), m, f.get()) != m) {
+            throw std::runtime_error{"could not write to " + path};
+        }
+        written += m;
+    }
+
+    //sequence ended early: header must not claim missing values
+    if(written < n) {
+        h.count = written;
+        if(std::fseek(f.get(), 0, SEEK_SET) != 0 ||
+           std::fwrite(&h, sizeof(h), 1, f.get()) != 1)
+        {
+            throw std::runtime_error{"could not write to " + path};
+        }
+    }
+
+    if(std::fclose(f.release()) != 0) {
+        throw std::runtime_error{"could not write to " + path};
+    }
+    return written;
+}
+
+
+}  // namespace am
+
+
+#endif
@@ -0,0 +1,402 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AMLIB_NUMERIC_CACHED_SEQUENCE_H_
+#define AMLIB_NUMERIC_CACHED_SEQUENCE_H_
+
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "segmented.h"
+#include "stats.h"
+
+
+namespace am {
+
+
+/*************************************************************************//***
+ *
+ * @brief memoizes the values of an underlying sequence in a ring buffer
+ *        of fixed capacity
+ *
+ *        values are generated in chunks of Capacity/4 when first needed;
+ *        dereferencing, [] into the next Capacity values and lookback(k)
+ *        into (up to) the last 3/4 Capacity values are served from the
+ *        buffer; [] beyond that falls through to the underlying sequence
+ *
+ *        the buffer is allocated once on first use; end() never allocates;
+ *        const access fills the buffer, so concurrent readers need
+ *        their own copies
+ *
+ *****************************************************************************/
+template<class Sequence, std::size_t Capacity = 256>
+class cached_sequence :
+    private seq_stats::tracked<cached_sequence<Sequence,Capacity>>
+{
+    static_assert(Capacity >= 4 && (Capacity & (Capacity - 1)) == 0,
+                  "cached_sequence capacity must be a power of 2 (>= 4)");
+
+public:
+    //---------------------------------------------------------------
+    using sequence_type = Sequence;
+    //-----------------------------------------------------
+    using iterator_category = std::input_iterator_tag;
+    using difference_type = typename sequence_type::difference_type;
+    using size_type = typename sequence_type::size_type;
+    //-----------------------------------------------------
+    using value_type = std::decay_t<typename sequence_type::value_type>;
+    using reference = const value_type&;
+    using pointer = const value_type*;
+
+    static constexpr std::size_t capacity = Capacity;
+    static constexpr std::size_t chunk_size = Capacity / 4;
+
+
+    //---------------------------------------------------------------
+    explicit
+    cached_sequence(sequence_type s = sequence_type()):
+        s_{std::move(s)}, buf_{},
+        pos_{0}, lo_{0}, hi_{0},
+        hits_{0}, misses_{0}
+    {}
+
+
+    //---------------------------------------------------------------
+    const value_type&
+    operator * () const {
+        if(pos_ < hi_) {
+            ++hits_;
+        } else {
+            ++misses_;
+            fill();
+        }
+        return buf_[pos_ & mask];
+    }
+    //-----------------------------------------------------
+    const value_type*
+    operator -> () const {
+        return std::addressof(**this);
+    }
+    //-----------------------------------------------------
+    value_type
+    operator [] (size_type offset) const
+    {
+        AMLIB_SEQUENCE_COUNT(subscript);
+        if(offset < hi_ - pos_) {
+            ++hits_;
+            return buf_[(pos_ + offset) & mask];
+        }
+        ++misses_;
+        if(offset >= capacity) return s_[offset - (hi_ - pos_)];
+
+        while(offset >= hi_ - pos_ && fill()) {}
+        return buf_[(pos_ + offset) & mask];
+    }
+
+
+    //---------------------------------------------------------------
+    /**
+     * @brief value 'k' positions before the current one
+     * @throws std::out_of_range if it is no longer (or was never) buffered
+     */
+    const value_type&
+    lookback(size_type k) const
+    {
+        if(k == 0) return **this;
+        if(k > lookback_size()) {
+            throw std::out_of_range{"cached_sequence: value not buffered"};
+        }
+        ++hits_;
+        return buf_[(pos_ - k) & mask];
+    }
+    //-----------------------------------------------------
+    /// number of preceding values that lookback can serve
+    size_type
+    lookback_size() const noexcept {
+        return pos_ - lo_;
+    }
+
+
+    //---------------------------------------------------------------
+    cached_sequence&
+    operator ++ () {
+        AMLIB_SEQUENCE_COUNT(increment);
+        if(pos_ < hi_) {
+            ++pos_;
+        } else {
+            skip(1);
+        }
+        return *this;
+    }
+    //-----------------------------------------------------
+    /// skipping past the buffered values discards the buffer contents
+    cached_sequence&
+    operator += (size_type offset) {
+        AMLIB_SEQUENCE_COUNT(advance);
+        if(offset <= hi_ - pos_) {
+            pos_ += offset;
+        } else {
+            skip(offset - (hi_ - pos_));
+        }
+        return *this;
+    }
+    //-----------------------------------------------------
+    cached_sequence
+    operator + (size_type offset) const {
+        auto res = *this;
+        res += offset;
+        return res;
+    }
+    //-----------------------------------------------------
+    /**
+     * @brief writes up to 'max' values to 'out' and advances past them
+     *
+     *        buffered values are copied (one hit per value); the rest is
+     *        pulled from the underlying sequence in one batch (one miss)
+     *        and its tail is kept in the buffer for lookback
+     */
+    size_type
+    next_batch(value_type* out, size_type max)
+    {
+        auto n = std::min(hi_ - pos_, max);
+        for(size_type i = 0; i < n; ++i) {
+            out[i] = buf_[(pos_ + i) & mask];
+        }
+        pos_ += n;
+        hits_ += n;
+        if(n >= max || s_.empty()) return n;
+
+        ++misses_;
+        const auto m = am::next_batch(s_, out + n, max - n);
+        const auto keep = std::min(m, size_type(capacity));
+        if(keep > 0 && buf_.empty()) buf_.resize(capacity);
+        for(size_type i = m - keep; i < m; ++i) {
+            buf_[(hi_ + i) & mask] = out[n + i];
+        }
+        hi_ += m;
+        pos_ = hi_;
+        if(hi_ - lo_ > capacity) lo_ = hi_ - capacity;
+        return n + m;
+    }
+
+
+    //---------------------------------------------------------------
+    /// number of accesses served from the buffer
+    std::uint64_t
+    hits() const noexcept {
+        return hits_;
+    }
+    //-----------------------------------------------------
+    /// number of accesses that had to evaluate the underlying sequence
+    std::uint64_t
+    misses() const noexcept {
+        return misses_;
+    }
+    //-----------------------------------------------------
+    void
+    reset_counters() noexcept {
+        hits_ = 0;
+        misses_ = 0;
+    }
+
+
+    //---------------------------------------------------------------
+    /// underlying sequence; positioned after the buffered values
+    const sequence_type&
+    base() const noexcept {
+        return s_;
+    }
+
+
+    //---------------------------------------------------------------
+    const value_type&
+    front() const {
+        return **this;
+    }
+    //-----------------------------------------------------
+    size_type
+    size() const {
+        AMLIB_SEQUENCE_COUNT(size);
+        return (hi_ - pos_) + seq_detail::remaining_size(s_);
+    }
+    //-----------------------------------------------------
+    bool
+    empty() const {
+        return (pos_ >= hi_) && s_.empty();
+    }
+    //-----------------------------------------------------
+    explicit operator
+    bool() const {
+        return !empty();
+    }
+
+
+    //---------------------------------------------------------------
+    const cached_sequence&
+    begin() const noexcept {
+        return *this;
+    }
+    //-----------------------------------------------------
+    cached_sequence
+    end() const {
+        AMLIB_SEQUENCE_COUNT(end);
+        return cached_sequence{s_.end()};
+    }
+
+
+    //---------------------------------------------------------------
+    bool
+    operator == (const cached_sequence& o) const
+    {
+        AMLIB_SEQUENCE_COUNT(compare);
+        if(empty() || o.empty()) return empty() && o.empty();
+
+        //underlying sequences are positioned 'ahead' values after ours
+        const auto ahead = hi_ - pos_;
+        const auto oAhead = o.hi_ - o.pos_;
+        if(ahead == oAhead) return s_ == o.s_;
+        if(ahead < oAhead) return (s_ + (oAhead - ahead)) == o.s_;
+        return s_ == (o.s_ + (ahead - oAhead));
+    }
+    //-----------------------------------------------------
+    bool
+    operator != (const cached_sequence& o) const {
+        return !(*this == o);
+    }
+
+
+private:
+    static constexpr size_type mask = size_type(Capacity - 1);
+
+
+    //---------------------------------------------------------------
+    /**
+     * @brief appends up to one chunk to the buffer without evicting
+     *        the current position
+     * @return false, if the underlying sequence is exhausted
+     */
+    bool
+    fill() const
+    {
+        if(buf_.empty()) buf_.resize(capacity);
+
+        const auto room = pos_ + capacity - hi_;
+        const auto m = (room < chunk_size) ? room : size_type(chunk_size);
+        //the free slots may wrap around the end of the ring
+        const auto first = hi_ & mask;
+        const auto m1 = std::min(m, size_type(capacity - first));
+        auto n = am::next_batch(s_, buf_.data() + first, m1);
+        if(n == m1 && m > m1) {
+            n += am::next_batch(s_, buf_.data(), m - m1);
+        }
+        hi_ += n;
+        if(hi_ - lo_ > capacity) lo_ = hi_ - capacity;
+        return n > 0;
+    }
+
+    //---------------------------------------------------------------
+    /// advances the underlying sequence by k past the buffer end
+    void
+    skip(size_type k)
+    {
+        s_ += k;
+        constexpr auto maxPos = std::numeric_limits<size_type>::max();
+        hi_ = (k < maxPos - hi_) ? (hi_ + k) : maxPos;
+        pos_ = lo_ = hi_;
+    }
+
+
+    //---------------------------------------------------------------
+    mutable sequence_type s_;
+    mutable std::vector<value_type> buf_;
+    size_type pos_;
+    mutable size_type lo_;
+    mutable size_type hi_;
+    mutable std::uint64_t hits_;
+    mutable std::uint64_t misses_;
+};
+
+//-------------------------------------------------------------------
+template<class S, std::size_t C>
+constexpr std::size_t cached_sequence<S,C>::capacity;
+
+template<class S, std::size_t C>
+constexpr std::size_t cached_sequence<S,C>::chunk_size;
+
+template<class S, std::size_t C>
+constexpr typename cached_sequence<S,C>::size_type cached_sequence<S,C>::mask;
+
+
+
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+template<class S, std::size_t C>
+inline decltype(auto)
+begin(const cached_sequence<S,C>& s) noexcept
+{
+    return s.begin();
+}
+
+//---------------------------------------------------------
+template<class S, std::size_t C>
+inline decltype(auto)
+cbegin(const cached_sequence<S,C>& s) noexcept
+{
+    return s.begin();
+}
+
+//---------------------------------------------------------
+template<class S, std::size_t C>
+inline decltype(auto)
+end(const cached_sequence<S,C>& s)
+{
+    return s.end();
+}
+
+//---------------------------------------------------------
+template<class S, std::size_t C>
+inline decltype(auto)
+cend(const cached_sequence<S,C>& s)
+{
+    return s.end();
+}
+
+
+
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+template<std::size_t Capacity = 256, class Sequence>
+inline auto
+make_cached_sequence(Sequence&& s)
+{
+    return cached_sequence<std::decay_t<Sequence>,Capacity>{
+        std::forward<Sequence>(s)};
+}
+
+
+}  // namespace am
+
+
+#endif
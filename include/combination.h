@@ -0,0 +1,347 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AMLIB_NUMERIC_COMBINATION_SEQUENCE_H_
+#define AMLIB_NUMERIC_COMBINATION_SEQUENCE_H_
+
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+
+#include "stats.h"
+
+
+namespace am {
+
+
+namespace seq_detail {
+
+
+/*************************************************************************//***
+ *
+ * @brief Pascal's triangle up to n = 64;
+ *        all entries are exact: C(n,k) <= C(64,32) < 2^61
+ *
+ *****************************************************************************/
+struct binomial_table
+{
+    static constexpr unsigned max_n = 64;
+
+    //row k holds C(0,k), C(1,k), ..., C(max_n,k)  (non-decreasing)
+    std::uint64_t c[max_n+1][max_n+1];
+
+    binomial_table() noexcept {
+        for(unsigned k = 0; k <= max_n; ++k) {
+            for(unsigned n = 0; n <= max_n; ++n) {
+                c[k][n] = (k == 0) ? 1
+                        : (n == 0) ? 0
+                        : c[k-1][n-1] + c[k][n-1];
+            }
+        }
+    }
+
+    std::uint64_t
+    operator () (unsigned n, unsigned k) const noexcept {
+        return (n <= max_n && k <= max_n) ? c[k][n] : 0;
+    }
+};
+
+//-------------------------------------------------------------------
+inline const binomial_table&
+binomials()
+{
+    static const binomial_table t;
+    return t;
+}
+
+
+}  // namespace seq_detail
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief all k-subsets of {0, ..., n-1} (n <= 64) as bitmasks
+ *        in colexicographic order (= increasing numeric value)
+ *
+ *        ++ is Gosper's hack (O(1));
+ *        [] and += unrank in the combinatorial number system
+ *        rank = sum_i C(c_i, i)  (O(k log n) with a binomial table),
+ *        so the subset space can be split among threads
+ *
+ *        throws std::invalid_argument if n > 64 or k > n
+ *
+ *****************************************************************************/
+class combination_sequence :
+    private seq_stats::tracked<combination_sequence>
+{
+public:
+    //---------------------------------------------------------------
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::uint64_t;
+    using reference = const value_type&;
+    using pointer = const value_type*;
+    using size_type = std::uint64_t;
+    using difference_type = std::int64_t;
+
+    static constexpr unsigned max_items = seq_detail::binomial_table::max_n;
+
+
+    //---------------------------------------------------------------
+    combination_sequence(unsigned n, unsigned k):
+        n_{n}, k_{k}, idx_{0}, end_{0}, mask_{0}
+    {
+        if(n > max_items) {
+            throw std::invalid_argument{
+                "combination_sequence: at most 64 items supported"};
+        }
+        if(k > n) {
+            throw std::invalid_argument{
+                "combination_sequence: subset larger than set"};
+        }
+        end_ = seq_detail::binomials()(n, k);
+        mask_ = lowest_bits(k);
+    }
+
+
+    //---------------------------------------------------------------
+    reference
+    operator * () const noexcept {
+        return mask_;
+    }
+    //-----------------------------------------------------
+    pointer
+    operator -> () const noexcept {
+        return std::addressof(mask_);
+    }
+    //-----------------------------------------------------
+    value_type
+    operator [] (size_type offset) const noexcept {
+        AMLIB_SEQUENCE_COUNT(subscript);
+        return unrank(idx_ + offset);
+    }
+
+
+    //---------------------------------------------------------------
+    combination_sequence&
+    operator ++ () noexcept {
+        AMLIB_SEQUENCE_COUNT(increment);
+        if(++idx_ < end_) mask_ = next_mask(mask_);
+        return *this;
+    }
+    //-----------------------------------------------------
+    combination_sequence&
+    operator += (size_type offset) noexcept {
+        AMLIB_SEQUENCE_COUNT(advance);
+        idx_ = (offset < (end_ - idx_)) ? (idx_ + offset) : end_;
+        if(idx_ < end_) mask_ = unrank(idx_);
+        return *this;
+    }
+    //-----------------------------------------------------
+    combination_sequence
+    operator + (size_type offset) const noexcept {
+        auto res = *this;
+        res += offset;
+        return res;
+    }
+    //-----------------------------------------------------
+    /// writes up to 'max' subsets to 'out' and advances past them
+    size_type
+    next_batch(value_type* out, size_type max) noexcept {
+        const auto n = std::min(size(), max);
+        auto m = mask_;
+        for(size_type i = 0; i < n; ++i) {
+            out[i] = m;
+            if(idx_ + i + 1 < end_) m = next_mask(m);
+        }
+        idx_ += n;
+        mask_ = m;
+        return n;
+    }
+
+
+    //---------------------------------------------------------------
+    /// number of items n
+    unsigned
+    items() const noexcept {
+        return n_;
+    }
+    //-----------------------------------------------------
+    /// subset size k
+    unsigned
+    subset_size() const noexcept {
+        return k_;
+    }
+    //-----------------------------------------------------
+    /// absolute index (rank) of the current subset
+    size_type
+    index() const noexcept {
+        return idx_;
+    }
+
+    //---------------------------------------------------------------
+    /// rank of a k-subset bitmask (inverse of unranking)
+    static size_type
+    index_of(value_type mask) noexcept
+    {
+        const auto& binom = seq_detail::binomials();
+        size_type r = 0;
+        for(unsigned i = 1; mask != 0; ++i, mask &= mask - 1) {
+            unsigned c = 0;
+            for(auto m = mask; !(m & 1); m >>= 1) ++c;
+            r += binom(c, i);
+        }
+        return r;
+    }
+
+
+    //---------------------------------------------------------------
+    bool
+    operator == (const combination_sequence& o) const noexcept {
+        AMLIB_SEQUENCE_COUNT(compare);
+        return (idx_ == o.idx_) && (n_ == o.n_) && (k_ == o.k_);
+    }
+    //-----------------------------------------------------
+    bool
+    operator != (const combination_sequence& o) const noexcept {
+        return !(*this == o);
+    }
+
+
+    //---------------------------------------------------------------
+    /// exact number of remaining subsets (C(n,k) at the beginning)
+    size_type
+    size() const noexcept {
+        AMLIB_SEQUENCE_COUNT(size);
+        return end_ - idx_;
+    }
+    //-----------------------------------------------------
+    bool
+    empty() const noexcept {
+        return idx_ >= end_;
+    }
+
+
+    //---------------------------------------------------------------
+    const combination_sequence&
+    begin() const noexcept {
+        return *this;
+    }
+    //-----------------------------------------------------
+    combination_sequence
+    end() const noexcept {
+        AMLIB_SEQUENCE_COUNT(end);
+        auto res = *this;
+        res.idx_ = end_;
+        return res;
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    static value_type
+    lowest_bits(unsigned k) noexcept {
+        return (k >= 64) ? ~value_type(0) : (value_type(1) << k) - 1;
+    }
+
+    //---------------------------------------------------------------
+    /// Gosper's hack: next larger number with the same popcount
+    static value_type
+    next_mask(value_type m) noexcept {
+        const auto c = m & (~m + 1);
+        const auto r = m + c;
+        return (((r ^ m) >> 2) / c) | r;
+    }
+
+    //---------------------------------------------------------------
+    /// subset with colex rank r: greedily pick the largest c_i
+    /// with C(c_i, i) <= r for i = k, ..., 1
+    value_type
+    unrank(size_type r) const noexcept
+    {
+        const auto& binom = seq_detail::binomials();
+        value_type mask = 0;
+        unsigned hi = n_;
+        for(unsigned i = k_; i > 0; --i) {
+            const auto row = binom.c[i];
+            const auto c = unsigned(std::upper_bound(row, row + hi, r) - row) - 1;
+            r -= row[c];
+            mask |= value_type(1) << c;
+            hi = c;
+        }
+        return mask;
+    }
+
+
+    //---------------------------------------------------------------
+    unsigned n_;
+    unsigned k_;
+    size_type idx_;
+    size_type end_;
+    value_type mask_;
+};
+
+
+
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+inline decltype(auto)
+begin(const combination_sequence& s) noexcept
+{
+    return s.begin();
+}
+
+//---------------------------------------------------------
+inline decltype(auto)
+cbegin(const combination_sequence& s) noexcept
+{
+    return s.begin();
+}
+
+//---------------------------------------------------------
+inline decltype(auto)
+end(const combination_sequence& s) noexcept
+{
+    return s.end();
+}
+
+//---------------------------------------------------------
+inline decltype(auto)
+cend(const combination_sequence& s) noexcept
+{
+    return s.end();
+}
+
+
+
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+inline auto
+make_combination_sequence(unsigned n, unsigned k)
+{
+    return combination_sequence{n, k};
+}
+
+
+}  // namespace am
+
+
+#endif
@@ -12,23 +12,48 @@
 #define AMLIB_NUMERIC_COMBINED_SEQUENCE_H_
 
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
+#include <iterator>
+#include <memory>
+#include <tuple>
 #include <type_traits>
+#include <utility>
+#include <vector>
 #include <cmath>
 
+#include "concepts.h"
+#include "segmented.h"
+#include "stats.h"
+
 
 namespace am {
 
+
 /*****************************************************************************
  *
- *
+ * @brief concatenation of 2 or more sequences
  *
  *****************************************************************************/
 template<
     class Sequence1,
-    class Sequence2 = Sequence1
+    class Sequence2 = Sequence1,
+    class... Sequences
 >
-class combined_sequence
+class combined_sequence;
+
+
+
+
+/*****************************************************************************
+ *
+ * @brief concatenation of 2 sequences
+ *
+ *****************************************************************************/
+template<class Sequence1, class Sequence2>
+class combined_sequence<Sequence1,Sequence2> :
+    private seq_stats::tracked<combined_sequence<Sequence1,Sequence2>>
 {
 public:
     //---------------------------------------------------------------
@@ -72,7 +97,7 @@ public:
     //-----------------------------------------------------
     auto
     operator -> () const {
-        return fstSequ_.emtpy() ?
+        return fstSequ_.empty() ?
             std::addressof(*sndSequ_) :
             std::addressof(*fstSequ_);
     }
@@ -80,6 +105,7 @@ public:
     value_type
     operator [] (size_type offset) const
     {
+        AMLIB_SEQUENCE_COUNT(subscript);
         const auto nfst = fstSequ_.size();
         if(offset >= nfst) {
             return sndSequ_[offset-nfst];
@@ -92,6 +118,7 @@ public:
     combined_sequence&
     operator ++ ()
     {
+        AMLIB_SEQUENCE_COUNT(increment);
         if(!fstSequ_.empty()) {
             ++fstSequ_;
         }
@@ -104,6 +131,7 @@ public:
     combined_sequence&
     operator += (size_type offset)
     {
+        AMLIB_SEQUENCE_COUNT(advance);
         if(!fstSequ_.empty()) {
             const auto nfst = fstSequ_.size();
 
@@ -127,12 +155,19 @@ public:
         res += offset;
         return res;
     }
+    //-----------------------------------------------------
+    /// writes up to 'max' values to 'out' and advances past them
+    size_type
+    next_batch(value_type* out, size_type max) {
+        const auto n = am::next_batch(fstSequ_, out, max);
+        return n + am::next_batch(sndSequ_, out + n, max - n);
+    }
 
 
     //---------------------------------------------------------------
     value_type
     front() const {
-        return fstSequ_.emtpy() ? sndSequ_.front() : fstSequ_.front();
+        return fstSequ_.empty() ? sndSequ_.front() : fstSequ_.front();
     }
     //-----------------------------------------------------
     value_type
@@ -142,6 +177,7 @@ public:
     //-----------------------------------------------------
     size_type
     size() const {
+        AMLIB_SEQUENCE_COUNT(size);
         return fstSequ_.size() + sndSequ_.size();
     }
     //-----------------------------------------------------
@@ -164,6 +200,7 @@ public:
     //-----------------------------------------------------
     combined_sequence
     end() const {
+        AMLIB_SEQUENCE_COUNT(end);
         return combined_sequence{fstSequ_.end(), sndSequ_.end()};
     }
 
@@ -171,6 +208,7 @@ public:
     //---------------------------------------------------------------
     bool
     operator == (const combined_sequence& o) const {
+        AMLIB_SEQUENCE_COUNT(compare);
         return (fstSequ_ == o.fstSequ_) &&
                (sndSequ_ == o.sndSequ_);
     }
@@ -181,6 +219,15 @@ public:
     }
 
 
+    //---------------------------------------------------------------
+    template<class F>
+    friend void
+    for_each_segment(const combined_sequence& s, F&& f) {
+        for_each_segment(s.fstSequ_, f);
+        for_each_segment(s.sndSequ_, f);
+    }
+
+
 private:
     //---------------------------------------------------------------
     first_sequence_type fstSequ_;
@@ -194,6 +241,629 @@ private:
 
 
 
+
+/*************************************************************************//***
+ *
+ * @brief concatenation of 3 or more sequences stored in a std::tuple;
+ *        keeps track of the active segment so that operator* and ++ are
+ *        O(1); operator[] and += use a table of prefix sizes and
+ *        are O(log N) in the number of segments
+ *
+ *        Note: comparison only takes the position into account
+ *              (like iterators of the same range)
+ *
+ *****************************************************************************/
+template<class Sequence1, class Sequence2, class... Sequences>
+class combined_sequence :
+    private seq_stats::tracked<combined_sequence<Sequence1,Sequence2,Sequences...>>
+{
+    using tuple_type = std::tuple<Sequence1,Sequence2,Sequences...>;
+    static constexpr std::size_t count = 2 + sizeof...(Sequences);
+    using indices = std::make_index_sequence<count>;
+
+public:
+    //---------------------------------------------------------------
+    using iterator_category = std::input_iterator_tag;
+    //-----------------------------------------------------
+    using difference_type = std::common_type_t<
+        typename Sequence1::difference_type,
+        typename Sequence2::difference_type,
+        typename Sequences::difference_type...>;
+    //-----------------------------------------------------
+    using size_type = std::common_type_t<
+        typename Sequence1::size_type,
+        typename Sequence2::size_type,
+        typename Sequences::size_type...>;
+    //-----------------------------------------------------
+    using value_type = std::common_type_t<
+        typename Sequence1::value_type,
+        typename Sequence2::value_type,
+        typename Sequences::value_type...>;
+    //-----------------------------------------------------
+    using reference = const value_type&;
+    using pointer = value_type*;
+
+
+    //---------------------------------------------------------------
+    combined_sequence():
+        segs_{}, prefix_{}, pos_{0}, active_{0}
+    {}
+
+    //---------------------------------------------------------------
+    explicit
+    combined_sequence(Sequence1 s1, Sequence2 s2, Sequences... sn) :
+        segs_{std::move(s1), std::move(s2), std::move(sn)...},
+        prefix_{}, pos_{0}, active_{0}
+    {
+        init_prefix(indices{});
+        skip_exhausted();
+    }
+
+
+    //---------------------------------------------------------------
+    value_type
+    operator * () const {
+        return deref(indices{});
+    }
+    //-----------------------------------------------------
+    value_type
+    operator [] (size_type offset) const
+    {
+        AMLIB_SEQUENCE_COUNT(subscript);
+        const auto g = pos_ + offset;
+        if(g < prefix_[active_+1]) {
+            return subscript(active_, offset, indices{});
+        }
+        const auto k = segment_of(g);
+        return subscript(k, g - prefix_[k], indices{});
+    }
+
+
+    //---------------------------------------------------------------
+    combined_sequence&
+    operator ++ ()
+    {
+        AMLIB_SEQUENCE_COUNT(increment);
+        increment(indices{});
+        ++pos_;
+        skip_exhausted();
+        return *this;
+    }
+    //-----------------------------------------------------
+    combined_sequence&
+    operator += (size_type offset)
+    {
+        AMLIB_SEQUENCE_COUNT(advance);
+        const auto g = pos_ + offset;
+        if(g < prefix_[active_+1]) {
+            advance(active_, offset, indices{});
+            pos_ = g;
+        }
+        else if(g >= prefix_[count]) {
+            pos_ = prefix_[count];
+            active_ = count - 1;
+        }
+        else {
+            //segments after the active one are still at their beginning
+            active_ = segment_of(g);
+            advance(active_, g - prefix_[active_], indices{});
+            pos_ = g;
+        }
+        return *this;
+    }
+    //-----------------------------------------------------
+    combined_sequence
+    operator + (size_type offset) const {
+        auto res = *this;
+        res += offset;
+        return res;
+    }
+    //-----------------------------------------------------
+    /**
+     * @brief writes up to 'max' values to 'out' and advances past them;
+     *        one batch call per segment
+     */
+    size_type
+    next_batch(value_type* out, size_type max)
+    {
+        size_type n = 0;
+        while(n < max && !empty()) {
+            const auto m = batch(active_, out + n,
+                std::min(max - n, prefix_[active_+1] - pos_), indices{});
+            if(m < 1) break;
+            n += m;
+            pos_ += m;
+            skip_exhausted();
+        }
+        return n;
+    }
+
+
+    //---------------------------------------------------------------
+    static constexpr std::size_t
+    segments() noexcept {
+        return count;
+    }
+    //-----------------------------------------------------
+    std::size_t
+    active_segment() const noexcept {
+        return active_;
+    }
+    //-----------------------------------------------------
+    template<std::size_t i>
+    decltype(auto)
+    segment() const noexcept {
+        return std::get<i>(segs_);
+    }
+
+
+    //---------------------------------------------------------------
+    value_type
+    front() const {
+        return *(*this);
+    }
+    //-----------------------------------------------------
+    value_type
+    back() const {
+        return (*this)[size()-1];
+    }
+    //-----------------------------------------------------
+    size_type
+    size() const noexcept {
+        AMLIB_SEQUENCE_COUNT(size);
+        return prefix_[count] - pos_;
+    }
+    //-----------------------------------------------------
+    bool
+    empty() const noexcept {
+        return pos_ >= prefix_[count];
+    }
+    //-----------------------------------------------------
+    explicit operator
+    bool() const noexcept {
+        return !empty();
+    }
+
+
+    //---------------------------------------------------------------
+    const combined_sequence&
+    begin() const noexcept {
+        return *this;
+    }
+    //-----------------------------------------------------
+    combined_sequence
+    end() const {
+        AMLIB_SEQUENCE_COUNT(end);
+        auto res = *this;
+        res.pos_ = prefix_[count];
+        res.active_ = count - 1;
+        return res;
+    }
+
+
+    //---------------------------------------------------------------
+    bool
+    operator == (const combined_sequence& o) const noexcept {
+        AMLIB_SEQUENCE_COUNT(compare);
+        return (pos_ == o.pos_) && (prefix_ == o.prefix_);
+    }
+    //-----------------------------------------------------
+    bool
+    operator != (const combined_sequence& o) const noexcept {
+        return !(*this == o);
+    }
+
+
+    //---------------------------------------------------------------
+    template<class F>
+    friend void
+    for_each_segment(const combined_sequence& s, F&& f) {
+        if(!s.empty()) s.for_each_remaining_segment(f, indices{});
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    template<class F, std::size_t... Is>
+    void
+    for_each_remaining_segment(F& f, std::index_sequence<Is...>) const {
+        //segments after the active one are still at their beginning
+        using expand = int[];
+        (void)expand{0, ((Is >= active_
+            ? for_each_segment(std::get<Is>(segs_), f) : void()), 0)...};
+    }
+
+    //-----------------------------------------------------
+    template<std::size_t... Is>
+    void
+    init_prefix(std::index_sequence<Is...>) {
+        const size_type sizes[] {
+            size_type(seq_detail::remaining_size(std::get<Is>(segs_)))... };
+
+        prefix_[0] = 0;
+        for(std::size_t i = 0; i < count; ++i) {
+            prefix_[i+1] = prefix_[i] + sizes[i];
+        }
+    }
+
+    //-----------------------------------------------------
+    void
+    skip_exhausted() noexcept {
+        while((active_+1) < count && pos_ >= prefix_[active_+1]) {
+            ++active_;
+        }
+    }
+
+    //-----------------------------------------------------
+    /// @return index of segment that contains global position g
+    std::size_t
+    segment_of(size_type g) const noexcept {
+        return static_cast<std::size_t>(
+            std::upper_bound(prefix_.begin(), prefix_.end(), g)
+                - prefix_.begin()) - 1;
+    }
+
+
+    //---------------------------------------------------------------
+    // runtime dispatch on the active segment via function tables
+    //---------------------------------------------------------------
+    template<std::size_t i>
+    static value_type
+    deref_at(const tuple_type& t) {
+        return *std::get<i>(t);
+    }
+    //-----------------------------------------------------
+    template<std::size_t... Is>
+    value_type
+    deref(std::index_sequence<Is...>) const {
+        using fn_t = value_type(*)(const tuple_type&);
+        static constexpr fn_t fns[] { &deref_at<Is>... };
+        return fns[active_](segs_);
+    }
+
+    //-----------------------------------------------------
+    template<std::size_t i>
+    static value_type
+    subscript_at(const tuple_type& t, size_type offset) {
+        return std::get<i>(t)[offset];
+    }
+    //-----------------------------------------------------
+    template<std::size_t... Is>
+    value_type
+    subscript(std::size_t k, size_type offset,
+              std::index_sequence<Is...>) const
+    {
+        using fn_t = value_type(*)(const tuple_type&, size_type);
+        static constexpr fn_t fns[] { &subscript_at<Is>... };
+        return fns[k](segs_, offset);
+    }
+
+    //-----------------------------------------------------
+    template<std::size_t i>
+    static void
+    increment_at(tuple_type& t) {
+        ++std::get<i>(t);
+    }
+    //-----------------------------------------------------
+    template<std::size_t... Is>
+    void
+    increment(std::index_sequence<Is...>) {
+        using fn_t = void(*)(tuple_type&);
+        static constexpr fn_t fns[] { &increment_at<Is>... };
+        fns[active_](segs_);
+    }
+
+    //-----------------------------------------------------
+    template<std::size_t i>
+    static void
+    advance_at(tuple_type& t, size_type offset) {
+        std::get<i>(t) += offset;
+    }
+    //-----------------------------------------------------
+    template<std::size_t... Is>
+    void
+    advance(std::size_t k, size_type offset, std::index_sequence<Is...>) {
+        using fn_t = void(*)(tuple_type&, size_type);
+        static constexpr fn_t fns[] { &advance_at<Is>... };
+        fns[k](segs_, offset);
+    }
+
+
+    //-----------------------------------------------------
+    template<std::size_t i>
+    static size_type
+    batch_at(tuple_type& t, value_type* out, size_type max) {
+        return am::next_batch(std::get<i>(t), out, max);
+    }
+    //-----------------------------------------------------
+    template<std::size_t... Is>
+    size_type
+    batch(std::size_t k, value_type* out, size_type max,
+          std::index_sequence<Is...>)
+    {
+        using fn_t = size_type(*)(tuple_type&, value_type*, size_type);
+        static constexpr fn_t fns[] { &batch_at<Is>... };
+        return fns[k](segs_, out, max);
+    }
+
+
+    //---------------------------------------------------------------
+    tuple_type segs_;
+    std::array<size_type,count+1> prefix_;
+    size_type pos_;
+    std::size_t active_;
+};
+
+
+
+
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief concatenation of a runtime list of sequences of the same type
+ *
+ *        The list of (unmodified) segments and a table of prefix sizes
+ *        are immutable and shared between copies; only the active segment
+ *        is stored inline. operator* and ++ are O(1);
+ *        operator[] and += are O(log N) in the number of segments.
+ *
+ *        Note: comparison only takes the position into account
+ *              (like iterators of the same range)
+ *
+ *****************************************************************************/
+template<class Sequence>
+class dynamic_combined_sequence :
+    private seq_stats::tracked<dynamic_combined_sequence<Sequence>>
+{
+public:
+    //---------------------------------------------------------------
+    using sequence_type = Sequence;
+    //-----------------------------------------------------
+    using iterator_category = std::input_iterator_tag;
+    using difference_type = typename sequence_type::difference_type;
+    using size_type = typename sequence_type::size_type;
+    //-----------------------------------------------------
+    using value_type = typename sequence_type::value_type;
+    using reference = const value_type&;
+    using pointer = value_type*;
+
+
+    //---------------------------------------------------------------
+    explicit
+    dynamic_combined_sequence(std::vector<sequence_type> segments = {}) :
+        cur_{}, pos_{0}, active_{0}, params_{}
+    {
+        auto p = std::make_shared<params>();
+        p->prefix.reserve(segments.size() + 1);
+        p->prefix.push_back(0);
+        for(const auto& s : segments) {
+            p->prefix.push_back(p->prefix.back() +
+                                seq_detail::remaining_size(s));
+        }
+        p->segs = std::move(segments);
+        params_ = std::move(p);
+
+        if(!params_->segs.empty()) {
+            cur_ = params_->segs.front();
+            skip_exhausted();
+        }
+    }
+
+
+    //---------------------------------------------------------------
+    decltype(auto)
+    operator * () const {
+        return *cur_;
+    }
+    //-----------------------------------------------------
+    value_type
+    operator [] (size_type offset) const
+    {
+        AMLIB_SEQUENCE_COUNT(subscript);
+        const auto& prefix = params_->prefix;
+        const auto g = pos_ + offset;
+        //past the end (or no segments at all): no prefix entry to look up
+        if(g >= prefix.back() || g < prefix[active_+1]) return cur_[offset];
+
+        const auto k = segment_of(g);
+        return params_->segs[k][g - prefix[k]];
+    }
+
+
+    //---------------------------------------------------------------
+    dynamic_combined_sequence&
+    operator ++ ()
+    {
+        AMLIB_SEQUENCE_COUNT(increment);
+        ++cur_;
+        ++pos_;
+        skip_exhausted();
+        return *this;
+    }
+    //-----------------------------------------------------
+    dynamic_combined_sequence&
+    operator += (size_type offset)
+    {
+        AMLIB_SEQUENCE_COUNT(advance);
+        const auto& prefix = params_->prefix;
+        const auto g = pos_ + offset;
+        if(g >= prefix.back()) {
+            pos_ = prefix.back();
+        }
+        else if(g < prefix[active_+1]) {
+            cur_ += offset;
+            pos_ = g;
+        }
+        else {
+            active_ = segment_of(g);
+            cur_ = params_->segs[active_];
+            cur_ += g - prefix[active_];
+            pos_ = g;
+        }
+        return *this;
+    }
+    //-----------------------------------------------------
+    dynamic_combined_sequence
+    operator + (size_type offset) const {
+        auto res = *this;
+        res += offset;
+        return res;
+    }
+    //-----------------------------------------------------
+    /**
+     * @brief writes up to 'max' values to 'out' and advances past them;
+     *        one batch call per segment
+     */
+    size_type
+    next_batch(value_type* out, size_type max)
+    {
+        if(empty()) return 0;
+
+        const auto& prefix = params_->prefix;
+        size_type n = 0;
+        while(n < max && !empty()) {
+            const auto m = am::next_batch(cur_, out + n,
+                std::min(max - n, prefix[active_+1] - pos_));
+            if(m < 1) break;
+            n += m;
+            pos_ += m;
+            skip_exhausted();
+        }
+        return n;
+    }
+
+
+    //---------------------------------------------------------------
+    std::size_t
+    segments() const noexcept {
+        return params_->segs.size();
+    }
+    //-----------------------------------------------------
+    std::size_t
+    active_segment() const noexcept {
+        return active_;
+    }
+    //-----------------------------------------------------
+    const sequence_type&
+    segment(std::size_t i) const noexcept {
+        return params_->segs[i];
+    }
+
+
+    //---------------------------------------------------------------
+    value_type
+    front() const {
+        return *cur_;
+    }
+    //-----------------------------------------------------
+    value_type
+    back() const {
+        return (*this)[size()-1];
+    }
+    //-----------------------------------------------------
+    size_type
+    size() const noexcept {
+        AMLIB_SEQUENCE_COUNT(size);
+        return params_->prefix.back() - pos_;
+    }
+    //-----------------------------------------------------
+    bool
+    empty() const noexcept {
+        return pos_ >= params_->prefix.back();
+    }
+    //-----------------------------------------------------
+    explicit operator
+    bool() const noexcept {
+        return !empty();
+    }
+
+
+    //---------------------------------------------------------------
+    const dynamic_combined_sequence&
+    begin() const noexcept {
+        return *this;
+    }
+    //-----------------------------------------------------
+    dynamic_combined_sequence
+    end() const {
+        AMLIB_SEQUENCE_COUNT(end);
+        auto res = *this;
+        res.pos_ = params_->prefix.back();
+        return res;
+    }
+
+
+    //---------------------------------------------------------------
+    bool
+    operator == (const dynamic_combined_sequence& o) const noexcept {
+        AMLIB_SEQUENCE_COUNT(compare);
+        return (pos_ == o.pos_) && (params_ == o.params_);
+    }
+    //-----------------------------------------------------
+    bool
+    operator != (const dynamic_combined_sequence& o) const noexcept {
+        return !(*this == o);
+    }
+
+
+    //---------------------------------------------------------------
+    template<class F>
+    friend void
+    for_each_segment(const dynamic_combined_sequence& s, F&& f) {
+        if(s.empty()) return;
+        for_each_segment(s.cur_, f);
+        const auto& segs = s.params_->segs;
+        for(auto i = s.active_ + 1; i < segs.size(); ++i) {
+            for_each_segment(segs[i], f);
+        }
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    struct params {
+        std::vector<sequence_type> segs;
+        std::vector<size_type> prefix;
+    };
+
+    //---------------------------------------------------------------
+    void
+    skip_exhausted() {
+        const auto& prefix = params_->prefix;
+        const auto n = params_->segs.size();
+        if((active_+1) < n && pos_ >= prefix[active_+1]) {
+            do { ++active_; } while((active_+1) < n && pos_ >= prefix[active_+1]);
+            cur_ = params_->segs[active_];
+        }
+    }
+
+    //-----------------------------------------------------
+    std::size_t
+    segment_of(size_type g) const noexcept {
+        const auto& prefix = params_->prefix;
+        return static_cast<std::size_t>(
+            std::upper_bound(prefix.begin(), prefix.end(), g)
+                - prefix.begin()) - 1;
+    }
+
+
+    //---------------------------------------------------------------
+    sequence_type cur_;
+    size_type pos_;
+    std::size_t active_;
+    std::shared_ptr<const params> params_;
+};
+
+
+
+
+
+
+
+
 /*****************************************************************************
  *
  *
@@ -201,28 +871,56 @@ private:
  *
  *
  *****************************************************************************/
-template<class S1, class S2>
+template<class... Ss>
 inline decltype(auto)
-begin(const combined_sequence<S1,S2>& s) {
+begin(const combined_sequence<Ss...>& s) {
     return s.begin();
 }
 //-----------------------------------------------------
-template<class S1, class S2>
+template<class... Ss>
 inline decltype(auto)
-cbegin(const combined_sequence<S1,S2>& s) {
+cbegin(const combined_sequence<Ss...>& s) {
     return s.begin();
 }
 
 //-----------------------------------------------------
-template<class S1, class S2>
+template<class... Ss>
 inline decltype(auto)
-end(const combined_sequence<S1,S2>& s) {
+end(const combined_sequence<Ss...>& s) {
     return s.end();
 }
 //-----------------------------------------------------
-template<class S1, class S2>
+template<class... Ss>
 inline decltype(auto)
-cend(const combined_sequence<S1,S2>& s) {
+cend(const combined_sequence<Ss...>& s) {
+    return s.end();
+}
+
+
+
+//---------------------------------------------------------------
+template<class S>
+inline decltype(auto)
+begin(const dynamic_combined_sequence<S>& s) {
+    return s.begin();
+}
+//-----------------------------------------------------
+template<class S>
+inline decltype(auto)
+cbegin(const dynamic_combined_sequence<S>& s) {
+    return s.begin();
+}
+
+//-----------------------------------------------------
+template<class S>
+inline decltype(auto)
+end(const dynamic_combined_sequence<S>& s) {
+    return s.end();
+}
+//-----------------------------------------------------
+template<class S>
+inline decltype(auto)
+cend(const dynamic_combined_sequence<S>& s) {
     return s.end();
 }
 
@@ -238,8 +936,10 @@ cend(const combined_sequence<S1,S2>& s) {
  * 
  *
  *****************************************************************************/
-template<class S1, class S2> 
-//requires Sequence<S1> && Sequence<S2>
+template<class S1, class S2>
+#if AMLIB_SEQUENCE_CONCEPTS
+    requires am::Sequence<std::decay_t<S1>> && am::Sequence<std::decay_t<S2>>
+#endif
 inline constexpr auto
 make_combined_sequence(S1&& s1, S2&& s2)
 {
@@ -247,6 +947,34 @@ make_combined_sequence(S1&& s1, S2&& s2)
                 {std::forward<S1>(s1), std::forward<S2>(s2)};
 }
 
+//---------------------------------------------------------
+template<class S1, class S2, class S3, class... Sn>
+#if AMLIB_SEQUENCE_CONCEPTS
+    requires am::Sequence<std::decay_t<S1>> &&
+             am::Sequence<std::decay_t<S2>> &&
+             am::Sequence<std::decay_t<S3>> &&
+             (am::Sequence<std::decay_t<Sn>> && ...)
+#endif
+inline constexpr auto
+make_combined_sequence(S1&& s1, S2&& s2, S3&& s3, Sn&&... sn)
+{
+    return combined_sequence<std::decay_t<S1>,std::decay_t<S2>,
+                             std::decay_t<S3>,std::decay_t<Sn>...>
+                {std::forward<S1>(s1), std::forward<S2>(s2),
+                 std::forward<S3>(s3), std::forward<Sn>(sn)...};
+}
+
+//---------------------------------------------------------
+template<class S>
+#if AMLIB_SEQUENCE_CONCEPTS
+    requires am::Sequence<S>
+#endif
+inline auto
+make_combined_sequence(std::vector<S> segments)
+{
+    return dynamic_combined_sequence<S>{std::move(segments)};
+}
+
 
 } //namespace am
 
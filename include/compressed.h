@@ -0,0 +1,582 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AMLIB_NUMERIC_COMPRESSED_SEQUENCE_H_
+#define AMLIB_NUMERIC_COMPRESSED_SEQUENCE_H_
+
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "repeated.h"
+#include "stats.h"
+
+
+namespace am {
+
+
+/*************************************************************************//***
+ *
+ * @brief 'repeats' times the arithmetic progression
+ *        first, first + stride, ..., first + (length-1) * stride
+ *
+ *        arithmetic is done modulo 2^N (unsigned), so that runs can
+ *        span the whole value range of signed types without overflow
+ *
+ *        literal runs store 'length' values verbatim at offset 'literal'
+ *        of a separate value pool (repeats is always 1, first is the
+ *        first value); operator[] only decodes arithmetic runs
+ *
+ *****************************************************************************/
+template<class T>
+struct linear_run
+{
+    static_assert(std::is_integral<T>::value,
+                  "linear runs require integral value types");
+
+    using value_type = T;
+    using stride_type = std::make_unsigned_t<T>;
+    using size_type = std::size_t;
+
+    static constexpr size_type no_literal = size_type(-1);
+
+    value_type  first = value_type(0);
+    stride_type stride = stride_type(0);
+    size_type   length = 0;
+    size_type   repeats = 1;
+    size_type   literal = no_literal;
+
+    //---------------------------------------------------------------
+    size_type
+    size() const noexcept {
+        return length * repeats;
+    }
+    //-----------------------------------------------------
+    bool
+    is_literal() const noexcept {
+        return literal != no_literal;
+    }
+
+    //---------------------------------------------------------------
+    value_type
+    operator [] (size_type i) const noexcept {
+        return value_type(stride_type(first) + stride_type(i % length) * stride);
+    }
+
+    //---------------------------------------------------------------
+    bool
+    operator == (const linear_run& o) const noexcept {
+        return (first == o.first) && (stride == o.stride) &&
+               (length == o.length) && (repeats == o.repeats) &&
+               (literal == o.literal);
+    }
+    //-----------------------------------------------------
+    bool
+    operator != (const linear_run& o) const noexcept {
+        return !(*this == o);
+    }
+};
+
+
+
+
+template<class T>
+constexpr typename linear_run<T>::size_type linear_run<T>::no_literal;
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief runs and the value pool of their literal runs
+ *
+ *****************************************************************************/
+template<class T>
+struct run_list
+{
+    std::vector<linear_run<T>> runs;
+    std::vector<T> literals;
+};
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief greedily splits data[0,n) into maximal arithmetic progressions;
+ *        immediately repeated progressions are merged into one run
+ *        with repeats > 1
+ *
+ *        progressions that are too short to pay for their run (and for
+ *        splitting the surrounding literals) are stored as literal runs,
+ *        so the result is never much larger than the input:
+ *        at most n * sizeof(T) + 2 * (sizeof(linear_run<T>) + sizeof(size_t))
+ *        bytes including the prefix table of compressed_sequence
+ *
+ *        O(n); the decoded runs reproduce the input exactly
+ *
+ *****************************************************************************/
+template<class T>
+run_list<T>
+fit(const T* data, std::size_t n)
+{
+    using run_t = linear_run<T>;
+    using stride_t = typename run_t::stride_type;
+
+    //run + its prefix sum entry in compressed_sequence
+    constexpr std::size_t runBytes = sizeof(run_t) + sizeof(std::size_t);
+
+    auto res = run_list<T>{};
+    auto& runs = res.runs;
+    auto& lits = res.literals;
+
+    const auto append_literals = [&](std::size_t i, std::size_t m) {
+        if(runs.empty() || !runs.back().is_literal()) {
+            auto r = run_t{};
+            r.first = data[i];
+            r.literal = lits.size();
+            runs.push_back(r);
+        }
+        runs.back().length += m;
+        lits.insert(lits.end(), data + i, data + i + m);
+    };
+
+    for(std::size_t i = 0; i < n; ) {
+        auto r = run_t{};
+        r.first = data[i];
+        r.length = 1;
+        if(i + 1 < n) {
+            r.stride = stride_t(stride_t(data[i+1]) - stride_t(data[i]));
+            r.length = 2;
+            while(i + r.length < n &&
+                  stride_t(stride_t(data[i + r.length]) -
+                           stride_t(data[i + r.length - 1])) == r.stride)
+            {
+                ++r.length;
+            }
+        }
+        //immediate repetitions of the whole progression
+        for(auto j = i + r.length; j + r.length <= n; j += r.length) {
+            std::size_t k = 0;
+            while(k < r.length && data[j + k] == r[k]) ++k;
+            if(k < r.length) break;
+            ++r.repeats;
+        }
+
+        //a run may split a literal stretch, which costs another run
+        if(r.size() * sizeof(T) > 2 * runBytes) {
+            runs.push_back(r);
+            i += r.size();
+        }
+        else {
+            //the last value might start the next progression
+            const auto m = (r.length > 1) ? r.length - 1 : std::size_t(1);
+            append_literals(i, m);
+            i += m;
+        }
+    }
+
+    return res;
+}
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief random access sequence over a list of linear and literal runs
+ *        (e.g. a column compressed with 'fit');
+ *        O(log runs) random access, O(1) increment;
+ *        copies share the run table
+ *
+ *****************************************************************************/
+template<class T>
+class compressed_sequence :
+    private seq_stats::tracked<compressed_sequence<T>>
+{
+    using run_t = linear_run<T>;
+    using stride_t = typename run_t::stride_type;
+
+    struct run_table {
+        std::vector<run_t> runs;
+        std::vector<std::size_t> starts;  //runs.size()+1 prefix sums
+        std::vector<T> literals;          //values of literal runs
+    };
+
+public:
+    //---------------------------------------------------------------
+    using iterator_category = std::input_iterator_tag;
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = const value_type&;
+    using pointer = const value_type*;
+
+
+    //---------------------------------------------------------------
+    compressed_sequence():
+        compressed_sequence{run_list<T>{}}
+    {}
+
+    //-----------------------------------------------------
+    /// arithmetic runs only
+    explicit
+    compressed_sequence(std::vector<run_t> runs):
+        compressed_sequence{run_list<T>{std::move(runs), {}}}
+    {}
+
+    //-----------------------------------------------------
+    explicit
+    compressed_sequence(run_list<T> fitted):
+        table_{}, pos_{0}, end_{0}, run_{0}, off_{0}, cur_{}
+    {
+        auto t = std::make_shared<run_table>();
+        auto& runs = fitted.runs;
+        runs.erase(std::remove_if(runs.begin(), runs.end(),
+                       [](const run_t& r) { return r.size() < 1; }),
+                   runs.end());
+        t->runs = std::move(runs);
+        t->literals = std::move(fitted.literals);
+        t->literals.shrink_to_fit();
+        t->starts.reserve(t->runs.size() + 1);
+        t->starts.push_back(0);
+        for(const auto& r : t->runs) {
+            t->starts.push_back(t->starts.back() + r.size());
+        }
+        end_ = t->starts.back();
+        table_ = std::move(t);
+        if(end_ > 0) cur_ = table_->runs.front().first;
+    }
+
+
+    //---------------------------------------------------------------
+    reference
+    operator * () const noexcept {
+        return cur_;
+    }
+    //-----------------------------------------------------
+    pointer
+    operator -> () const noexcept {
+        return std::addressof(cur_);
+    }
+
+    //-----------------------------------------------------
+    value_type
+    operator [] (size_type offset) const noexcept {
+        AMLIB_SEQUENCE_COUNT(subscript);
+        const auto i = pos_ + offset;
+        const auto r = run_of(i);
+        return value_at(table_->runs[r], i - table_->starts[r]);
+    }
+
+
+    //---------------------------------------------------------------
+    compressed_sequence&
+    operator ++ () noexcept {
+        AMLIB_SEQUENCE_COUNT(increment);
+        ++pos_;
+        if(pos_ >= end_) return *this;
+
+        const auto& r = table_->runs[run_];
+        if(pos_ == table_->starts[run_+1]) {
+            ++run_;
+            off_ = 0;
+            cur_ = table_->runs[run_].first;
+        }
+        else if(++off_ == r.length) {
+            off_ = 0;
+            cur_ = r.first;
+        }
+        else if(r.is_literal()) {
+            cur_ = table_->literals[r.literal + off_];
+        }
+        else {
+            cur_ = value_type(stride_t(cur_) + r.stride);
+        }
+        return *this;
+    }
+    //-----------------------------------------------------
+    compressed_sequence&
+    operator += (size_type offset) noexcept {
+        AMLIB_SEQUENCE_COUNT(advance);
+        pos_ = (offset < (end_ - pos_)) ? pos_ + offset : end_;
+        seek();
+        return *this;
+    }
+    //-----------------------------------------------------
+    compressed_sequence
+    operator + (size_type offset) const noexcept {
+        auto res = *this;
+        res += offset;
+        return res;
+    }
+    //-----------------------------------------------------
+    /**
+     * @brief writes up to 'max' values to 'out' and advances past them;
+     *        one vectorizable index loop per (partial) period
+     */
+    size_type
+    next_batch(value_type* out, size_type max) noexcept
+    {
+        const auto n = std::min(size(), max);
+        const auto& runs = table_->runs;
+        auto r = run_;
+        auto off = off_;
+        for(size_type done = 0; done < n; ) {
+            const auto& run = runs[r];
+            const auto m = std::min(run.length - off, n - done);
+            if(run.is_literal()) {
+                std::copy_n(table_->literals.data() + run.literal + off, m,
+                            out + done);
+            }
+            else {
+                const auto first = stride_t(stride_t(run.first) +
+                                            stride_t(off) * run.stride);
+                for(size_type i = 0; i < m; ++i) {
+                    out[done + i] = value_type(first + stride_t(i) * run.stride);
+                }
+            }
+            done += m;
+            off += m;
+            if(off == run.length) {
+                off = 0;
+                if(pos_ + done == table_->starts[r+1]) ++r;
+            }
+        }
+        pos_ += n;
+        if(pos_ < end_) {
+            run_ = r;
+            off_ = off;
+            cur_ = value_at(runs[r], off);
+        }
+        return n;
+    }
+
+
+    //---------------------------------------------------------------
+    /**
+     * @brief decodes all remaining values to 'out';
+     *        each period is generated by a vectorizable index loop,
+     *        repetitions are copied with doubling memcpy,
+     *        literal runs are copied
+     */
+    template<class OutputIterator>
+    OutputIterator
+    copy_to(OutputIterator out) const
+    {
+        if(empty()) return out;
+
+        //rest of current run
+        const auto& cr = table_->runs[run_];
+        const auto rem = table_->starts[run_+1] - pos_;
+        for(size_type i = 0, o = pos_ - table_->starts[run_]; i < rem; ++i, ++o) {
+            *out = value_at(cr, o);
+            ++out;
+        }
+
+        for(auto r = run_ + 1; r < table_->runs.size(); ++r) {
+            const auto& run = table_->runs[r];
+            if(run.is_literal()) {
+                const auto lit = table_->literals.data() + run.literal;
+                out = std::copy(lit, lit + run.length, out);
+            } else {
+                out = decode(run, out);
+            }
+        }
+        return out;
+    }
+
+
+    //---------------------------------------------------------------
+    /// underlying runs (of the whole sequence, not just the remaining part)
+    const std::vector<run_t>&
+    runs() const noexcept {
+        return table_->runs;
+    }
+    //-----------------------------------------------------
+    /// value pool of the literal runs
+    const std::vector<value_type>&
+    literals() const noexcept {
+        return table_->literals;
+    }
+    //-----------------------------------------------------
+    /// size of the (shared) run table in bytes
+    std::size_t
+    table_bytes() const noexcept {
+        return table_->runs.size() * sizeof(run_t) +
+               table_->starts.size() * sizeof(std::size_t) +
+               table_->literals.size() * sizeof(value_type);
+    }
+
+
+    //---------------------------------------------------------------
+    bool
+    operator == (const compressed_sequence& o) const noexcept {
+        AMLIB_SEQUENCE_COUNT(compare);
+        return (table_ == o.table_) && (pos_ == o.pos_) && (end_ == o.end_);
+    }
+    //-----------------------------------------------------
+    bool
+    operator != (const compressed_sequence& o) const noexcept {
+        return !(*this == o);
+    }
+
+
+    //---------------------------------------------------------------
+    size_type
+    size() const noexcept {
+        AMLIB_SEQUENCE_COUNT(size);
+        return end_ - pos_;
+    }
+    //-----------------------------------------------------
+    bool
+    empty() const noexcept {
+        return pos_ >= end_;
+    }
+
+
+    //---------------------------------------------------------------
+    const compressed_sequence&
+    begin() const noexcept {
+        return *this;
+    }
+    //-----------------------------------------------------
+    compressed_sequence
+    end() const noexcept {
+        AMLIB_SEQUENCE_COUNT(end);
+        return *this + size();
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    size_type
+    run_of(size_type i) const noexcept {
+        const auto& s = table_->starts;
+        return size_type(std::upper_bound(s.begin(), s.end(), i) - s.begin()) - 1;
+    }
+
+    //---------------------------------------------------------------
+    void
+    seek() noexcept {
+        if(pos_ >= end_) return;
+        run_ = run_of(pos_);
+        const auto& r = table_->runs[run_];
+        off_ = (pos_ - table_->starts[run_]) % r.length;
+        cur_ = value_at(r, off_);
+    }
+
+    //---------------------------------------------------------------
+    value_type
+    value_at(const run_t& r, size_type i) const noexcept {
+        return r.is_literal() ? table_->literals[r.literal + i] : r[i];
+    }
+
+    //---------------------------------------------------------------
+    static value_type*
+    decode(const run_t& r, value_type* out)
+    {
+        const auto first = stride_t(r.first);
+        for(size_type i = 0; i < r.length; ++i) {
+            out[i] = value_type(first + stride_t(i) * r.stride);
+        }
+        return seq_detail::replicate(static_cast<const value_type*>(out),
+                                     r.length, r.repeats - 1,
+                                     out + r.length);
+    }
+    //-----------------------------------------------------
+    template<class OutputIterator>
+    static OutputIterator
+    decode(const run_t& r, OutputIterator out)
+    {
+        for(size_type k = 0; k < r.repeats; ++k) {
+            auto x = r.first;
+            for(size_type i = 0; i < r.length; ++i, ++out) {
+                *out = x;
+                x = value_type(stride_t(x) + r.stride);
+            }
+        }
+        return out;
+    }
+
+
+    //---------------------------------------------------------------
+    std::shared_ptr<const run_table> table_;
+    size_type pos_;
+    size_type end_;
+    size_type run_;
+    size_type off_;
+    value_type cur_;
+};
+
+
+
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+template<class T>
+inline decltype(auto)
+begin(const compressed_sequence<T>& s) noexcept
+{
+    return s.begin();
+}
+
+//---------------------------------------------------------
+template<class T>
+inline decltype(auto)
+cbegin(const compressed_sequence<T>& s) noexcept
+{
+    return s.begin();
+}
+
+//---------------------------------------------------------
+template<class T>
+inline decltype(auto)
+end(const compressed_sequence<T>& s) noexcept
+{
+    return s.end();
+}
+
+//---------------------------------------------------------
+template<class T>
+inline decltype(auto)
+cend(const compressed_sequence<T>& s) noexcept
+{
+    return s.end();
+}
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief fits data[0,n) with linear and literal runs and returns them
+ *        as a random access sequence
+ *
+ *****************************************************************************/
+template<class T>
+inline compressed_sequence<T>
+compress(const T* data, std::size_t n)
+{
+    return compressed_sequence<T>{fit(data, n)};
+}
+
+
+}  // namespace am
+
+
+#endif
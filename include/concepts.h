@@ -0,0 +1,80 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AMLIB_NUMERIC_SEQUENCE_CONCEPTS_H_
+#define AMLIB_NUMERIC_SEQUENCE_CONCEPTS_H_
+
+
+/*****************************************************************************
+ *
+ * AMLIB_SEQUENCE_CONCEPTS is 1 if the compiler supports C++20 concepts;
+ * the sequence concepts below and constrained factories are only
+ * available in that case
+ *
+ *****************************************************************************/
+#if defined(__cpp_concepts) && (__cpp_concepts >= 201907L) && \
+    defined(__has_include)
+#  if __has_include(<concepts>)
+#    define AMLIB_SEQUENCE_CONCEPTS 1
+#  endif
+#endif
+
+#ifndef AMLIB_SEQUENCE_CONCEPTS
+#  define AMLIB_SEQUENCE_CONCEPTS 0
+#endif
+
+
+#if AMLIB_SEQUENCE_CONCEPTS
+
+#include <concepts>
+#include <cstddef>
+
+
+namespace am {
+
+
+/*************************************************************************//***
+ *
+ * @brief minimum common interface of all sequence generators
+ *
+ *****************************************************************************/
+template<class S>
+concept Sequence = std::copy_constructible<S> &&
+    requires(S s, const S& cs) {
+        typename S::value_type;
+        *cs;
+        { ++s } -> std::same_as<S&>;
+        { cs.empty() } -> std::convertible_to<bool>;
+    };
+
+
+//-------------------------------------------------------------------
+template<class S>
+concept SizedSequence = Sequence<S> &&
+    requires(const S& cs) {
+        { cs.size() } -> std::convertible_to<std::size_t>;
+    };
+
+
+//-------------------------------------------------------------------
+template<class S>
+concept RandomAccessSequence = SizedSequence<S> &&
+    requires(S s, const S& cs, typename S::size_type n) {
+        cs[n];
+        { s += n } -> std::same_as<S&>;
+    };
+
+
+}  // namespace am
+
+#endif
+
+
+#endif
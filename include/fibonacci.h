@@ -12,11 +12,14 @@
 #define AMLIB_NUMERIC_FIBONACCI_SEQUENCE_H_
 
 
+#include <algorithm>
 #include <iterator>
 #include <limits>
 #include <cstdint>
 #include <type_traits>
 
+#include "stats.h"
+
 
 namespace am {
 
@@ -27,7 +30,8 @@ namespace am {
  *
  *****************************************************************************/
 template<class T = std::uint_least64_t>
-class fibonacci_sequence
+class fibonacci_sequence :
+    private seq_stats::tracked<fibonacci_sequence<T>>
 {
 public:
     //---------------------------------------------------------------
@@ -63,6 +67,7 @@ public:
     value_type
     operator [] (size_type offset) const
     {
+        AMLIB_SEQUENCE_COUNT(subscript);
         auto c = cur_;
         auto p = prev_;
 
@@ -79,6 +84,7 @@ public:
     //---------------------------------------------------------------
     fibonacci_sequence&
     operator ++ () {
+        AMLIB_SEQUENCE_COUNT(increment);
         const auto oldPrev = prev_;
         prev_ = cur_;
         cur_ += oldPrev;
@@ -89,6 +95,7 @@ public:
     fibonacci_sequence&
     operator += (size_type offset)
     {
+        AMLIB_SEQUENCE_COUNT(advance);
         for(; offset > 0 ; --offset) {
             ++(*this);
         }
@@ -102,6 +109,24 @@ public:
         res += offset;
         return res;
     }
+    //-----------------------------------------------------
+    /// writes up to 'max' values to 'out' and advances past them
+    size_type
+    next_batch(value_type* out, size_type max) {
+        const auto n = empty() ? size_type(0) : std::min(size(), max);
+        auto c = cur_;
+        auto p = prev_;
+        for(size_type i = 0; i < n; ++i) {
+            out[i] = c;
+            const auto oldc = c;
+            c += p;
+            p = oldc;
+        }
+        cur_ = c;
+        prev_ = p;
+        n_ += n;
+        return n;
+    }
 
 
     //---------------------------------------------------------------
@@ -119,7 +144,8 @@ public:
     //-----------------------------------------------------
     size_type
     size() const noexcept {
-        return maxN_;
+        AMLIB_SEQUENCE_COUNT(size);
+        return maxN_ - n_;
     }
     //-----------------------------------------------------
     bool
@@ -141,6 +167,7 @@ public:
     //-----------------------------------------------------
     fibonacci_sequence
     end() const {
+        AMLIB_SEQUENCE_COUNT(end);
         return fibonacci_sequence{nullptr, maxN_};
     }
 
@@ -148,6 +175,7 @@ public:
     //---------------------------------------------------------------
     bool
     operator == (const fibonacci_sequence& o) const noexcept {
+        AMLIB_SEQUENCE_COUNT(compare);
         return (n_ == o.n_) && (maxN_ == o.maxN_);
     }
     //-----------------------------------------------------
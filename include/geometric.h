@@ -11,12 +11,14 @@
 #ifndef AMLIB_NUMERIC_GEOEMETRIC_SEQUENCE_H_
 #define AMLIB_NUMERIC_GEOEMETRIC_SEQUENCE_H_
 
+#include <algorithm>
 #include <cmath>
 #include <iterator>
 #include <type_traits>
 #include <limits>
 
 #include "num_equality.h"
+#include "stats.h"
 
 
 namespace am {
@@ -28,8 +30,9 @@ namespace am {
  *        v(n) = scale * ratio^n,  for scale < 1, n with v(n) >= bound
  *
  *****************************************************************************/
-template<class T>
-class geometric_sequence
+template<class T, class Equality = default_equality<T>>
+class geometric_sequence :
+    private seq_stats::tracked<geometric_sequence<T,Equality>>
 {
 public:
     //---------------------------------------------------------------
@@ -67,6 +70,8 @@ public:
     //-----------------------------------------------------
     value_type
     operator [] (size_type offset) const {
+       AMLIB_SEQUENCE_COUNT(subscript);
+       AMLIB_SEQUENCE_COUNT(transcendental);
        using std::pow;
        return cur_ * pow(ratio_,offset);
     }
@@ -75,12 +80,15 @@ public:
     //---------------------------------------------------------------
     geometric_sequence&
     operator ++ () {
+        AMLIB_SEQUENCE_COUNT(increment);
         cur_ *= ratio_;
         return *this;
     }
     //-----------------------------------------------------
     geometric_sequence&
     operator += (size_type offset) {
+        AMLIB_SEQUENCE_COUNT(advance);
+        AMLIB_SEQUENCE_COUNT(transcendental);
         using std::pow;
         cur_ *= pow(ratio_,offset);
         return *this;
@@ -92,6 +100,22 @@ public:
         res += offset;
         return res;
     }
+    //-----------------------------------------------------
+    /**
+     * @brief writes up to 'max' values to 'out' and advances past them;
+     *        repeated multiplication like ++ (no pow)
+     */
+    size_type
+    next_batch(value_type* out, size_type max) {
+        const auto n = empty() ? size_type(0) : std::min(size(), max);
+        auto c = cur_;
+        for(size_type i = 0; i < n; ++i) {
+            out[i] = c;
+            c *= ratio_;
+        }
+        cur_ = c;
+        return n;
+    }
 
 
     //---------------------------------------------------------------
@@ -114,6 +138,8 @@ public:
     //-----------------------------------------------------
     size_type
     size() const {
+        AMLIB_SEQUENCE_COUNT(size);
+        AMLIB_SEQUENCE_COUNT(transcendental);
         using std::log;
 
         return (1 + static_cast<size_type>(
@@ -142,6 +168,7 @@ public:
     //-----------------------------------------------------
     geometric_sequence
     end() const {
+        AMLIB_SEQUENCE_COUNT(end);
         return geometric_sequence{(*this)[size()], ratio_, bound_};
     }
 
@@ -160,10 +187,11 @@ public:
     //---------------------------------------------------------------
     bool
     operator == (const geometric_sequence& o) const noexcept {
+        AMLIB_SEQUENCE_COUNT(compare);
         return
-            seq_detail::approx_equal(cur_, o.cur_) &&
-            seq_detail::approx_equal(ratio_, o.ratio_) &&
-            seq_detail::approx_equal(bound_, o.bound_);
+            Equality::equal(cur_, o.cur_) &&
+            Equality::equal(ratio_, o.ratio_) &&
+            Equality::equal(bound_, o.bound_);
     }
     //-----------------------------------------------------
     bool
@@ -186,28 +214,28 @@ private:
  *
  *
  *****************************************************************************/
-template<class T>
+template<class T, class E>
 inline decltype(auto)
-begin(const geometric_sequence<T>& s) {
+begin(const geometric_sequence<T,E>& s) {
     return s.begin();
 }
 //-----------------------------------------------------
-template<class T>
+template<class T, class E>
 inline decltype(auto)
-cbegin(const geometric_sequence<T>& s) {
+cbegin(const geometric_sequence<T,E>& s) {
     return s.begin();
 }
 
 //-----------------------------------------------------
-template<class T>
+template<class T, class E>
 inline decltype(auto)
-end(const geometric_sequence<T>& s) {
+end(const geometric_sequence<T,E>& s) {
     return s.end();
 }
 //-----------------------------------------------------
-template<class T>
+template<class T, class E>
 inline decltype(auto)
-cend(const geometric_sequence<T>& s) {
+cend(const geometric_sequence<T,E>& s) {
     return s.end();
 }
 
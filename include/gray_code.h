@@ -0,0 +1,318 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AMLIB_NUMERIC_GRAY_CODE_SEQUENCE_H_
+#define AMLIB_NUMERIC_GRAY_CODE_SEQUENCE_H_
+
+
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+#include "stats.h"
+
+
+namespace am {
+
+
+namespace seq_detail {
+
+
+//-------------------------------------------------------------------
+/// number of trailing zero bits; x must not be 0
+inline int
+trailing_zeros(std::uint64_t x) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#else
+    int n = 0;
+    for(; !(x & 1); x >>= 1) ++n;
+    return n;
+#endif
+}
+
+
+//-------------------------------------------------------------------
+/// reflected binary Gray code of n
+template<class UInt>
+inline constexpr UInt
+gray_code(UInt n) noexcept
+{
+    return UInt(n ^ (n >> 1));
+}
+
+//-------------------------------------------------------------------
+/// inverse of gray_code (prefix XOR, log2(bits) steps)
+template<class UInt>
+inline constexpr UInt
+gray_code_index(UInt g) noexcept
+{
+    for(int s = 1; s < std::numeric_limits<UInt>::digits; s <<= 1) {
+        g = UInt(g ^ (g >> s));
+    }
+    return g;
+}
+
+
+}  // namespace seq_detail
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief reflected binary Gray codes g(0), g(1), ... with g(i) = i ^ (i>>1)
+ *
+ *        consecutive codes differ in exactly one bit; ++ is one ctz and
+ *        one XOR and changed_bit() reports the flipped bit, so consumers
+ *        can update dependent state in O(1)
+ *
+ *        [] is O(1), index_of (the inverse) is a prefix XOR
+ *
+ *****************************************************************************/
+template<class UInt = std::uint64_t>
+class gray_code_sequence :
+    private seq_stats::tracked<gray_code_sequence<UInt>>
+{
+    static_assert(std::is_integral<UInt>::value && std::is_unsigned<UInt>::value,
+                  "gray_code_sequence requires an unsigned integer type");
+    static_assert(std::numeric_limits<UInt>::digits <= 64,
+                  "gray_code_sequence supports at most 64 bit codes");
+
+public:
+    //---------------------------------------------------------------
+    using iterator_category = std::input_iterator_tag;
+    using value_type = UInt;
+    using reference = const value_type&;
+    using pointer = const value_type*;
+    using size_type = std::uint64_t;
+    using difference_type = std::int64_t;
+
+    static constexpr int bits = std::numeric_limits<UInt>::digits;
+
+
+    //---------------------------------------------------------------
+    /**
+     * @param count number of codes; defaults to all codes of UInt
+     *        (2^64-1 for 64 bit codes)
+     */
+    constexpr explicit
+    gray_code_sequence(size_type count = full_count()) noexcept :
+        idx_{0}, end_{count}, code_{0}, changed_{-1}
+    {}
+
+
+    //---------------------------------------------------------------
+    reference
+    operator * () const noexcept {
+        return code_;
+    }
+    //-----------------------------------------------------
+    pointer
+    operator -> () const noexcept {
+        return std::addressof(code_);
+    }
+    //-----------------------------------------------------
+    value_type
+    operator [] (size_type offset) const noexcept {
+        AMLIB_SEQUENCE_COUNT(subscript);
+        return seq_detail::gray_code(value_type(idx_ + offset));
+    }
+
+
+    //---------------------------------------------------------------
+    gray_code_sequence&
+    operator ++ () noexcept {
+        AMLIB_SEQUENCE_COUNT(increment);
+        ++idx_;
+        changed_ = seq_detail::trailing_zeros(idx_);
+        code_ ^= value_type(value_type(1) << changed_);
+        return *this;
+    }
+    //-----------------------------------------------------
+    gray_code_sequence&
+    operator += (size_type offset) noexcept {
+        AMLIB_SEQUENCE_COUNT(advance);
+        idx_ = (offset < (end_ - idx_)) ? (idx_ + offset) : end_;
+        code_ = seq_detail::gray_code(value_type(idx_));
+        changed_ = (idx_ > 0) ? seq_detail::trailing_zeros(idx_) : -1;
+        return *this;
+    }
+    //-----------------------------------------------------
+    gray_code_sequence
+    operator + (size_type offset) const noexcept {
+        auto res = *this;
+        res += offset;
+        return res;
+    }
+    //-----------------------------------------------------
+    /**
+     * @brief writes up to 'max' codes to 'out' and advances past them;
+     *        closed form per code, vectorized by the compiler
+     */
+    size_type
+    next_batch(value_type* out, size_type max) noexcept {
+        const auto n = (max < size()) ? max : size();
+        const auto base = idx_;
+        for(size_type i = 0; i < n; ++i) {
+            out[i] = seq_detail::gray_code(value_type(base + i));
+        }
+        *this += n;
+        return n;
+    }
+
+
+    //---------------------------------------------------------------
+    /**
+     * @brief bit in which the current code differs from its predecessor;
+     *        -1 for the first code
+     */
+    int
+    changed_bit() const noexcept {
+        return changed_;
+    }
+    //-----------------------------------------------------
+    /// absolute index of the current code
+    size_type
+    index() const noexcept {
+        return idx_;
+    }
+    //-----------------------------------------------------
+    /// index of Gray code g
+    static value_type
+    index_of(value_type g) noexcept {
+        return seq_detail::gray_code_index(g);
+    }
+
+
+    //---------------------------------------------------------------
+    bool
+    operator == (const gray_code_sequence& o) const noexcept {
+        AMLIB_SEQUENCE_COUNT(compare);
+        return (idx_ == o.idx_) && (end_ == o.end_);
+    }
+    //-----------------------------------------------------
+    bool
+    operator != (const gray_code_sequence& o) const noexcept {
+        return !(*this == o);
+    }
+
+
+    //---------------------------------------------------------------
+    size_type
+    size() const noexcept {
+        AMLIB_SEQUENCE_COUNT(size);
+        return end_ - idx_;
+    }
+    //-----------------------------------------------------
+    bool
+    empty() const noexcept {
+        return idx_ >= end_;
+    }
+
+
+    //---------------------------------------------------------------
+    const gray_code_sequence&
+    begin() const noexcept {
+        return *this;
+    }
+    //-----------------------------------------------------
+    gray_code_sequence
+    end() const noexcept {
+        AMLIB_SEQUENCE_COUNT(end);
+        auto res = *this;
+        res.idx_ = end_;
+        return res;
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    static constexpr size_type
+    full_count() noexcept {
+        return (bits < 64) ? (size_type(1) << (bits % 64))
+                           : std::numeric_limits<size_type>::max();
+    }
+
+
+    //---------------------------------------------------------------
+    size_type idx_;
+    size_type end_;
+    value_type code_;
+    int changed_;
+};
+
+
+
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+template<class UInt>
+inline decltype(auto)
+begin(const gray_code_sequence<UInt>& s) noexcept
+{
+    return s.begin();
+}
+
+//---------------------------------------------------------
+template<class UInt>
+inline decltype(auto)
+cbegin(const gray_code_sequence<UInt>& s) noexcept
+{
+    return s.begin();
+}
+
+//---------------------------------------------------------
+template<class UInt>
+inline decltype(auto)
+end(const gray_code_sequence<UInt>& s) noexcept
+{
+    return s.end();
+}
+
+//---------------------------------------------------------
+template<class UInt>
+inline decltype(auto)
+cend(const gray_code_sequence<UInt>& s) noexcept
+{
+    return s.end();
+}
+
+
+
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+/// all 2^bits codes of 'bits' bit width;
+/// 'bits' is clamped to the width of UInt
+template<class UInt = std::uint64_t>
+inline constexpr auto
+make_gray_code_sequence(unsigned bits)
+{
+    constexpr auto digits = unsigned(gray_code_sequence<UInt>::bits);
+    if(bits > digits) bits = digits;
+    return gray_code_sequence<UInt>{
+        (bits < 64) ? (std::uint64_t(1) << bits)
+                    : std::numeric_limits<std::uint64_t>::max() };
+}
+
+
+}  // namespace am
+
+
+#endif
@@ -1,8 +1,11 @@
 #ifndef AMLIB_SEQUENCE_INTERLEAVED_BITS_H_
 #define AMLIB_SEQUENCE_INTERLEAVED_BITS_H_
 
+#include <algorithm>
 #include <cstdint>
 
+#include "stats.h"
+
 
 namespace am {
 
@@ -12,7 +15,8 @@ namespace am {
  * @brief
  *
  *****************************************************************************/
-class offset_interleaved_bit_sequence
+class offset_interleaved_bit_sequence :
+    private seq_stats::tracked<offset_interleaved_bit_sequence>
 {
 public:
     //---------------------------------------------------------------
@@ -45,8 +49,9 @@ public:
 
 
     //---------------------------------------------------------------
-    constexpr size_type
+    size_type
     size() const noexcept {
+        AMLIB_SEQUENCE_COUNT(size);
         return size_;
     }
 
@@ -108,6 +113,7 @@ public:
     //-----------------------------------------------------
     offset_interleaved_bit_sequence&
     operator ++ () noexcept {
+        AMLIB_SEQUENCE_COUNT(increment);
         if(!empty()) {
             --size_;
             if(size_ < next_) {
@@ -120,6 +126,7 @@ public:
     //-----------------------------------------------------
     offset_interleaved_bit_sequence&
     operator += (size_type offset) noexcept {
+        AMLIB_SEQUENCE_COUNT(advance);
         const auto d = next_after();
         size_ -= offset;
         if(offset > d) {
@@ -137,8 +144,30 @@ public:
     }
 
     //-----------------------------------------------------
-    constexpr bool
+    /**
+     * @brief writes up to 'max' values to 'out' and advances past them;
+     *        one fill with 'false' and one strided pass over the trues
+     */
+    size_type
+    next_batch(value_type* out, size_type max) noexcept {
+        const auto n = (max < size_) ? max : size_;
+        std::fill_n(out, n, false);
+        for(auto i = next_after(); i < n; i += interleave_) {
+            out[i] = true;
+        }
+        if(n < size_) {
+            *this += n;
+        } else {
+            next_ = 0;
+            size_ = 0;
+        }
+        return n;
+    }
+
+    //-----------------------------------------------------
+    bool
     operator [] (size_type offset) const noexcept {
+        AMLIB_SEQUENCE_COUNT(subscript);
         return (offset >= size_ || offset < next_after())
                ? false
                : !((size_ - offset - 1) % interleave_);
@@ -162,28 +191,26 @@ public:
         return *this;
     }
     //-----------------------------------------------------
-    constexpr offset_interleaved_bit_sequence
+    offset_interleaved_bit_sequence
     end() const noexcept {
+        AMLIB_SEQUENCE_COUNT(end);
         return offset_interleaved_bit_sequence
                    {size_type(0), size_type(0), interleave_};
     }
 
 
     //---------------------------------------------------------------
-    inline friend bool
-    operator == (const offset_interleaved_bit_sequence& a,
-                 const offset_interleaved_bit_sequence& b)
-    {
-        return ((a.next_ == b.next_) &&
-                (a.size_ == b.size_) &&
-                (a.interleave_ == b.interleave_));
-    }
-    //-----------------------------------------------------
-    inline friend bool
-    operator != (const offset_interleaved_bit_sequence& a,
-                 const offset_interleaved_bit_sequence& b)
-    {
-        return !(a == b);
+    bool
+    operator == (const offset_interleaved_bit_sequence& o) const noexcept {
+        AMLIB_SEQUENCE_COUNT(compare);
+        return ((next_ == o.next_) &&
+                (size_ == o.size_) &&
+                (interleave_ == o.interleave_));
+    }
+    //-----------------------------------------------------
+    bool
+    operator != (const offset_interleaved_bit_sequence& o) const noexcept {
+        return !(*this == o);
     }
 
 
@@ -12,12 +12,14 @@
 #define AMLIB_NUMERIC_LINEAR_SEQUENCE_H_
 
 
+#include <algorithm>
 #include <cassert>
 #include <iterator>
 #include <limits>
 #include <type_traits>
 
 #include "num_equality.h"
+#include "stats.h"
 
 
 namespace am {
@@ -28,8 +30,9 @@ namespace am {
  *
  *
  *****************************************************************************/
-template<class T>
-class ascending_sequence
+template<class T, class Equality = default_equality<T>>
+class ascending_sequence :
+    private seq_stats::tracked<ascending_sequence<T,Equality>>
 {
 public:
     //---------------------------------------------------------------
@@ -65,6 +68,7 @@ public:
     //-----------------------------------------------------
     value_type
     operator [] (size_type offset) const {
+        AMLIB_SEQUENCE_COUNT(subscript);
        return cur_ + offset;
     }
 
@@ -72,12 +76,14 @@ public:
     //---------------------------------------------------------------
     ascending_sequence&
     operator ++ () {
+        AMLIB_SEQUENCE_COUNT(increment);
         ++cur_;
         return *this;
     }
     //-----------------------------------------------------
     ascending_sequence&
     operator += (size_type offset) {
+        AMLIB_SEQUENCE_COUNT(advance);
         cur_ += offset;
         return *this;
     }
@@ -88,6 +94,18 @@ public:
         res += offset;
         return res;
     }
+    //-----------------------------------------------------
+    /// writes up to 'max' values to 'out' and advances past them
+    size_type
+    next_batch(value_type* out, size_type max) {
+        const auto n = std::min(size(), max);
+        const auto c = cur_;
+        for(size_type i = 0; i < n; ++i) {
+            out[i] = c + value_type(i);
+        }
+        *this += n;
+        return n;
+    }
 
 
     //---------------------------------------------------------------
@@ -104,7 +122,9 @@ public:
     //---------------------------------------------------------------
     size_type
     size() const {
-        return (1 + static_cast<size_type>(0.5 + (uBound_ - cur_)));
+        AMLIB_SEQUENCE_COUNT(size);
+        return empty() ? size_type(0)
+                       : (1 + static_cast<size_type>(0.5 + (uBound_ - cur_)));
     }
     //-----------------------------------------------------
     bool
@@ -126,6 +146,7 @@ public:
     //-----------------------------------------------------
     ascending_sequence
     end() const {
+        AMLIB_SEQUENCE_COUNT(end);
         return ascending_sequence{(*this)[size()], uBound_};
     }
 
@@ -140,8 +161,9 @@ public:
     //---------------------------------------------------------------
     bool
     operator == (const ascending_sequence& o) const noexcept {
-        return seq_detail::approx_equal(cur_, o.cur_) &&
-               seq_detail::approx_equal(uBound_, o.uBound_);
+        AMLIB_SEQUENCE_COUNT(compare);
+        return Equality::equal(cur_, o.cur_) &&
+               Equality::equal(uBound_, o.uBound_);
     }
     //-----------------------------------------------------
     bool
@@ -168,8 +190,9 @@ private:
  *
  *
  *****************************************************************************/
-template<class T>
-class descending_sequence
+template<class T, class Equality = default_equality<T>>
+class descending_sequence :
+    private seq_stats::tracked<descending_sequence<T,Equality>>
 {
 public:
     //---------------------------------------------------------------
@@ -205,6 +228,7 @@ public:
     //-----------------------------------------------------
     value_type
     operator [] (size_type offset) const {
+        AMLIB_SEQUENCE_COUNT(subscript);
        return cur_ - offset;
     }
 
@@ -212,15 +236,36 @@ public:
     //---------------------------------------------------------------
     descending_sequence&
     operator ++ () {
+        AMLIB_SEQUENCE_COUNT(increment);
         --cur_;
         return *this;
     }
     //-----------------------------------------------------
     descending_sequence&
     operator += (size_type offset) {
+        AMLIB_SEQUENCE_COUNT(advance);
         cur_ -= offset;
         return *this;
     }
+    //-----------------------------------------------------
+    descending_sequence
+    operator + (size_type offset) const {
+        auto res = *this;
+        res += offset;
+        return res;
+    }
+    //-----------------------------------------------------
+    /// writes up to 'max' values to 'out' and advances past them
+    size_type
+    next_batch(value_type* out, size_type max) {
+        const auto n = std::min(size(), max);
+        const auto c = cur_;
+        for(size_type i = 0; i < n; ++i) {
+            out[i] = c - value_type(i);
+        }
+        *this += n;
+        return n;
+    }
 
 
     //---------------------------------------------------------------
@@ -237,7 +282,9 @@ public:
     //---------------------------------------------------------------
     size_type
     size() const {
-        return (1 + static_cast<size_type>(0.5 + (cur_ - lBound_)));
+        AMLIB_SEQUENCE_COUNT(size);
+        return empty() ? size_type(0)
+                       : (1 + static_cast<size_type>(0.5 + (cur_ - lBound_)));
     }
     //-----------------------------------------------------
     bool
@@ -259,6 +306,7 @@ public:
     //-----------------------------------------------------
     descending_sequence
     end() const {
+        AMLIB_SEQUENCE_COUNT(end);
         return descending_sequence{(*this)[size()], lBound_};
     }
 
@@ -273,8 +321,9 @@ public:
     //---------------------------------------------------------------
     bool
     operator == (const descending_sequence& o) const noexcept {
-        return seq_detail::approx_equal(cur_, o.cur_) && 
-               seq_detail::approx_equal(lBound_, o.lBound_);
+        AMLIB_SEQUENCE_COUNT(compare);
+        return Equality::equal(cur_, o.cur_) &&
+               Equality::equal(lBound_, o.lBound_);
     }
     //-----------------------------------------------------
     bool
@@ -301,8 +350,9 @@ private:
  *
  *
  *****************************************************************************/
-template<class T>
-class linear_sequence
+template<class T, class Equality = default_equality<T>>
+class linear_sequence :
+    private seq_stats::tracked<linear_sequence<T,Equality>>
 {
 public:
     //---------------------------------------------------------------
@@ -340,6 +390,7 @@ public:
     //-----------------------------------------------------
     value_type
     operator [] (size_type offset) const {
+        AMLIB_SEQUENCE_COUNT(subscript);
        return cur_ + (stride_ * offset);
     }
 
@@ -347,15 +398,37 @@ public:
     //---------------------------------------------------------------
     linear_sequence&
     operator ++ () {
+        AMLIB_SEQUENCE_COUNT(increment);
         cur_ += stride_;
         return *this;
     }
     //-----------------------------------------------------
     linear_sequence&
     operator += (size_type offset) {
+        AMLIB_SEQUENCE_COUNT(advance);
         cur_ += stride_ * offset;
         return *this;
     }
+    //-----------------------------------------------------
+    linear_sequence
+    operator + (size_type offset) const {
+        auto res = *this;
+        res += offset;
+        return res;
+    }
+    //-----------------------------------------------------
+    /// writes up to 'max' values to 'out' and advances past them
+    size_type
+    next_batch(value_type* out, size_type max) {
+        const auto n = std::min(size(), max);
+        const auto c = cur_;
+        const auto d = stride_;
+        for(size_type i = 0; i < n; ++i) {
+            out[i] = c + (d * value_type(i));
+        }
+        *this += n;
+        return n;
+    }
 
 
     //---------------------------------------------------------------
@@ -379,7 +452,8 @@ public:
     //-----------------------------------------------------
     size_type
     size() const {
-        return (1 + static_cast<size_type>(
+        AMLIB_SEQUENCE_COUNT(size);
+        return empty() ? size_type(0) : (1 + static_cast<size_type>(
             0.5 + ((uBound_ - cur_) / stride_)));
     }
     //-----------------------------------------------------
@@ -402,6 +476,7 @@ public:
     //-----------------------------------------------------
     linear_sequence
     end() const {
+        AMLIB_SEQUENCE_COUNT(end);
         return linear_sequence{(*this)[size()], stride_, uBound_};
     }
 
@@ -416,9 +491,10 @@ public:
     //---------------------------------------------------------------
     bool
     operator == (const linear_sequence& o) const noexcept {
-        return seq_detail::approx_equal(cur_, o.cur_) &&
-               seq_detail::approx_equal(stride_, o.stride_) &&
-               seq_detail::approx_equal(uBound_, o.uBound_);
+        AMLIB_SEQUENCE_COUNT(compare);
+        return Equality::equal(cur_, o.cur_) &&
+               Equality::equal(stride_, o.stride_) &&
+               Equality::equal(uBound_, o.uBound_);
     }
     //-----------------------------------------------------
     bool
@@ -447,84 +523,84 @@ private:
  *
  *
  *****************************************************************************/
-template<class T>
+template<class T, class E>
 inline decltype(auto)
-begin(const ascending_sequence<T>& s) {
+begin(const ascending_sequence<T,E>& s) {
     return s.begin();
 }
 //-----------------------------------------------------
-template<class T>
+template<class T, class E>
 inline decltype(auto)
-cbegin(const ascending_sequence<T>& s) {
+cbegin(const ascending_sequence<T,E>& s) {
     return s.begin();
 }
 
 //-----------------------------------------------------
-template<class T>
+template<class T, class E>
 inline decltype(auto)
-end(const ascending_sequence<T>& s) {
+end(const ascending_sequence<T,E>& s) {
     return s.end();
 }
 //-----------------------------------------------------
-template<class T>
+template<class T, class E>
 inline decltype(auto)
-cend(const ascending_sequence<T>& s) {
+cend(const ascending_sequence<T,E>& s) {
     return s.end();
 }
 
 
 
 //---------------------------------------------------------------
-template<class T>
+template<class T, class E>
 inline decltype(auto)
-begin(const descending_sequence<T>& s) {
+begin(const descending_sequence<T,E>& s) {
     return s.begin();
 }
 //-----------------------------------------------------
-template<class T>
+template<class T, class E>
 inline decltype(auto)
-cbegin(const descending_sequence<T>& s) {
+cbegin(const descending_sequence<T,E>& s) {
     return s.begin();
 }
 
 //-----------------------------------------------------
-template<class T>
+template<class T, class E>
 inline decltype(auto)
-end(const descending_sequence<T>& s) {
+end(const descending_sequence<T,E>& s) {
     return s.end();
 }
 //-----------------------------------------------------
-template<class T>
+template<class T, class E>
 inline decltype(auto)
-cend(const descending_sequence<T>& s) {
+cend(const descending_sequence<T,E>& s) {
     return s.end();
 }
 
 
 
 //---------------------------------------------------------------
-template<class T>
+template<class T, class E>
 inline decltype(auto)
-begin(const linear_sequence<T>& s) {
+begin(const linear_sequence<T,E>& s) {
     return s.begin();
 }
 //-----------------------------------------------------
-template<class T>
+template<class T, class E>
 inline decltype(auto)
-cbegin(const linear_sequence<T>& s) {
+cbegin(const linear_sequence<T,E>& s) {
     return s.begin();
 }
 
 //-----------------------------------------------------
-template<class T>
+template<class T, class E>
 inline decltype(auto)
-end(const linear_sequence<T>& s) {
+end(const linear_sequence<T,E>& s) {
     return s.end();
 }
 //-----------------------------------------------------
-template<class T>
+template<class T, class E>
 inline decltype(auto)
-cend(const linear_sequence<T>& s) {
+cend(const linear_sequence<T,E>& s) {
     return s.end();
 }
 
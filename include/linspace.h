@@ -0,0 +1,519 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AMLIB_NUMERIC_LINSPACE_SEQUENCE_H_
+#define AMLIB_NUMERIC_LINSPACE_SEQUENCE_H_
+
+
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+#include "stats.h"
+
+
+namespace am {
+
+
+/*************************************************************************//***
+ *
+ * @brief n evenly spaced values from a to b (both included)
+ *
+ *        the element count is stored directly, so size() and empty()
+ *        are integer operations;
+ *        values are evaluated from the index: the first half as
+ *        a + i*step, the second half as b - (n-1-i)*step,
+ *        so both end points are exact
+ *
+ *****************************************************************************/
+template<class T>
+class linspace_sequence :
+    private seq_stats::tracked<linspace_sequence<T>>
+{
+    static_assert(std::is_floating_point<T>::value,
+                  "linspace_sequence requires a floating-point value type");
+
+public:
+    //---------------------------------------------------------------
+    using iterator_category = std::input_iterator_tag;
+    using value_type = T;
+    using reference = const value_type&;
+    using pointer = const value_type*;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+
+    //---------------------------------------------------------------
+    linspace_sequence(value_type a, value_type b, size_type n) noexcept :
+        a_{a}, b_{b},
+        step_{n > 1 ? (b - a) / value_type(n - 1) : value_type(0)},
+        idx_{0}, n_{n}, cur_{a}
+    {}
+
+
+    //---------------------------------------------------------------
+    reference
+    operator * () const noexcept {
+        return cur_;
+    }
+    //-----------------------------------------------------
+    pointer
+    operator -> () const noexcept {
+        return std::addressof(cur_);
+    }
+    //-----------------------------------------------------
+    value_type
+    operator [] (size_type offset) const noexcept {
+        AMLIB_SEQUENCE_COUNT(subscript);
+        return value_at(idx_ + offset);
+    }
+
+
+    //---------------------------------------------------------------
+    linspace_sequence&
+    operator ++ () noexcept {
+        AMLIB_SEQUENCE_COUNT(increment);
+        cur_ = value_at(++idx_);
+        return *this;
+    }
+    //-----------------------------------------------------
+    linspace_sequence&
+    operator += (size_type offset) noexcept {
+        AMLIB_SEQUENCE_COUNT(advance);
+        idx_ = (offset < (n_ - idx_)) ? (idx_ + offset) : n_;
+        cur_ = value_at(idx_);
+        return *this;
+    }
+    //-----------------------------------------------------
+    linspace_sequence
+    operator + (size_type offset) const noexcept {
+        auto res = *this;
+        res += offset;
+        return res;
+    }
+    //-----------------------------------------------------
+    /// writes up to 'max' values to 'out' and advances past them
+    size_type
+    next_batch(value_type* out, size_type max) noexcept {
+        const auto n = size_type(generate(out, max) - out);
+        *this += n;
+        return n;
+    }
+
+
+    //---------------------------------------------------------------
+    /**
+     * @brief writes the next n values (at most size()) to 'out';
+     *        branch-free select per element, vectorized by the compiler
+     * @return pointer one past the last written value
+     */
+    value_type*
+    generate(value_type* out, size_type n) const noexcept
+    {
+        if(n > size()) n = size();
+        const auto a = a_, b = b_, step = step_;
+        const auto half = (n_ + 1) / 2, last = n_ - 1;
+        for(size_type i = 0, k = idx_; i < n; ++i, ++k) {
+            out[i] = (k < half) ? a + value_type(k) * step
+                                : b - value_type(last - k) * step;
+        }
+        return out + n;
+    }
+    //-----------------------------------------------------
+    value_type*
+    copy_to(value_type* out) const noexcept {
+        return generate(out, size());
+    }
+    //-----------------------------------------------------
+    template<class OutputIterator>
+    OutputIterator
+    copy_to(OutputIterator out) const
+    {
+        for(auto k = idx_; k < n_; ++k, ++out) *out = value_at(k);
+        return out;
+    }
+
+
+    //---------------------------------------------------------------
+    value_type front() const noexcept { return a_; }
+    value_type back()  const noexcept { return b_; }
+    value_type step()  const noexcept { return step_; }
+
+
+    //---------------------------------------------------------------
+    bool
+    operator == (const linspace_sequence& o) const noexcept {
+        AMLIB_SEQUENCE_COUNT(compare);
+        return (idx_ == o.idx_) && (n_ == o.n_) && (a_ == o.a_) && (b_ == o.b_);
+    }
+    //-----------------------------------------------------
+    bool
+    operator != (const linspace_sequence& o) const noexcept {
+        return !(*this == o);
+    }
+
+
+    //---------------------------------------------------------------
+    size_type
+    size() const noexcept {
+        AMLIB_SEQUENCE_COUNT(size);
+        return n_ - idx_;
+    }
+    //-----------------------------------------------------
+    bool
+    empty() const noexcept {
+        return idx_ >= n_;
+    }
+
+
+    //---------------------------------------------------------------
+    const linspace_sequence&
+    begin() const noexcept {
+        return *this;
+    }
+    //-----------------------------------------------------
+    linspace_sequence
+    end() const noexcept {
+        AMLIB_SEQUENCE_COUNT(end);
+        auto res = *this;
+        res.idx_ = n_;
+        return res;
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    value_type
+    value_at(size_type k) const noexcept {
+        return (k < (n_ + 1) / 2) ? a_ + value_type(k) * step_
+                            : b_ - value_type(n_ - 1 - k) * step_;
+    }
+
+
+    //---------------------------------------------------------------
+    value_type a_;
+    value_type b_;
+    value_type step_;
+    size_type idx_;
+    size_type n_;
+    value_type cur_;
+};
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief n geometrically spaced values from a to b (both included);
+ *        a and b must be non-zero and have the same sign
+ *
+ *        values are evaluated from the index: the first half as
+ *        a * r^i, the second half as b / r^(n-1-i), so both end points
+ *        are exact
+ *
+ *****************************************************************************/
+template<class T>
+class logspace_sequence :
+    private seq_stats::tracked<logspace_sequence<T>>
+{
+    static_assert(std::is_floating_point<T>::value,
+                  "logspace_sequence requires a floating-point value type");
+
+    /// block length of the bulk fill
+    static constexpr std::size_t block = 64;
+
+public:
+    //---------------------------------------------------------------
+    using iterator_category = std::input_iterator_tag;
+    using value_type = T;
+    using reference = const value_type&;
+    using pointer = const value_type*;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+
+    //---------------------------------------------------------------
+    logspace_sequence(value_type a, value_type b, size_type n) noexcept :
+        a_{a}, b_{b},
+        logRatio_{n > 1 ? std::log(b / a) / value_type(n - 1) : value_type(0)},
+        idx_{0}, n_{n}, cur_{a}
+    {}
+
+
+    //---------------------------------------------------------------
+    reference
+    operator * () const noexcept {
+        return cur_;
+    }
+    //-----------------------------------------------------
+    pointer
+    operator -> () const noexcept {
+        return std::addressof(cur_);
+    }
+    //-----------------------------------------------------
+    value_type
+    operator [] (size_type offset) const noexcept {
+        AMLIB_SEQUENCE_COUNT(subscript);
+        return value_at(idx_ + offset);
+    }
+
+
+    //---------------------------------------------------------------
+    logspace_sequence&
+    operator ++ () noexcept {
+        AMLIB_SEQUENCE_COUNT(increment);
+        cur_ = value_at(++idx_);
+        return *this;
+    }
+    //-----------------------------------------------------
+    logspace_sequence&
+    operator += (size_type offset) noexcept {
+        AMLIB_SEQUENCE_COUNT(advance);
+        idx_ = (offset < (n_ - idx_)) ? (idx_ + offset) : n_;
+        cur_ = value_at(idx_);
+        return *this;
+    }
+    //-----------------------------------------------------
+    logspace_sequence
+    operator + (size_type offset) const noexcept {
+        auto res = *this;
+        res += offset;
+        return res;
+    }
+    //-----------------------------------------------------
+    /// writes up to 'max' values to 'out' and advances past them
+    size_type
+    next_batch(value_type* out, size_type max) noexcept {
+        const auto n = size_type(generate(out, max) - out);
+        *this += n;
+        return n;
+    }
+
+
+    //---------------------------------------------------------------
+    /**
+     * @brief writes the next n values (at most size()) to 'out'
+     *
+     *        exp() is evaluated only once per block of 64 values and for
+     *        the 64 powers r^j; the values in between are anchor * r^j,
+     *        a vectorizable multiplication; interior values may differ
+     *        from operator[] by a few ulps, end points are exact
+     *
+     * @return pointer one past the last written value
+     */
+    value_type*
+    generate(value_type* out, size_type n) const noexcept
+    {
+        if(n > size()) n = size();
+        if(n < 1) return out;
+
+        value_type pw[block];
+        const auto npw = (n < block) ? n : size_type(block);
+        for(size_type j = 0; j < npw; ++j) {
+            pw[j] = std::exp(logRatio_ * value_type(j));
+        }
+
+        for(size_type i = 0; i < n; i += block) {
+            const auto anchor = value_at(idx_ + i);
+            const auto m = (n - i < block) ? (n - i) : block;
+            auto o = out + i;
+            for(size_type j = 0; j < m; ++j) o[j] = anchor * pw[j];
+        }
+        //exact end point
+        if(n_ > 1 && idx_ + n == n_) out[n-1] = b_;
+        return out + n;
+    }
+    //-----------------------------------------------------
+    value_type*
+    copy_to(value_type* out) const noexcept {
+        return generate(out, size());
+    }
+    //-----------------------------------------------------
+    template<class OutputIterator>
+    OutputIterator
+    copy_to(OutputIterator out) const
+    {
+        for(auto k = idx_; k < n_; ++k, ++out) *out = value_at(k);
+        return out;
+    }
+
+
+    //---------------------------------------------------------------
+    value_type front() const noexcept { return a_; }
+    value_type back()  const noexcept { return b_; }
+    value_type ratio() const noexcept { return std::exp(logRatio_); }
+
+
+    //---------------------------------------------------------------
+    bool
+    operator == (const logspace_sequence& o) const noexcept {
+        AMLIB_SEQUENCE_COUNT(compare);
+        return (idx_ == o.idx_) && (n_ == o.n_) && (a_ == o.a_) && (b_ == o.b_);
+    }
+    //-----------------------------------------------------
+    bool
+    operator != (const logspace_sequence& o) const noexcept {
+        return !(*this == o);
+    }
+
+
+    //---------------------------------------------------------------
+    size_type
+    size() const noexcept {
+        AMLIB_SEQUENCE_COUNT(size);
+        return n_ - idx_;
+    }
+    //-----------------------------------------------------
+    bool
+    empty() const noexcept {
+        return idx_ >= n_;
+    }
+
+
+    //---------------------------------------------------------------
+    const logspace_sequence&
+    begin() const noexcept {
+        return *this;
+    }
+    //-----------------------------------------------------
+    logspace_sequence
+    end() const noexcept {
+        AMLIB_SEQUENCE_COUNT(end);
+        auto res = *this;
+        res.idx_ = n_;
+        return res;
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    value_type
+    value_at(size_type k) const noexcept {
+        AMLIB_SEQUENCE_COUNT(transcendental);
+        return (k < (n_ + 1) / 2)
+            ? a_ * std::exp(logRatio_ * value_type(k))
+            : b_ * std::exp(-logRatio_ * value_type(n_ - 1 - k));
+    }
+
+
+    //---------------------------------------------------------------
+    value_type a_;
+    value_type b_;
+    value_type logRatio_;
+    size_type idx_;
+    size_type n_;
+    value_type cur_;
+};
+
+template<class T>
+constexpr std::size_t logspace_sequence<T>::block;
+
+
+
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+template<class T>
+inline decltype(auto)
+begin(const linspace_sequence<T>& s) noexcept
+{
+    return s.begin();
+}
+
+//---------------------------------------------------------
+template<class T>
+inline decltype(auto)
+cbegin(const linspace_sequence<T>& s) noexcept
+{
+    return s.begin();
+}
+
+//---------------------------------------------------------
+template<class T>
+inline decltype(auto)
+end(const linspace_sequence<T>& s) noexcept
+{
+    return s.end();
+}
+
+//---------------------------------------------------------
+template<class T>
+inline decltype(auto)
+cend(const linspace_sequence<T>& s) noexcept
+{
+    return s.end();
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+inline decltype(auto)
+begin(const logspace_sequence<T>& s) noexcept
+{
+    return s.begin();
+}
+
+//---------------------------------------------------------
+template<class T>
+inline decltype(auto)
+cbegin(const logspace_sequence<T>& s) noexcept
+{
+    return s.begin();
+}
+
+//---------------------------------------------------------
+template<class T>
+inline decltype(auto)
+end(const logspace_sequence<T>& s) noexcept
+{
+    return s.end();
+}
+
+//---------------------------------------------------------
+template<class T>
+inline decltype(auto)
+cend(const logspace_sequence<T>& s) noexcept
+{
+    return s.end();
+}
+
+
+
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+template<class T>
+inline auto
+linspace(T a, T b, std::size_t n) noexcept
+{
+    return linspace_sequence<T>{a, b, n};
+}
+
+//---------------------------------------------------------
+template<class T>
+inline auto
+logspace(T a, T b, std::size_t n) noexcept
+{
+    return logspace_sequence<T>{a, b, n};
+}
+
+
+}  // namespace am
+
+
+#endif
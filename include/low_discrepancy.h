@@ -0,0 +1,744 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AMLIB_NUMERIC_LOW_DISCREPANCY_SEQUENCE_H_
+#define AMLIB_NUMERIC_LOW_DISCREPANCY_SEQUENCE_H_
+
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "stats.h"
+
+
+namespace am {
+
+
+namespace seq_detail {
+
+
+/*************************************************************************//***
+ *
+ * @brief maps a 64 bit fixed-point fraction to [0,1)
+ *
+ *        float/double: the high mantissa bits are or-ed into the
+ *        exponent of 1.0 which yields a value in [1,2);
+ *        only integer ops and one subtraction, so batch loops vectorize
+ *        without 64 bit int -> float conversion instructions
+ *
+ *****************************************************************************/
+template<class T>
+struct unit_interval {
+    static T
+    from_fixed(std::uint64_t x) noexcept {
+        return T(x >> 11) * (T(1) / T(std::uint64_t(1) << 53));
+    }
+};
+
+//---------------------------------------------------------
+template<>
+struct unit_interval<double> {
+    static double
+    from_fixed(std::uint64_t x) noexcept {
+        const std::uint64_t bits = (x >> 12) | 0x3FF0000000000000ull;
+        double d;
+        std::memcpy(&d, &bits, sizeof(d));
+        return d - 1.0;
+    }
+};
+
+//---------------------------------------------------------
+template<>
+struct unit_interval<float> {
+    static float
+    from_fixed(std::uint64_t x) noexcept {
+        const std::uint32_t bits = std::uint32_t(x >> 41) | 0x3F800000u;
+        float f;
+        std::memcpy(&f, &bits, sizeof(f));
+        return f - 1.0f;
+    }
+};
+
+
+
+
+//-------------------------------------------------------------------
+/// bases of the Halton sequence (first 32 primes)
+constexpr std::uint16_t halton_primes[] = {
+      2,   3,   5,   7,  11,  13,  17,  19,  23,  29,  31,  37,  41,  43,
+     47,  53,  59,  61,  67,  71,  73,  79,  83,  89,  97, 101, 103, 107,
+    109, 113, 127, 131
+};
+
+constexpr std::size_t halton_max_dims =
+    sizeof(halton_primes) / sizeof(halton_primes[0]);
+
+
+
+/*************************************************************************//***
+ *
+ * @brief radical inverse in fixed-point:
+ *        R(n) = sum_k perm[d_k(n)] * base^(K-1-k)  with  scale = base^K
+ *        being the largest power of base that fits into 64 bits;
+ *        exact for n < scale
+ *
+ *****************************************************************************/
+struct radix_table
+{
+    std::uint64_t base = 2;
+    std::uint64_t top = 1;      //base^(K-1), weight of the lowest digit
+    std::uint64_t scale = 2;    //base^K
+    std::vector<std::uint64_t> perm;
+
+    //---------------------------------------------------------------
+    radix_table(std::uint64_t b, bool scrambled):
+        base{b}, top{1}, scale{b}, perm(b)
+    {
+        while(scale <= std::numeric_limits<std::uint64_t>::max() / base) {
+            top = scale;
+            scale *= base;
+        }
+        //digit permutation; perm[0] must stay 0 so that the
+        //infinitely many leading zero digits contribute nothing
+        for(std::uint64_t d = 0; d < base; ++d) {
+            perm[d] = (scrambled && d > 0) ? base - d : d;
+        }
+    }
+
+    //---------------------------------------------------------------
+    std::uint64_t
+    radical_inverse(std::uint64_t n) const noexcept {
+        std::uint64_t r = 0;
+        for(auto w = top; n > 0 && w > 0; n /= base, w /= base) {
+            r += perm[n % base] * w;
+        }
+        return r;
+    }
+
+    //---------------------------------------------------------------
+    /// R(n) -> R(n+1); amortized O(1) (a carry every base-th step)
+    std::uint64_t
+    next(std::uint64_t r, std::uint64_t n) const noexcept {
+        for(auto w = top; w > 0; n /= base, w /= base) {
+            const auto d = n % base;
+            if(d + 1 < base) {
+                //unsigned wrap-around handles perm[d+1] < perm[d]
+                return r + perm[d+1] * w - perm[d] * w;
+            }
+            r -= perm[d] * w;
+        }
+        return r;
+    }
+};
+
+
+//-------------------------------------------------------------------
+inline const radix_table&
+halton_radix(std::size_t dim, bool scrambled)
+{
+    static const auto tables = [] {
+        auto t = std::array<std::vector<radix_table>,2>{};
+        for(auto p : halton_primes) {
+            t[0].emplace_back(p, false);
+            t[1].emplace_back(p, true);
+        }
+        return t;
+    }();
+    return tables[scrambled ? 1 : 0][dim];
+}
+
+
+}  // namespace seq_detail
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief digit permutation of the Halton sequence
+ *        plain:    radical inverse in the first primes
+ *        reversed: digits d>0 are mapped to base-d, which breaks up
+ *                  the correlations between higher dimensions
+ *
+ *****************************************************************************/
+enum class halton_digits {
+    plain, reversed
+};
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief Dims-dimensional Halton points in [0,1)^Dims
+ *
+ *        dimension j is the radical inverse of the index in the j-th prime;
+ *        the radical inverses are kept in exact fixed-point form, so that
+ *        ++ (amortized O(1) per dimension), [] and += (O(log n))
+ *        yield exactly the same points
+ *
+ *****************************************************************************/
+template<class T, std::size_t Dims>
+class halton_sequence :
+    private seq_stats::tracked<halton_sequence<T,Dims>>
+{
+    static_assert(std::is_floating_point<T>::value,
+                  "halton_sequence requires a floating-point value type");
+    static_assert(Dims > 0 && Dims <= seq_detail::halton_max_dims,
+                  "halton_sequence supports 1 to 32 dimensions");
+
+    using fixed_point = std::array<std::uint64_t,Dims>;
+
+public:
+    //---------------------------------------------------------------
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::array<T,Dims>;
+    using reference = const value_type&;
+    using pointer = const value_type*;
+    using size_type = std::uint64_t;
+    using difference_type = std::int64_t;
+
+    static constexpr std::size_t dimensions = Dims;
+
+
+    //---------------------------------------------------------------
+    explicit
+    halton_sequence(size_type count = std::numeric_limits<size_type>::max(),
+                    halton_digits digits = halton_digits::plain)
+    :
+        idx_{0}, end_{count}, digits_{digits}, fix_{}, cur_{}
+    {
+        fix_.fill(0);
+        cur_.fill(T(0));
+    }
+
+
+    //---------------------------------------------------------------
+    reference
+    operator * () const noexcept {
+        return cur_;
+    }
+    //-----------------------------------------------------
+    pointer
+    operator -> () const noexcept {
+        return std::addressof(cur_);
+    }
+    //-----------------------------------------------------
+    value_type
+    operator [] (size_type offset) const noexcept {
+        AMLIB_SEQUENCE_COUNT(subscript);
+        auto res = value_type{};
+        for(std::size_t j = 0; j < Dims; ++j) {
+            res[j] = to_unit(j, radix(j).radical_inverse(idx_ + offset));
+        }
+        return res;
+    }
+
+
+    //---------------------------------------------------------------
+    halton_sequence&
+    operator ++ () noexcept {
+        AMLIB_SEQUENCE_COUNT(increment);
+        for(std::size_t j = 0; j < Dims; ++j) {
+            fix_[j] = radix(j).next(fix_[j], idx_);
+            cur_[j] = to_unit(j, fix_[j]);
+        }
+        ++idx_;
+        return *this;
+    }
+    //-----------------------------------------------------
+    halton_sequence&
+    operator += (size_type offset) noexcept {
+        AMLIB_SEQUENCE_COUNT(advance);
+        idx_ = (offset < (end_ - idx_)) ? (idx_ + offset) : end_;
+        for(std::size_t j = 0; j < Dims; ++j) {
+            fix_[j] = radix(j).radical_inverse(idx_);
+            cur_[j] = to_unit(j, fix_[j]);
+        }
+        return *this;
+    }
+    //-----------------------------------------------------
+    halton_sequence
+    operator + (size_type offset) const noexcept {
+        auto res = *this;
+        res += offset;
+        return res;
+    }
+    //-----------------------------------------------------
+    /**
+     * @brief writes up to 'max' points to 'out' and advances past them;
+     *        incremental digit updates like ++
+     */
+    size_type
+    next_batch(value_type* out, size_type max) noexcept {
+        const auto n = std::min(size(), max);
+        auto x = fix_;
+        for(size_type i = 0; i < n; ++i) {
+            for(std::size_t j = 0; j < Dims; ++j) {
+                out[i][j] = to_unit(j, x[j]);
+                x[j] = radix(j).next(x[j], idx_ + i);
+            }
+        }
+        if(n > 0) {
+            idx_ += n;
+            fix_ = x;
+            for(std::size_t j = 0; j < Dims; ++j) cur_[j] = to_unit(j, x[j]);
+        }
+        return n;
+    }
+
+
+    //---------------------------------------------------------------
+    /// absolute index of the current point
+    size_type
+    index() const noexcept {
+        return idx_;
+    }
+    //-----------------------------------------------------
+    std::uint64_t
+    base(std::size_t dim) const noexcept {
+        return radix(dim).base;
+    }
+
+
+    //---------------------------------------------------------------
+    bool
+    operator == (const halton_sequence& o) const noexcept {
+        AMLIB_SEQUENCE_COUNT(compare);
+        return (idx_ == o.idx_) && (end_ == o.end_) && (digits_ == o.digits_);
+    }
+    //-----------------------------------------------------
+    bool
+    operator != (const halton_sequence& o) const noexcept {
+        return !(*this == o);
+    }
+
+
+    //---------------------------------------------------------------
+    size_type
+    size() const noexcept {
+        AMLIB_SEQUENCE_COUNT(size);
+        return end_ - idx_;
+    }
+    //-----------------------------------------------------
+    bool
+    empty() const noexcept {
+        return idx_ >= end_;
+    }
+
+
+    //---------------------------------------------------------------
+    const halton_sequence&
+    begin() const noexcept {
+        return *this;
+    }
+    //-----------------------------------------------------
+    halton_sequence
+    end() const noexcept {
+        AMLIB_SEQUENCE_COUNT(end);
+        auto res = *this;
+        res.idx_ = end_;
+        return res;
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    const seq_detail::radix_table&
+    radix(std::size_t dim) const noexcept {
+        return seq_detail::halton_radix(dim, digits_ == halton_digits::reversed);
+    }
+
+    //---------------------------------------------------------------
+    T
+    to_unit(std::size_t dim, std::uint64_t r) const noexcept {
+        //rounding may yield 1 for scales > 2^digits
+        const auto x = T(r) / T(radix(dim).scale);
+        return (x < T(1)) ? x : one_below;
+    }
+
+    static constexpr T one_below =
+        T(1) - std::numeric_limits<T>::epsilon() / T(2);
+
+
+    //---------------------------------------------------------------
+    size_type idx_;
+    size_type end_;
+    halton_digits digits_;
+    fixed_point fix_;
+    value_type cur_;
+};
+
+
+template<class T, std::size_t Dims>
+constexpr T halton_sequence<T,Dims>::one_below;
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief Dims-dimensional Kronecker (Weyl) points
+ *        x_n = frac(offset + n * alpha)  in [0,1)^Dims
+ *
+ *        alpha = (1/phi_d, 1/phi_d^2, ..., 1/phi_d^Dims) with phi_d being the
+ *        generalized golden ratio (positive root of x^(Dims+1) = x + 1),
+ *        i.e. the "R_d" sequence
+ *
+ *        the state is kept in 64 bit fixed-point: frac() is the natural
+ *        unsigned wrap-around, ++ is one add per dimension,
+ *        [] and += are one multiply-add per dimension
+ *
+ *****************************************************************************/
+template<class T, std::size_t Dims>
+class kronecker_sequence :
+    private seq_stats::tracked<kronecker_sequence<T,Dims>>
+{
+    static_assert(std::is_floating_point<T>::value,
+                  "kronecker_sequence requires a floating-point value type");
+    static_assert(Dims > 0, "kronecker_sequence requires at least 1 dimension");
+
+    using fixed_point = std::array<std::uint64_t,Dims>;
+
+public:
+    //---------------------------------------------------------------
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::array<T,Dims>;
+    using reference = const value_type&;
+    using pointer = const value_type*;
+    using size_type = std::uint64_t;
+    using difference_type = std::int64_t;
+
+    static constexpr std::size_t dimensions = Dims;
+
+
+    //---------------------------------------------------------------
+    explicit
+    kronecker_sequence(size_type count = std::numeric_limits<size_type>::max(),
+                       T offset = T(0.5))
+    :
+        idx_{0}, end_{count}, alpha_(alphas()), origin_{}, fix_{}, cur_{}
+    {
+        //offsets just below an integer can round up to 1
+        auto o = offset - std::floor(offset);
+        if(!(o < T(1))) o = T(0);
+        origin_.fill(std::uint64_t(
+            std::ldexp(static_cast<long double>(o), 64) ));
+        fix_ = origin_;
+        update();
+    }
+
+
+    //---------------------------------------------------------------
+    reference
+    operator * () const noexcept {
+        return cur_;
+    }
+    //-----------------------------------------------------
+    pointer
+    operator -> () const noexcept {
+        return std::addressof(cur_);
+    }
+    //-----------------------------------------------------
+    value_type
+    operator [] (size_type offset) const noexcept {
+        AMLIB_SEQUENCE_COUNT(subscript);
+        auto res = value_type{};
+        const auto n = idx_ + offset;
+        for(std::size_t j = 0; j < Dims; ++j) {
+            res[j] = unit(origin_[j] + n * alpha_[j]);
+        }
+        return res;
+    }
+
+
+    //---------------------------------------------------------------
+    kronecker_sequence&
+    operator ++ () noexcept {
+        AMLIB_SEQUENCE_COUNT(increment);
+        ++idx_;
+        for(std::size_t j = 0; j < Dims; ++j) fix_[j] += alpha_[j];
+        update();
+        return *this;
+    }
+    //-----------------------------------------------------
+    kronecker_sequence&
+    operator += (size_type offset) noexcept {
+        AMLIB_SEQUENCE_COUNT(advance);
+        idx_ = (offset < (end_ - idx_)) ? (idx_ + offset) : end_;
+        for(std::size_t j = 0; j < Dims; ++j) {
+            fix_[j] = origin_[j] + idx_ * alpha_[j];
+        }
+        update();
+        return *this;
+    }
+    //-----------------------------------------------------
+    kronecker_sequence
+    operator + (size_type offset) const noexcept {
+        auto res = *this;
+        res += offset;
+        return res;
+    }
+    //-----------------------------------------------------
+    /**
+     * @brief writes up to 'max' points to 'out' and advances past them;
+     *        same vectorizable loop as generate
+     */
+    size_type
+    next_batch(value_type* out, size_type max) noexcept {
+        const auto n = std::min(size(), max);
+        auto x = fix_;
+        const auto a = alpha_;
+        for(size_type i = 0; i < n; ++i) {
+            for(std::size_t j = 0; j < Dims; ++j) {
+                out[i][j] = unit(x[j]);
+                x[j] += a[j];
+            }
+        }
+        idx_ += n;
+        fix_ = x;
+        update();
+        return n;
+    }
+
+
+    //---------------------------------------------------------------
+    /**
+     * @brief writes the next n points (at most size()) to 'out'
+     *        as n x Dims row-major array;
+     *        the state is held in locals (no aliasing with 'out') and
+     *        the loop is branch-free, so the compiler vectorizes it
+     * @return pointer one past the last written value
+     */
+    T*
+    generate(T* out, size_type n) const noexcept
+    {
+        if(n > size()) n = size();
+        auto x = fix_;
+        const auto a = alpha_;
+        for(size_type i = 0; i < n; ++i) {
+            for(std::size_t j = 0; j < Dims; ++j) {
+                out[i*Dims + j] = unit(x[j]);
+                x[j] += a[j];
+            }
+        }
+        return out + n * Dims;
+    }
+
+
+    //---------------------------------------------------------------
+    /// absolute index of the current point
+    size_type
+    index() const noexcept {
+        return idx_;
+    }
+    //-----------------------------------------------------
+    /// generator vector in 64 bit fixed-point
+    const fixed_point&
+    alpha() const noexcept {
+        return alpha_;
+    }
+
+
+    //---------------------------------------------------------------
+    bool
+    operator == (const kronecker_sequence& o) const noexcept {
+        AMLIB_SEQUENCE_COUNT(compare);
+        return (idx_ == o.idx_) && (end_ == o.end_) && (origin_ == o.origin_);
+    }
+    //-----------------------------------------------------
+    bool
+    operator != (const kronecker_sequence& o) const noexcept {
+        return !(*this == o);
+    }
+
+
+    //---------------------------------------------------------------
+    size_type
+    size() const noexcept {
+        AMLIB_SEQUENCE_COUNT(size);
+        return end_ - idx_;
+    }
+    //-----------------------------------------------------
+    bool
+    empty() const noexcept {
+        return idx_ >= end_;
+    }
+
+
+    //---------------------------------------------------------------
+    const kronecker_sequence&
+    begin() const noexcept {
+        return *this;
+    }
+    //-----------------------------------------------------
+    kronecker_sequence
+    end() const noexcept {
+        AMLIB_SEQUENCE_COUNT(end);
+        auto res = *this;
+        res.idx_ = end_;
+        return res;
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    static T
+    unit(std::uint64_t x) noexcept {
+        return seq_detail::unit_interval<T>::from_fixed(x);
+    }
+
+    //---------------------------------------------------------------
+    void
+    update() noexcept {
+        for(std::size_t j = 0; j < Dims; ++j) cur_[j] = unit(fix_[j]);
+    }
+
+    //---------------------------------------------------------------
+    static const fixed_point&
+    alphas()
+    {
+        static const auto a = [] {
+            using real = long double;
+            //fixed point iteration  phi <- (1+phi)^(1/(d+1))
+            real phi = 2;
+            for(int i = 0; i < 128; ++i) {
+                phi = std::pow(real(1) + phi, real(1) / real(Dims + 1));
+            }
+            auto res = fixed_point{};
+            real x = 1;
+            for(std::size_t j = 0; j < Dims; ++j) {
+                x /= phi;
+                res[j] = std::uint64_t(std::ldexp(x, 64));
+            }
+            return res;
+        }();
+        return a;
+    }
+
+
+    //---------------------------------------------------------------
+    size_type idx_;
+    size_type end_;
+    fixed_point alpha_;
+    fixed_point origin_;
+    fixed_point fix_;
+    value_type cur_;
+};
+
+
+
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+template<class T, std::size_t Dims>
+inline decltype(auto)
+begin(const halton_sequence<T,Dims>& s) noexcept
+{
+    return s.begin();
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t Dims>
+inline decltype(auto)
+cbegin(const halton_sequence<T,Dims>& s) noexcept
+{
+    return s.begin();
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t Dims>
+inline decltype(auto)
+end(const halton_sequence<T,Dims>& s) noexcept
+{
+    return s.end();
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t Dims>
+inline decltype(auto)
+cend(const halton_sequence<T,Dims>& s) noexcept
+{
+    return s.end();
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T, std::size_t Dims>
+inline decltype(auto)
+begin(const kronecker_sequence<T,Dims>& s) noexcept
+{
+    return s.begin();
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t Dims>
+inline decltype(auto)
+cbegin(const kronecker_sequence<T,Dims>& s) noexcept
+{
+    return s.begin();
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t Dims>
+inline decltype(auto)
+end(const kronecker_sequence<T,Dims>& s) noexcept
+{
+    return s.end();
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t Dims>
+inline decltype(auto)
+cend(const kronecker_sequence<T,Dims>& s) noexcept
+{
+    return s.end();
+}
+
+
+
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+template<class T, std::size_t Dims>
+inline auto
+make_halton_sequence(std::uint64_t count,
+                     halton_digits digits = halton_digits::plain)
+{
+    return halton_sequence<T,Dims>{count, digits};
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t Dims>
+inline auto
+make_kronecker_sequence(std::uint64_t count, T offset = T(0.5))
+{
+    return kronecker_sequence<T,Dims>{count, offset};
+}
+
+
+}  // namespace am
+
+
+#endif
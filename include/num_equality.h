@@ -12,8 +12,12 @@
 #define AMLIB_TEST_EQUALITY_H_
 
 
+#include <cmath>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <limits>
+#include <type_traits>
 
 
 namespace am {
@@ -82,7 +86,155 @@ abs_approx_equal(const T1& a, const T2& b, const T3& tolerance)
 }
 
 
+
+
+
+/*****************************************************************************
+ *
+ * @brief maps floating-point bit patterns to signed integers that are
+ *        ordered like the floating-point values (-0.0 and +0.0 map to 0);
+ *        neighboring values differ by 1
+ *
+ *****************************************************************************/
+template<class T>
+using ulp_int_t = std::conditional_t<(sizeof(T) <= 4), std::int32_t,
+                                                       std::int64_t>;
+
+template<class T>
+inline ulp_int_t<T>
+ordered_bits(const T& x) noexcept
+{
+    static_assert(sizeof(T) == sizeof(ulp_int_t<T>),
+                  "ULP comparison requires 32 or 64 bit floating-point types");
+
+    using int_t = ulp_int_t<T>;
+    int_t i;
+    std::memcpy(&i, &x, sizeof(T));
+    return (i < 0) ? int_t(std::numeric_limits<int_t>::min() - i) : i;
+}
+
+
+//-------------------------------------------------------------------
+template<class T>
+inline std::uint64_t
+ulp_distance(const T& a, const T& b, std::true_type /*floating*/) noexcept
+{
+    const auto ia = ordered_bits(a);
+    const auto ib = ordered_bits(b);
+    using uint_t = std::make_unsigned_t<ulp_int_t<T>>;
+    return (ia >= ib) ? std::uint64_t(uint_t(ia) - uint_t(ib))
+                      : std::uint64_t(uint_t(ib) - uint_t(ia));
+}
+
+template<class T>
+inline std::uint64_t
+ulp_distance(const T& a, const T& b, std::false_type /*integral*/) noexcept
+{
+    return (a >= b) ? std::uint64_t(a - b) : std::uint64_t(b - a);
+}
+
+
 }  // namespace seq_detail
+
+
+
+
+/*****************************************************************************
+ *
+ * EQUALITY POLICIES
+ *
+ * used by sequence generators for comparisons (and thus loop termination);
+ * a policy provides  static bool equal(const T&, const T&)
+ *
+ *****************************************************************************/
+
+/*************************************************************************//***
+ *
+ * @brief a == b
+ *        default for integral types
+ *
+ *****************************************************************************/
+struct exact_equality
+{
+    template<class T>
+    static constexpr bool
+    equal(const T& a, const T& b) noexcept {
+        return a == b;
+    }
+};
+
+
+
+/*************************************************************************//***
+ *
+ * @brief |a-b| <= Factor * epsilon
+ *        default for floating-point types; only meaningful for values
+ *        of magnitude ~1
+ *
+ *****************************************************************************/
+template<int Factor = 100>
+struct absolute_equality
+{
+    template<class T>
+    static constexpr bool
+    equal(const T& a, const T& b) noexcept {
+        return seq_detail::approx_equal(a, b,
+                   T(Factor) * std::numeric_limits<T>::epsilon());
+    }
+};
+
+
+
+/*************************************************************************//***
+ *
+ * @brief |a-b| <= Factor * epsilon * max(|a|,|b|)
+ *
+ *****************************************************************************/
+template<int Factor = 100>
+struct relative_equality
+{
+    template<class T>
+    static bool
+    equal(const T& a, const T& b) noexcept {
+        using std::abs;
+        if(a == b) return true;
+        const auto d = abs(a - b);
+        const auto m = (abs(a) < abs(b)) ? abs(b) : abs(a);
+        return d <= (T(Factor) * std::numeric_limits<T>::epsilon() * m);
+    }
+};
+
+
+
+/*************************************************************************//***
+ *
+ * @brief a and b are at most MaxUlps representable values apart;
+ *        computed on the integer bit patterns of floating-point values;
+ *        NaN is never equal to anything
+ *
+ *****************************************************************************/
+template<unsigned MaxUlps = 4>
+struct ulp_equality
+{
+    template<class T>
+    static bool
+    equal(const T& a, const T& b) noexcept {
+        if(a != a || b != b) return false;
+        return seq_detail::ulp_distance(a, b,
+                   std::is_floating_point<T>{}) <= MaxUlps;
+    }
+};
+
+
+
+//-------------------------------------------------------------------
+/// exact comparison for integral types, absolute tolerance otherwise
+template<class T>
+using default_equality = std::conditional_t<std::is_floating_point<T>::value,
+                                            absolute_equality<>,
+                                            exact_equality>;
+
+
 }  // namespace am
 
 
@@ -0,0 +1,388 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AMLIB_NUMERIC_PARALLEL_SEQUENCE_H_
+#define AMLIB_NUMERIC_PARALLEL_SEQUENCE_H_
+
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "segmented.h"
+
+
+namespace am {
+
+
+namespace seq_detail {
+
+
+//-------------------------------------------------------------------
+constexpr std::size_t cache_line_size = 64;
+
+/// chunks smaller than this are not worth handing to another thread
+constexpr std::size_t min_parallel_grain = 4096;
+
+
+
+/*************************************************************************//***
+ *
+ * @brief mutex-protected double-ended queue of chunk indices;
+ *        the owner pops from the front, thieves steal from the back
+ *
+ *****************************************************************************/
+class alignas(cache_line_size) chunk_queue
+{
+public:
+    //---------------------------------------------------------------
+    void
+    push_back(std::size_t chunk) {
+        std::lock_guard<std::mutex> lock{mutex_};
+        chunks_.push_back(chunk);
+    }
+
+    //---------------------------------------------------------------
+    bool
+    pop_front(std::size_t& chunk) {
+        std::lock_guard<std::mutex> lock{mutex_};
+        if(chunks_.empty()) return false;
+        chunk = chunks_.front();
+        chunks_.pop_front();
+        return true;
+    }
+    //-----------------------------------------------------
+    bool
+    steal_back(std::size_t& chunk) {
+        std::lock_guard<std::mutex> lock{mutex_};
+        if(chunks_.empty()) return false;
+        chunk = chunks_.back();
+        chunks_.pop_back();
+        return true;
+    }
+
+private:
+    std::mutex mutex_;
+    std::deque<std::size_t> chunks_;
+};
+
+
+
+/*************************************************************************//***
+ *
+ * @brief work-stealing executor for a fixed number of independent chunks
+ *
+ *        Each worker initially owns a contiguous block of chunk indices
+ *        (good locality); workers that run out of work steal chunks from
+ *        the back of other workers' queues.
+ *        The calling thread participates as worker 0.
+ *        The first exception thrown by a task is rethrown after all
+ *        workers have finished.
+ *
+ *****************************************************************************/
+class work_stealing_pool
+{
+public:
+    //---------------------------------------------------------------
+    explicit
+    work_stealing_pool(std::size_t threads):
+        queues_(threads < 1 ? 1 : threads)
+    {}
+
+
+    //---------------------------------------------------------------
+    std::size_t
+    size() const noexcept {
+        return queues_.size();
+    }
+
+
+    //---------------------------------------------------------------
+    /**
+     * @brief calls task(i) for all i in [0,numChunks)
+     */
+    template<class Task>
+    void
+    run(std::size_t numChunks, Task&& task)
+    {
+        const auto workers = std::min(size(), numChunks);
+        if(workers < 1) return;
+
+        if(workers == 1) {
+            for(std::size_t i = 0; i < numChunks; ++i) task(i);
+            return;
+        }
+
+        for(std::size_t w = 0; w < workers; ++w) {
+            const auto first = (numChunks * w) / workers;
+            const auto last  = (numChunks * (w+1)) / workers;
+            for(auto i = first; i < last; ++i) queues_[w].push_back(i);
+        }
+
+        std::exception_ptr error;
+        std::mutex errorMutex;
+
+        auto work = [&](std::size_t self) {
+            try {
+                std::size_t chunk = 0;
+                while(next(self, workers, chunk)) task(chunk);
+            }
+            catch(...) {
+                std::lock_guard<std::mutex> lock{errorMutex};
+                if(!error) error = std::current_exception();
+                //drain own queue so that the other workers can finish
+                std::size_t chunk = 0;
+                while(queues_[self].pop_front(chunk)) {}
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(workers - 1);
+        for(std::size_t w = 1; w < workers; ++w) {
+            threads.emplace_back(work, w);
+        }
+        work(0);
+        for(auto& t : threads) t.join();
+
+        if(error) std::rethrow_exception(error);
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    bool
+    next(std::size_t self, std::size_t workers, std::size_t& chunk)
+    {
+        if(queues_[self].pop_front(chunk)) return true;
+
+        for(std::size_t i = 1; i < workers; ++i) {
+            if(queues_[(self + i) % workers].steal_back(chunk)) return true;
+        }
+        return false;
+    }
+
+
+    //---------------------------------------------------------------
+    std::vector<chunk_queue> queues_;
+};
+
+
+
+//-------------------------------------------------------------------
+inline std::size_t
+default_thread_count(std::size_t threads) noexcept
+{
+    if(threads > 0) return threads;
+    const auto hw = std::thread::hardware_concurrency();
+    return hw > 0 ? std::size_t(hw) : std::size_t(1);
+}
+
+
+
+/*************************************************************************//***
+ *
+ * @brief index partition [0,n) into chunks of 'grain' elements
+ *        whose boundaries are shifted by 'skew';
+ *        chunk k is [k*grain - skew, (k+1)*grain - skew) clamped to [0,n)
+ *
+ *****************************************************************************/
+struct chunk_partition
+{
+    std::size_t n;
+    std::size_t grain;
+    std::size_t skew;
+
+    std::size_t
+    count() const noexcept {
+        return (n + skew + grain - 1) / grain;
+    }
+    std::size_t
+    first(std::size_t k) const noexcept {
+        return k < 1 ? 0 : (k * grain - skew);
+    }
+    std::size_t
+    last(std::size_t k) const noexcept {
+        return std::min(n, (k+1) * grain - skew);
+    }
+};
+
+
+//-------------------------------------------------------------------
+/**
+ * @brief chunk size: roughly 'chunksPerThread' chunks per thread,
+ *        at least 'minGrain' and a multiple of 'unit'
+ */
+inline std::size_t
+chunk_grain(std::size_t n, std::size_t threads, std::size_t unit,
+            std::size_t minGrain = min_parallel_grain,
+            std::size_t chunksPerThread = 4) noexcept
+{
+    auto grain = n / (threads * chunksPerThread);
+    if(grain < minGrain) grain = minGrain;
+    if(unit > 1) grain = ((grain + unit - 1) / unit) * unit;
+    return grain;
+}
+
+
+//-------------------------------------------------------------------
+/**
+ * @brief number of elements between the cache line boundary preceding
+ *        'out' and 'out' (i.e. how far 'out' lies past a boundary);
+ *        0 for non-pointer iterators
+ */
+template<class T>
+inline std::size_t
+cache_line_skew(T* out) noexcept
+{
+    if((cache_line_size % sizeof(T)) != 0) return 0;
+    const auto addr = reinterpret_cast<std::uintptr_t>(out);
+    if((addr % sizeof(T)) != 0) return 0;
+    return (addr % cache_line_size) / sizeof(T);
+}
+
+template<class OutputIterator>
+inline std::size_t
+cache_line_skew(const OutputIterator&) noexcept
+{
+    return 0;
+}
+
+
+//-------------------------------------------------------------------
+template<class T>
+constexpr std::size_t
+elements_per_cache_line() noexcept
+{
+    return (sizeof(T) < cache_line_size && (cache_line_size % sizeof(T)) == 0)
+           ? cache_line_size / sizeof(T) : 1;
+}
+
+
+
+/*************************************************************************//***
+ *
+ * @brief calls f(value) for the next n values of seq;
+ *        one tight loop per segment
+ *
+ *****************************************************************************/
+template<class Sequence, class F>
+inline void
+for_each_n(const Sequence& seq, std::size_t n, F& f)
+{
+    for_each_segment(seq, [&](const auto& segment) {
+        if(n < 1) return;
+        auto s = segment;
+        auto m = std::size_t(remaining_size(s));
+        if(m > n) m = n;
+        n -= m;
+        for(; m > 0; --m, ++s) {
+            f(*s);
+        }
+    });
+}
+
+
+}  // namespace seq_detail
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief writes the first (at most) n values of 'seq' to 'out'
+ *        using up to 'threads' threads (0: hardware concurrency)
+ *
+ *        The index range is split into chunks; each chunk starts from
+ *        a copy of 'seq' advanced with operator += and is filled with
+ *        the segmented fill loop.
+ *        If 'out' is a pointer, chunk boundaries are aligned to cache
+ *        lines so that no two threads write to the same line.
+ *
+ * @return iterator one past the last written value
+ *
+ *****************************************************************************/
+template<class Sequence, class RandomAccessIterator>
+RandomAccessIterator
+parallel_fill(const Sequence& seq, RandomAccessIterator out,
+              std::size_t n, std::size_t threads = 0)
+{
+    using value_t = typename std::iterator_traits<
+                        RandomAccessIterator>::value_type;
+
+    n = std::min(n, std::size_t(seq_detail::remaining_size(seq)));
+    if(n < 1) return out;
+
+    threads = seq_detail::default_thread_count(threads);
+
+    const auto unit = seq_detail::elements_per_cache_line<value_t>();
+    const auto part = seq_detail::chunk_partition{n,
+        seq_detail::chunk_grain(n, threads, unit),
+        seq_detail::cache_line_skew(out) % unit};
+
+    using diff_t = typename std::iterator_traits<
+                       RandomAccessIterator>::difference_type;
+
+    seq_detail::work_stealing_pool{threads}.run(part.count(),
+        [&](std::size_t k) {
+            const auto first = part.first(k);
+            const auto last = part.last(k);
+            auto s = seq;
+            s += first;
+            am::fill(s, out + diff_t(first), out + diff_t(last));
+        });
+
+    return out + diff_t(n);
+}
+
+
+
+/*************************************************************************//***
+ *
+ * @brief calls f(value) for each remaining value of 'seq'
+ *        using up to 'threads' threads (0: hardware concurrency);
+ *
+ *        f is invoked concurrently and in unspecified order;
+ *        each chunk is processed with its own copy of 'f'
+ *
+ *****************************************************************************/
+template<class Sequence, class F>
+void
+parallel_for_each(const Sequence& seq, F f, std::size_t threads = 0)
+{
+    const auto n = std::size_t(seq_detail::remaining_size(seq));
+    if(n < 1) return;
+
+    threads = seq_detail::default_thread_count(threads);
+
+    const auto part = seq_detail::chunk_partition{n,
+        seq_detail::chunk_grain(n, threads, 1), 0};
+
+    seq_detail::work_stealing_pool{threads}.run(part.count(),
+        [&](std::size_t k) {
+            const auto first = part.first(k);
+            auto s = seq;
+            s += first;
+            auto g = f;
+            seq_detail::for_each_n(s, part.last(k) - first, g);
+        });
+}
+
+
+}  // namespace am
+
+
+#endif
@@ -0,0 +1,401 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AMLIB_NUMERIC_PERMUTATION_SEQUENCE_H_
+#define AMLIB_NUMERIC_PERMUTATION_SEQUENCE_H_
+
+
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+#include "stats.h"
+
+
+namespace am {
+
+
+namespace seq_detail {
+
+
+//-------------------------------------------------------------------
+inline constexpr std::uint64_t
+factorial(unsigned n) noexcept
+{
+    std::uint64_t f = 1;
+    for(unsigned i = 2; i <= n; ++i) f *= i;
+    return f;
+}
+
+
+
+/*************************************************************************//***
+ *
+ * @brief permutation of up to 16 elements packed in 4 bit nibbles
+ *        of one register
+ *
+ *****************************************************************************/
+template<std::size_t N>
+class nibble_permutation
+{
+    static_assert(N <= 16, "at most 16 elements fit into 64 bits");
+
+public:
+    //---------------------------------------------------------------
+    constexpr nibble_permutation() noexcept: bits_{0} {}
+
+    //---------------------------------------------------------------
+    static nibble_permutation
+    identity() noexcept {
+        nibble_permutation p;
+        for(unsigned i = 0; i < N; ++i) p.bits_ |= std::uint64_t(i) << (4*i);
+        return p;
+    }
+
+    //---------------------------------------------------------------
+    unsigned
+    get(unsigned i) const noexcept {
+        return unsigned(bits_ >> (4*i)) & 0xF;
+    }
+    //-----------------------------------------------------
+    void
+    set(unsigned i, unsigned v) noexcept {
+        bits_ = (bits_ & ~(std::uint64_t(0xF) << (4*i))) |
+                (std::uint64_t(v) << (4*i));
+    }
+
+    //---------------------------------------------------------------
+    /// removes element i; higher elements move down by one position
+    unsigned
+    take(unsigned i) noexcept {
+        const auto v = get(i);
+        const auto low = bits_ & ((std::uint64_t(1) << (4*i)) - 1);
+        const auto high = (4*(i+1) < 64) ? (bits_ >> (4*(i+1))) << (4*i) : 0;
+        bits_ = low | high;
+        return v;
+    }
+
+    //---------------------------------------------------------------
+    std::uint64_t
+    packed() const noexcept {
+        return bits_;
+    }
+
+    //---------------------------------------------------------------
+    friend bool
+    operator == (const nibble_permutation& a, const nibble_permutation& b) noexcept {
+        return a.bits_ == b.bits_;
+    }
+
+private:
+    std::uint64_t bits_;
+};
+
+
+
+/*************************************************************************//***
+ *
+ * @brief permutation with one byte per element
+ *
+ *****************************************************************************/
+template<std::size_t N>
+class byte_permutation
+{
+public:
+    //---------------------------------------------------------------
+    byte_permutation() noexcept: a_{} {}
+
+    //---------------------------------------------------------------
+    static byte_permutation
+    identity() noexcept {
+        byte_permutation p;
+        for(unsigned i = 0; i < N; ++i) p.a_[i] = std::uint8_t(i);
+        return p;
+    }
+
+    //---------------------------------------------------------------
+    unsigned
+    get(unsigned i) const noexcept {
+        return a_[i];
+    }
+    //-----------------------------------------------------
+    void
+    set(unsigned i, unsigned v) noexcept {
+        a_[i] = std::uint8_t(v);
+    }
+
+    //---------------------------------------------------------------
+    /// removes element i; higher elements move down by one position
+    unsigned
+    take(unsigned i) noexcept {
+        const auto v = a_[i];
+        for(; i + 1 < N; ++i) a_[i] = a_[i+1];
+        return v;
+    }
+
+    //---------------------------------------------------------------
+    friend bool
+    operator == (const byte_permutation& a, const byte_permutation& b) noexcept {
+        return a.a_ == b.a_;
+    }
+
+private:
+    std::array<std::uint8_t,N> a_;
+};
+
+
+}  // namespace seq_detail
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief all permutations of 0, ..., N-1 in lexicographic order
+ *
+ *        ++ is the classic next-permutation step;
+ *        [] and += unrank the factoradic representation of the index,
+ *        so the N! permutations can be partitioned among threads
+ *
+ *        N <= 16 is kept in 4 bit nibbles of a single uint64_t
+ *        (removing a nibble from the list of unused elements is a
+ *        shift and mask, so unranking is O(N)); larger N (up to 20,
+ *        since 21! > 2^64) use a byte array
+ *
+ *****************************************************************************/
+template<std::size_t N>
+class permutation_sequence :
+    private seq_stats::tracked<permutation_sequence<N>>
+{
+    static_assert(N <= 20, "permutation_sequence: N! must fit into 64 bits");
+
+    using storage = std::conditional_t<(N <= 16),
+        seq_detail::nibble_permutation<N>, seq_detail::byte_permutation<N>>;
+
+public:
+    //---------------------------------------------------------------
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::array<std::uint8_t,N>;
+    using reference = value_type;
+    using size_type = std::uint64_t;
+    using difference_type = std::int64_t;
+
+    static constexpr std::size_t elements = N;
+
+
+    //---------------------------------------------------------------
+    permutation_sequence() noexcept :
+        idx_{0}, end_{seq_detail::factorial(N)}, perm_{storage::identity()}
+    {}
+
+
+    //---------------------------------------------------------------
+    /// current permutation (unpacked)
+    value_type
+    operator * () const noexcept {
+        return unpack(perm_);
+    }
+    //-----------------------------------------------------
+    value_type
+    operator [] (size_type offset) const noexcept {
+        AMLIB_SEQUENCE_COUNT(subscript);
+        return unpack(unrank(idx_ + offset));
+    }
+    //-----------------------------------------------------
+    /// element i of the current permutation without unpacking
+    unsigned
+    element(unsigned i) const noexcept {
+        return perm_.get(i);
+    }
+
+
+    //---------------------------------------------------------------
+    permutation_sequence&
+    operator ++ () noexcept {
+        AMLIB_SEQUENCE_COUNT(increment);
+        if(++idx_ < end_) next();
+        return *this;
+    }
+    //-----------------------------------------------------
+    permutation_sequence&
+    operator += (size_type offset) noexcept {
+        AMLIB_SEQUENCE_COUNT(advance);
+        idx_ = (offset < (end_ - idx_)) ? (idx_ + offset) : end_;
+        if(idx_ < end_) perm_ = unrank(idx_);
+        return *this;
+    }
+    //-----------------------------------------------------
+    permutation_sequence
+    operator + (size_type offset) const noexcept {
+        auto res = *this;
+        res += offset;
+        return res;
+    }
+
+
+    //---------------------------------------------------------------
+    /// absolute (lexicographic) index of the current permutation
+    size_type
+    index() const noexcept {
+        return idx_;
+    }
+
+    //---------------------------------------------------------------
+    /// lexicographic rank of a permutation of 0..N-1
+    static size_type
+    index_of(const value_type& p) noexcept
+    {
+        size_type r = 0;
+        for(std::size_t i = 0; i < N; ++i) {
+            unsigned smaller = 0;
+            for(std::size_t j = i + 1; j < N; ++j) {
+                if(p[j] < p[i]) ++smaller;
+            }
+            r += smaller * seq_detail::factorial(unsigned(N - 1 - i));
+        }
+        return r;
+    }
+
+
+    //---------------------------------------------------------------
+    bool
+    operator == (const permutation_sequence& o) const noexcept {
+        AMLIB_SEQUENCE_COUNT(compare);
+        return (idx_ == o.idx_) && (end_ == o.end_);
+    }
+    //-----------------------------------------------------
+    bool
+    operator != (const permutation_sequence& o) const noexcept {
+        return !(*this == o);
+    }
+
+
+    //---------------------------------------------------------------
+    size_type
+    size() const noexcept {
+        AMLIB_SEQUENCE_COUNT(size);
+        return end_ - idx_;
+    }
+    //-----------------------------------------------------
+    bool
+    empty() const noexcept {
+        return idx_ >= end_;
+    }
+
+
+    //---------------------------------------------------------------
+    const permutation_sequence&
+    begin() const noexcept {
+        return *this;
+    }
+    //-----------------------------------------------------
+    permutation_sequence
+    end() const noexcept {
+        AMLIB_SEQUENCE_COUNT(end);
+        auto res = *this;
+        res.idx_ = end_;
+        return res;
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    static value_type
+    unpack(const storage& p) noexcept {
+        auto res = value_type{};
+        for(unsigned i = 0; i < N; ++i) res[i] = std::uint8_t(p.get(i));
+        return res;
+    }
+
+    //---------------------------------------------------------------
+    /// factoradic digits of r select from the remaining elements
+    static storage
+    unrank(size_type r) noexcept {
+        auto avail = storage::identity();
+        auto p = storage{};
+        for(unsigned i = 0; i < N; ++i) {
+            const auto f = seq_detail::factorial(unsigned(N - 1 - i));
+            p.set(i, avail.take(unsigned(r / f)));
+            r %= f;
+        }
+        return p;
+    }
+
+    //---------------------------------------------------------------
+    /// lexicographic successor (the current one is not the last)
+    void
+    next() noexcept {
+        int i = int(N) - 2;
+        while(i >= 0 && perm_.get(i) > perm_.get(i+1)) --i;
+        if(i < 0) return;
+        int j = int(N) - 1;
+        const auto pivot = perm_.get(i);
+        while(perm_.get(j) < pivot) --j;
+        perm_.set(i, perm_.get(j));
+        perm_.set(j, pivot);
+        for(int a = i + 1, b = int(N) - 1; a < b; ++a, --b) {
+            const auto x = perm_.get(a);
+            perm_.set(a, perm_.get(b));
+            perm_.set(b, x);
+        }
+    }
+
+
+    //---------------------------------------------------------------
+    size_type idx_;
+    size_type end_;
+    storage perm_;
+};
+
+
+
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+template<std::size_t N>
+inline decltype(auto)
+begin(const permutation_sequence<N>& s) noexcept
+{
+    return s.begin();
+}
+
+//---------------------------------------------------------
+template<std::size_t N>
+inline decltype(auto)
+cbegin(const permutation_sequence<N>& s) noexcept
+{
+    return s.begin();
+}
+
+//---------------------------------------------------------
+template<std::size_t N>
+inline decltype(auto)
+end(const permutation_sequence<N>& s) noexcept
+{
+    return s.end();
+}
+
+//---------------------------------------------------------
+template<std::size_t N>
+inline decltype(auto)
+cend(const permutation_sequence<N>& s) noexcept
+{
+    return s.end();
+}
+
+
+}  // namespace am
+
+
+#endif
@@ -0,0 +1,678 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AMLIB_NUMERIC_PRIME_SEQUENCE_H_
+#define AMLIB_NUMERIC_PRIME_SEQUENCE_H_
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "gray_code.h"
+#include "parallel.h"
+#include "stats.h"
+
+
+namespace am {
+
+
+namespace seq_detail {
+
+
+//-------------------------------------------------------------------
+/// bytes per sieve segment (fits into the L1 data cache)
+constexpr std::size_t prime_segment_bytes = 32 * 1024;
+
+/// numbers covered by one segment (30 per byte)
+constexpr std::uint64_t prime_segment_span = 30 * prime_segment_bytes;
+
+/// largest value the sieve handles
+constexpr std::uint64_t max_sieve_value = std::uint64_t(1) << 62;
+
+
+//-------------------------------------------------------------------
+// mod 30 wheel: one bit per residue coprime to 2, 3 and 5
+constexpr std::uint8_t wheel30_residue[8] = {1, 7, 11, 13, 17, 19, 23, 29};
+
+/// distance to the next residue coprime to 30
+constexpr std::uint8_t wheel30_gap[8] = {6, 4, 2, 4, 2, 4, 6, 2};
+
+/// bit index of residue r or -1
+constexpr std::int8_t wheel30_bit[30] = {
+    -1,  0, -1, -1, -1, -1, -1,  1, -1, -1, -1,  2, -1,  3, -1,
+    -1, -1,  4, -1,  5, -1, -1, -1,  6, -1, -1, -1, -1, -1,  7
+};
+
+/// bits of all residues >= r
+constexpr std::uint8_t wheel30_from[30] = {
+    0xFF, 0xFF, 0xFE, 0xFE, 0xFE, 0xFE, 0xFE, 0xFE, 0xFC, 0xFC,
+    0xFC, 0xFC, 0xF8, 0xF8, 0xF0, 0xF0, 0xF0, 0xF0, 0xE0, 0xE0,
+    0xC0, 0xC0, 0xC0, 0xC0, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80
+};
+
+
+//-------------------------------------------------------------------
+inline int
+popcount(std::uint64_t x) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(x);
+#else
+    int n = 0;
+    for(; x; x &= x - 1) ++n;
+    return n;
+#endif
+}
+
+
+//-------------------------------------------------------------------
+inline std::uint64_t
+isqrt(std::uint64_t n) noexcept
+{
+    auto r = std::uint64_t(std::sqrt(static_cast<long double>(n)));
+    while(r > 0 && r * r > n) --r;
+    while((r+1) * (r+1) <= n) ++r;
+    return r;
+}
+
+
+
+/*************************************************************************//***
+ *
+ * @brief primes 7 <= p <= limit used for crossing off
+ *
+ *****************************************************************************/
+struct sieving_primes
+{
+    std::uint64_t limit = 0;
+    std::vector<std::uint32_t> primes;
+
+    explicit
+    sieving_primes(std::uint64_t lim):
+        limit{lim}, primes{}
+    {
+        auto composite = std::vector<bool>(limit + 1, false);
+        for(std::uint64_t i = 2; i * i <= limit; ++i) {
+            if(composite[i]) continue;
+            for(auto j = i * i; j <= limit; j += i) composite[j] = true;
+        }
+        for(std::uint64_t i = 7; i <= limit; ++i) {
+            if(!composite[i]) primes.push_back(std::uint32_t(i));
+        }
+    }
+};
+
+
+
+/*************************************************************************//***
+ *
+ * @brief bit-packed, mod 30 wheel sieve of the numbers [base,hi);
+ *        base is a multiple of 30;
+ *        bit b of byte i stands for  base + 30*i + wheel30_residue[b]
+ *
+ *****************************************************************************/
+class prime_segment
+{
+public:
+    //---------------------------------------------------------------
+    prime_segment(std::uint64_t base, std::uint64_t hi,
+                  const sieving_primes& sp)
+    :
+        base_{base}, hi_{hi}, bits_((hi - base + 29) / 30, 0xFF)
+    {
+        if(bits_.empty()) return;
+
+        if(base_ == 0) bits_[0] &= 0xFE;  //1 is not prime
+
+        for(auto p : sp.primes) {
+            const std::uint64_t pp = std::uint64_t(p) * p;
+            if(pp >= hi_) break;
+            //smallest multiplier k >= p with p*k >= base, k coprime to 30
+            auto k = std::max(std::uint64_t(p), (base_ + p - 1) / p);
+            while(wheel30_bit[k % 30] < 0) ++k;
+            auto w = wheel30_bit[k % 30];
+            for(auto m = p * k; m < hi_; m += p * wheel30_gap[w], w = (w+1) & 7) {
+                const auto off = m - base_;
+                bits_[off / 30] &= std::uint8_t(~(1u << wheel30_bit[off % 30]));
+            }
+        }
+
+        //numbers >= hi in the last byte
+        const auto last = bits_.size() - 1;
+        for(int b = 0; b < 8; ++b) {
+            if(base_ + 30 * last + wheel30_residue[b] >= hi_) {
+                bits_[last] &= std::uint8_t(~(1u << b));
+            }
+        }
+    }
+
+
+    //---------------------------------------------------------------
+    std::uint64_t base() const noexcept { return base_; }
+    std::uint64_t hi()   const noexcept { return hi_; }
+
+
+    //---------------------------------------------------------------
+    /// smallest prime >= from in this segment; 0 if there is none
+    std::uint64_t
+    next(std::uint64_t from) const noexcept
+    {
+        if(from < base_) from = base_;
+        if(from >= hi_) return 0;
+        const auto off = from - base_;
+        auto i = std::size_t(off / 30);
+        unsigned b = bits_[i] & wheel30_from[off % 30];
+        if(!b) {
+            const auto n = bits_.size();
+            for(++i; i + 8 <= n && word(i) == 0; i += 8) {}
+            for(; i < n && bits_[i] == 0; ++i) {}
+            if(i >= n) return 0;
+            b = bits_[i];
+        }
+        return base_ + 30 * i + wheel30_residue[trailing_zeros(b)];
+    }
+
+    //---------------------------------------------------------------
+    /// writes up to 'max' ascending primes >= from of this segment to 'out'
+    template<class T>
+    std::size_t
+    collect(std::uint64_t from, T* out, std::size_t max) const noexcept
+    {
+        if(from < base_) from = base_;
+        if(from >= hi_ || max < 1) return 0;
+        const auto off = from - base_;
+        const auto n = bits_.size();
+        auto i = std::size_t(off / 30);
+        unsigned b = bits_[i] & wheel30_from[off % 30];
+        std::size_t k = 0;
+        while(true) {
+            for(; b != 0 && k < max; b &= b - 1) {
+                out[k++] = T(base_ + 30 * i + wheel30_residue[trailing_zeros(b)]);
+            }
+            if(k >= max || ++i >= n) return k;
+            b = bits_[i];
+        }
+    }
+
+    //---------------------------------------------------------------
+    /// number of primes >= from in this segment
+    std::uint64_t
+    count_from(std::uint64_t from) const noexcept
+    {
+        if(from < base_) from = base_;
+        if(from >= hi_) return 0;
+        const auto off = from - base_;
+        auto i = std::size_t(off / 30);
+        std::uint64_t c = popcount(bits_[i] & wheel30_from[off % 30]);
+        const auto n = bits_.size();
+        for(++i; i + 8 <= n; i += 8) c += popcount(word(i));
+        for(; i < n; ++i) c += popcount(bits_[i]);
+        return c;
+    }
+
+
+private:
+    std::uint64_t
+    word(std::size_t i) const noexcept {
+        std::uint64_t w;
+        std::memcpy(&w, bits_.data() + i, sizeof(w));
+        return w;
+    }
+
+    std::uint64_t base_;
+    std::uint64_t hi_;
+    std::vector<std::uint8_t> bits_;
+};
+
+
+//-------------------------------------------------------------------
+template<class T>
+constexpr std::uint64_t
+max_prime_value() noexcept
+{
+    return (std::uint64_t(std::numeric_limits<T>::max()) < max_sieve_value)
+           ? std::uint64_t(std::numeric_limits<T>::max()) : max_sieve_value;
+}
+
+
+}  // namespace seq_detail
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief ascending primes in [first,last]
+ *
+ *        produced lazily by a segmented sieve of Eratosthenes
+ *        (mod 30 wheel, 8 numbers per byte, L1-sized segments);
+ *        a segment is sieved only when it is reached, so starting at a
+ *        large 'first' only sieves the segment that contains it
+ *
+ *        += and [] skip whole segments by counting bits;
+ *        size() has to sieve the remaining range
+ *
+ *        values are limited to 2^62
+ *
+ *****************************************************************************/
+template<class T = std::uint64_t>
+class prime_sequence :
+    private seq_stats::tracked<prime_sequence<T>>
+{
+    static_assert(std::is_integral<T>::value,
+                  "prime_sequence requires an integral value type");
+
+    using segment = seq_detail::prime_segment;
+    using sieving = seq_detail::sieving_primes;
+
+public:
+    //---------------------------------------------------------------
+    using iterator_category = std::input_iterator_tag;
+    using value_type = T;
+    using reference = const value_type&;
+    using pointer = const value_type*;
+    using size_type = std::uint64_t;
+    using difference_type = std::int64_t;
+
+
+    //---------------------------------------------------------------
+    explicit
+    prime_sequence(value_type first = value_type(2),
+                   value_type last = std::numeric_limits<value_type>::max())
+    :
+        last_{0}, cur_{0}, done_{false}, sieving_{}, seg_{}
+    {
+        const auto maxv = seq_detail::max_prime_value<T>();
+        last_ = (last >= value_type(2)) ? std::min(std::uint64_t(last), maxv) : 0;
+        seek((first < value_type(2)) ? 2 : std::uint64_t(first));
+    }
+
+
+    //---------------------------------------------------------------
+    reference
+    operator * () const noexcept {
+        return cur_;
+    }
+    //-----------------------------------------------------
+    pointer
+    operator -> () const noexcept {
+        return std::addressof(cur_);
+    }
+    //-----------------------------------------------------
+    value_type
+    operator [] (size_type offset) const {
+        AMLIB_SEQUENCE_COUNT(subscript);
+        auto res = *this;
+        res.advance(offset);
+        return res.cur_;
+    }
+
+
+    //---------------------------------------------------------------
+    prime_sequence&
+    operator ++ () {
+        AMLIB_SEQUENCE_COUNT(increment);
+        seek(std::uint64_t(cur_) + 1);
+        return *this;
+    }
+    //-----------------------------------------------------
+    prime_sequence&
+    operator += (size_type offset) {
+        AMLIB_SEQUENCE_COUNT(advance);
+        advance(offset);
+        return *this;
+    }
+    //-----------------------------------------------------
+    prime_sequence
+    operator + (size_type offset) const {
+        auto res = *this;
+        res += offset;
+        return res;
+    }
+    //-----------------------------------------------------
+    /**
+     * @brief writes up to 'max' primes to 'out' and advances past them;
+     *        reads the bits of whole segments instead of seeking
+     *        prime by prime
+     */
+    size_type
+    next_batch(value_type* out, size_type max)
+    {
+        size_type n = 0;
+        while(n < max && !done_) {
+            out[n++] = cur_;
+            auto x = std::uint64_t(cur_) + 1;
+            if(cur_ >= value_type(7) && n < max) {
+                n += seg_->collect(x, out + n, max - n);
+                //segment exhausted or batch full
+                x = (n < max) ? seg_->hi() : std::uint64_t(out[n-1]) + 1;
+            }
+            seek(x);
+        }
+        return n;
+    }
+
+
+    //---------------------------------------------------------------
+    bool
+    operator == (const prime_sequence& o) const noexcept {
+        AMLIB_SEQUENCE_COUNT(compare);
+        return (last_ == o.last_) && (done_ == o.done_) &&
+               (done_ || cur_ == o.cur_);
+    }
+    //-----------------------------------------------------
+    bool
+    operator != (const prime_sequence& o) const noexcept {
+        return !(*this == o);
+    }
+
+
+    //---------------------------------------------------------------
+    /// number of remaining primes; sieves the remaining range
+    size_type
+    size() const {
+        AMLIB_SEQUENCE_COUNT(size);
+        size_type n = 0;
+        for(auto s = *this; !s.done_; ) {
+            if(s.cur_ < value_type(7)) {
+                ++n;
+                s.seek(std::uint64_t(s.cur_) + 1);
+            }
+            else {
+                n += 1 + s.seg_->count_from(std::uint64_t(s.cur_) + 1);
+                s.seek(s.seg_->hi());
+            }
+        }
+        return n;
+    }
+    //-----------------------------------------------------
+    bool
+    empty() const noexcept {
+        return done_;
+    }
+
+
+    //---------------------------------------------------------------
+    const prime_sequence&
+    begin() const noexcept {
+        return *this;
+    }
+    //-----------------------------------------------------
+    prime_sequence
+    end() const noexcept {
+        AMLIB_SEQUENCE_COUNT(end);
+        auto res = *this;
+        res.done_ = true;
+        res.cur_ = value_type(0);
+        res.seg_.reset();
+        return res;
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    /// moves to the smallest prime >= x
+    void
+    seek(std::uint64_t x)
+    {
+        if(x > last_) { done_ = true; return; }
+
+        if(x <= 5) {
+            const std::uint64_t p = (x <= 2) ? 2 : (x <= 3) ? 3 : 5;
+            if(p <= last_) { cur_ = value_type(p); return; }
+            done_ = true;
+            return;
+        }
+
+        while(true) {
+            if(!seg_ || x < seg_->base() || x >= seg_->hi()) load(x);
+            const auto p = seg_->next(x);
+            if(p > 0) { cur_ = value_type(p); return; }
+            x = seg_->hi();
+            if(x > last_) { done_ = true; return; }
+        }
+    }
+
+    //---------------------------------------------------------------
+    /// sieves the segment containing x
+    void
+    load(std::uint64_t x)
+    {
+        const auto base = x - (x % 30);
+        const auto hi = std::min(base + seq_detail::prime_segment_span, last_ + 1);
+        const auto need = seq_detail::isqrt(hi - 1);
+        if(!sieving_ || sieving_->limit < need) {
+            auto lim = std::max(need, 2 * (sieving_ ? sieving_->limit : 0));
+            lim = std::min(lim, seq_detail::isqrt(seq_detail::max_sieve_value));
+            sieving_ = std::make_shared<const sieving>(std::max(lim, need));
+        }
+        seg_ = std::make_shared<const segment>(base, hi, *sieving_);
+    }
+
+    //---------------------------------------------------------------
+    void
+    advance(size_type k)
+    {
+        while(k > 0 && !done_) {
+            if(cur_ < value_type(7)) {
+                seek(std::uint64_t(cur_) + 1);
+                --k;
+                continue;
+            }
+            const auto c = seg_->count_from(std::uint64_t(cur_) + 1);
+            if(k <= c) {
+                for(; k > 0; --k) seek(std::uint64_t(cur_) + 1);
+                return;
+            }
+            //skip the rest of the segment
+            k -= c + 1;
+            seek(seg_->hi());
+        }
+    }
+
+
+    //---------------------------------------------------------------
+    std::uint64_t last_;
+    value_type cur_;
+    bool done_;
+    std::shared_ptr<const sieving> sieving_;
+    std::shared_ptr<const segment> seg_;
+};
+
+
+
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+template<class T>
+inline decltype(auto)
+begin(const prime_sequence<T>& s) noexcept
+{
+    return s.begin();
+}
+
+//---------------------------------------------------------
+template<class T>
+inline decltype(auto)
+cbegin(const prime_sequence<T>& s) noexcept
+{
+    return s.begin();
+}
+
+//---------------------------------------------------------
+template<class T>
+inline decltype(auto)
+end(const prime_sequence<T>& s) noexcept
+{
+    return s.end();
+}
+
+//---------------------------------------------------------
+template<class T>
+inline decltype(auto)
+cend(const prime_sequence<T>& s) noexcept
+{
+    return s.end();
+}
+
+
+
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+template<class T>
+inline auto
+make_prime_sequence(T first, T last)
+{
+    return prime_sequence<T>{first, last};
+}
+
+
+
+
+namespace seq_detail {
+
+/*************************************************************************//***
+ *
+ * @brief partition of [first,last] (without 2, 3 and 5)
+ *        into independent sieve segments
+ *
+ *****************************************************************************/
+struct prime_segment_plan
+{
+    std::uint64_t lo = 0;
+    std::uint64_t last = 0;
+    std::uint64_t base = 0;
+    std::size_t count = 0;
+
+    prime_segment_plan(std::uint64_t first, std::uint64_t l):
+        lo{std::max(first, std::uint64_t(7))},
+        last{std::min(l, max_sieve_value)}
+    {
+        if(lo > last) return;
+        base = lo - (lo % 30);
+        count = std::size_t((last - base) / prime_segment_span + 1);
+    }
+
+    /**
+     * @brief calls f(i, segment, from) for all segments
+     *        on up to 'threads' threads
+     */
+    template<class F>
+    void
+    run(std::size_t threads, F&& f) const
+    {
+        if(count < 1) return;
+        const sieving_primes sp{isqrt(last)};
+
+        work_stealing_pool{default_thread_count(threads)}.run(count,
+            [&](std::size_t i) {
+                const auto b = base + i * prime_segment_span;
+                const auto h = std::min(b + prime_segment_span, last + 1);
+                f(i, prime_segment{b, h, sp}, std::max(b, lo));
+            });
+    }
+};
+
+}  // namespace seq_detail
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief number of primes in [first,last];
+ *        segments are sieved independently on up to 'threads' threads
+ *        (0: hardware concurrency)
+ *
+ *****************************************************************************/
+inline std::uint64_t
+count_primes(std::uint64_t first, std::uint64_t last, std::size_t threads = 0)
+{
+    if(first > last) return 0;
+
+    std::uint64_t n = 0;
+    for(std::uint64_t p : {2, 3, 5}) {
+        if(p >= first && p <= last) ++n;
+    }
+
+    const auto plan = seq_detail::prime_segment_plan{first, last};
+    auto counts = std::vector<std::uint64_t>(plan.count, 0);
+    plan.run(threads,
+        [&](std::size_t i, const seq_detail::prime_segment& s, std::uint64_t from) {
+            counts[i] = s.count_from(from);
+        });
+
+    for(auto c : counts) n += c;
+    return n;
+}
+
+
+
+/*************************************************************************//***
+ *
+ * @brief all primes in [first,last] in ascending order;
+ *        segments are sieved independently on up to 'threads' threads
+ *        (0: hardware concurrency)
+ *
+ *****************************************************************************/
+template<class T = std::uint64_t>
+std::vector<T>
+collect_primes(T first, T last, std::size_t threads = 0)
+{
+    static_assert(std::is_integral<T>::value,
+                  "collect_primes requires an integral value type");
+
+    auto res = std::vector<T>{};
+    if(first > last || last < T(2)) return res;
+
+    const auto lo = (first < T(2)) ? std::uint64_t(2) : std::uint64_t(first);
+    const auto hi = std::uint64_t(last);
+
+    for(std::uint64_t p : {2, 3, 5}) {
+        if(p >= lo && p <= hi) res.push_back(T(p));
+    }
+
+    const auto plan = seq_detail::prime_segment_plan{lo, hi};
+    auto parts = std::vector<std::vector<T>>(plan.count);
+    plan.run(threads,
+        [&](std::size_t i, const seq_detail::prime_segment& s, std::uint64_t from) {
+            auto& v = parts[i];
+            v.reserve(std::size_t(s.count_from(from)));
+            for(auto p = s.next(from); p > 0; p = s.next(p + 1)) {
+                v.push_back(T(p));
+            }
+        });
+
+    std::size_t total = res.size();
+    for(const auto& v : parts) total += v.size();
+    res.reserve(total);
+    for(const auto& v : parts) res.insert(res.end(), v.begin(), v.end());
+    return res;
+}
+
+
+}  // namespace am
+
+
+#endif
@@ -0,0 +1,336 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AMLIB_NUMERIC_RANDOM_SEQUENCE_H_
+#define AMLIB_NUMERIC_RANDOM_SEQUENCE_H_
+
+
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+#include "stats.h"
+
+
+namespace am {
+
+
+namespace seq_detail {
+
+
+//-------------------------------------------------------------------
+/// SplitMix64 finalizer (bijective 64 bit mixing function)
+inline constexpr std::uint64_t
+splitmix64(std::uint64_t z) noexcept
+{
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+
+//-------------------------------------------------------------------
+/// uniform integer in the full range of T
+template<class T>
+inline constexpr std::enable_if_t<std::is_integral<T>::value &&
+                                  !std::is_same<T,bool>::value,T>
+bits_to_uniform(std::uint64_t x) noexcept
+{
+    return T(x >> (64 - (std::numeric_limits<std::make_unsigned_t<T>>::digits)));
+}
+
+//---------------------------------------------------------
+/// fair coin flip from the highest bit
+template<class T>
+inline constexpr std::enable_if_t<std::is_same<T,bool>::value,T>
+bits_to_uniform(std::uint64_t x) noexcept
+{
+    return (x >> 63) != 0;
+}
+
+//---------------------------------------------------------
+/// uniform floating-point value in [0,1)
+template<class T>
+inline constexpr std::enable_if_t<std::is_floating_point<T>::value,T>
+bits_to_uniform(std::uint64_t x) noexcept
+{
+    //use as many high bits as the mantissa can hold exactly
+    constexpr int digits = (std::numeric_limits<T>::digits < 64)
+                         ? std::numeric_limits<T>::digits : 64;
+    return T(x >> (64 - digits)) * (T(1) / T(std::uint64_t(1) << (digits - 1)) / T(2));
+}
+
+
+}  // namespace seq_detail
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief counter-based pseudo-random sequence
+ *
+ *        value i is a pure function of (seed, i):
+ *        SplitMix64 mixing of  mix(seed) + (i+1) * golden ratio
+ *
+ *        integral T: uniform in the full range of T
+ *        bool: fair coin flips
+ *        floating-point T: uniform in [0,1)
+ *
+ *        O(1) operator[] and +=, so the sequence can be split, jumped
+ *        and used in parallel algorithms
+ *
+ *****************************************************************************/
+template<class T = std::uint64_t>
+class random_sequence :
+    private seq_stats::tracked<random_sequence<T>>
+{
+    static_assert(std::is_arithmetic<T>::value,
+                  "random_sequence requires an arithmetic value type");
+
+    static constexpr std::uint64_t gamma = 0x9E3779B97F4A7C15ull;
+
+public:
+    //---------------------------------------------------------------
+    using iterator_category = std::input_iterator_tag;
+    using value_type = T;
+    using size_type = std::uint64_t;
+    using difference_type = std::int64_t;
+
+
+    //---------------------------------------------------------------
+    constexpr explicit
+    random_sequence(
+        std::uint64_t seed = 0,
+        size_type count = std::numeric_limits<size_type>::max())
+    :
+        key_{seq_detail::splitmix64(seed + gamma)}, seed_{seed},
+        idx_{0}, end_{count}
+    {}
+
+
+    //---------------------------------------------------------------
+    value_type
+    operator * () const noexcept {
+        return value_at(idx_);
+    }
+    //-----------------------------------------------------
+    value_type
+    operator [] (size_type offset) const noexcept {
+        AMLIB_SEQUENCE_COUNT(subscript);
+        return value_at(idx_ + offset);
+    }
+
+
+    //---------------------------------------------------------------
+    random_sequence&
+    operator ++ () noexcept {
+        AMLIB_SEQUENCE_COUNT(increment);
+        ++idx_;
+        return *this;
+    }
+    //-----------------------------------------------------
+    random_sequence&
+    operator += (size_type offset) noexcept {
+        AMLIB_SEQUENCE_COUNT(advance);
+        idx_ = (offset < (end_ - idx_)) ? (idx_ + offset) : end_;
+        return *this;
+    }
+    //-----------------------------------------------------
+    random_sequence
+    operator + (size_type offset) const noexcept {
+        auto res = *this;
+        res += offset;
+        return res;
+    }
+    //-----------------------------------------------------
+    /// writes up to 'max' values to 'out' and advances past them
+    size_type
+    next_batch(value_type* out, size_type max) noexcept {
+        const auto n = size_type(generate(out, max) - out);
+        *this += n;
+        return n;
+    }
+
+
+    //---------------------------------------------------------------
+    std::uint64_t
+    seed() const noexcept {
+        return seed_;
+    }
+    //-----------------------------------------------------
+    /// absolute index of the current value
+    size_type
+    index() const noexcept {
+        return idx_;
+    }
+
+
+    //---------------------------------------------------------------
+    /**
+     * @brief writes the next n values (at most size()) to 'out';
+     *        values don't depend on each other, so the loop is
+     *        vectorized by the compiler
+     * @return pointer one past the last written value
+     */
+    value_type*
+    generate(value_type* out, size_type n) const noexcept
+    {
+        if(n > size()) n = size();
+        const auto base = idx_;
+        for(size_type i = 0; i < n; ++i) {
+            out[i] = value_at(base + i);
+        }
+        return out + n;
+    }
+    //-----------------------------------------------------
+    /**
+     * @brief writes all remaining values to 'out'
+     */
+    template<class OutputIterator>
+    OutputIterator
+    copy_to(OutputIterator out) const
+    {
+        for(auto i = idx_; i < end_; ++i, ++out) {
+            *out = value_at(i);
+        }
+        return out;
+    }
+    //-----------------------------------------------------
+    value_type*
+    copy_to(value_type* out) const noexcept
+    {
+        return generate(out, size());
+    }
+
+
+    //---------------------------------------------------------------
+    bool
+    operator == (const random_sequence& o) const noexcept {
+        AMLIB_SEQUENCE_COUNT(compare);
+        return (idx_ == o.idx_) && (end_ == o.end_) && (key_ == o.key_);
+    }
+    //-----------------------------------------------------
+    bool
+    operator != (const random_sequence& o) const noexcept {
+        return !(*this == o);
+    }
+
+
+    //---------------------------------------------------------------
+    size_type
+    size() const noexcept {
+        AMLIB_SEQUENCE_COUNT(size);
+        return end_ - idx_;
+    }
+    //-----------------------------------------------------
+    bool
+    empty() const noexcept {
+        return idx_ >= end_;
+    }
+    //-----------------------------------------------------
+    explicit operator
+    bool() const noexcept {
+        return !empty();
+    }
+
+
+    //---------------------------------------------------------------
+    const random_sequence&
+    begin() const noexcept {
+        return *this;
+    }
+    //-----------------------------------------------------
+    random_sequence
+    end() const noexcept {
+        AMLIB_SEQUENCE_COUNT(end);
+        auto res = *this;
+        res.idx_ = end_;
+        return res;
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    value_type
+    value_at(size_type i) const noexcept {
+        return seq_detail::bits_to_uniform<T>(
+            seq_detail::splitmix64(key_ + (i + 1) * gamma));
+    }
+
+
+    //---------------------------------------------------------------
+    std::uint64_t key_;
+    std::uint64_t seed_;
+    size_type idx_;
+    size_type end_;
+};
+
+
+
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+template<class T>
+inline decltype(auto)
+begin(const random_sequence<T>& s) noexcept
+{
+    return s.begin();
+}
+
+//---------------------------------------------------------
+template<class T>
+inline decltype(auto)
+cbegin(const random_sequence<T>& s) noexcept
+{
+    return s.begin();
+}
+
+//---------------------------------------------------------
+template<class T>
+inline decltype(auto)
+end(const random_sequence<T>& s) noexcept
+{
+    return s.end();
+}
+
+//---------------------------------------------------------
+template<class T>
+inline decltype(auto)
+cend(const random_sequence<T>& s) noexcept
+{
+    return s.end();
+}
+
+
+
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+template<class T = std::uint64_t>
+inline constexpr auto
+make_random_sequence(std::uint64_t seed,
+                     std::uint64_t count = std::numeric_limits<std::uint64_t>::max())
+{
+    return random_sequence<T>{seed, count};
+}
+
+
+}  // namespace am
+
+
+#endif
@@ -0,0 +1,300 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AMLIB_NUMERIC_SEQUENCE_RANGES_H_
+#define AMLIB_NUMERIC_SEQUENCE_RANGES_H_
+
+
+#include "concepts.h"
+
+#if defined(__has_include)
+#  if __has_include(<version>)
+#    include <version>
+#  endif
+#endif
+
+
+/*****************************************************************************
+ *
+ * C++20 ranges integration; only available if the standard library
+ * provides <ranges> and the compiler supports concepts
+ *
+ *****************************************************************************/
+#if AMLIB_SEQUENCE_CONCEPTS && defined(__cpp_lib_ranges)
+
+#define AMLIB_SEQUENCE_RANGES 1
+
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include "segmented.h"
+
+
+namespace am {
+
+
+namespace seq_detail {
+
+/*************************************************************************//***
+ *
+ * @brief random access iterator over a random access sequence;
+ *        holds a copy of the sequence and an index;
+ *        values are produced by the sequence's operator[]
+ *
+ *****************************************************************************/
+template<RandomAccessSequence S>
+class sequence_index_iterator
+{
+public:
+    //---------------------------------------------------------------
+    using iterator_concept = std::random_access_iterator_tag;
+    //values are returned by value
+    using iterator_category = std::input_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = std::remove_cvref_t<
+                           decltype(std::declval<const S&>()[0])>;
+
+
+    //---------------------------------------------------------------
+    sequence_index_iterator() = default;
+
+    //-----------------------------------------------------
+    explicit
+    sequence_index_iterator(const S& s, difference_type i):
+        s_{s}, i_{i}
+    {}
+
+
+    //---------------------------------------------------------------
+    value_type
+    operator * () const {
+        return s_[typename S::size_type(i_)];
+    }
+    //-----------------------------------------------------
+    value_type
+    operator [] (difference_type n) const {
+        return s_[typename S::size_type(i_ + n)];
+    }
+
+
+    //---------------------------------------------------------------
+    sequence_index_iterator& operator ++ () noexcept { ++i_; return *this; }
+    sequence_index_iterator& operator -- () noexcept { --i_; return *this; }
+
+    sequence_index_iterator operator ++ (int) { auto t = *this; ++i_; return t; }
+    sequence_index_iterator operator -- (int) { auto t = *this; --i_; return t; }
+
+    //-----------------------------------------------------
+    sequence_index_iterator&
+    operator += (difference_type n) noexcept { i_ += n; return *this; }
+
+    sequence_index_iterator&
+    operator -= (difference_type n) noexcept { i_ -= n; return *this; }
+
+    //-----------------------------------------------------
+    friend sequence_index_iterator
+    operator + (sequence_index_iterator it, difference_type n) {
+        return it += n;
+    }
+    friend sequence_index_iterator
+    operator + (difference_type n, sequence_index_iterator it) {
+        return it += n;
+    }
+    friend sequence_index_iterator
+    operator - (sequence_index_iterator it, difference_type n) {
+        return it -= n;
+    }
+    friend difference_type
+    operator - (const sequence_index_iterator& a,
+                const sequence_index_iterator& b) noexcept
+    {
+        return a.i_ - b.i_;
+    }
+
+
+    //---------------------------------------------------------------
+    friend bool
+    operator == (const sequence_index_iterator& a,
+                 const sequence_index_iterator& b) noexcept
+    {
+        return a.i_ == b.i_;
+    }
+    //-----------------------------------------------------
+    friend auto
+    operator <=> (const sequence_index_iterator& a,
+                  const sequence_index_iterator& b) noexcept
+    {
+        return a.i_ <=> b.i_;
+    }
+
+
+private:
+    S s_;
+    difference_type i_ = 0;
+};
+
+
+
+/*************************************************************************//***
+ *
+ * @brief input iterator over any sequence; ends at std::default_sentinel
+ *
+ *****************************************************************************/
+template<Sequence S>
+class sequence_input_iterator
+{
+public:
+    //---------------------------------------------------------------
+    using iterator_concept = std::input_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = std::remove_cvref_t<decltype(*std::declval<const S&>())>;
+
+
+    //---------------------------------------------------------------
+    sequence_input_iterator() = default;
+
+    //-----------------------------------------------------
+    explicit
+    sequence_input_iterator(const S& s): s_{s} {}
+
+
+    //---------------------------------------------------------------
+    value_type
+    operator * () const {
+        return *s_;
+    }
+
+    //-----------------------------------------------------
+    sequence_input_iterator& operator ++ () { ++s_; return *this; }
+    void operator ++ (int) { ++s_; }
+
+
+    //---------------------------------------------------------------
+    friend bool
+    operator == (const sequence_input_iterator& it, std::default_sentinel_t) {
+        return it.s_.empty();
+    }
+
+
+private:
+    S s_;
+};
+
+}  // namespace seq_detail
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief std::ranges::view over a sequence generator
+ *
+ *        models random_access_range + sized_range if the sequence
+ *        provides operator[] and size(), otherwise input_range
+ *
+ *        iterators hold copies of the sequence, so sequence_view is
+ *        a borrowed range
+ *
+ *****************************************************************************/
+template<Sequence S>
+class sequence_view :
+    public std::ranges::view_interface<sequence_view<S>>
+{
+public:
+    //---------------------------------------------------------------
+    using sequence_type = S;
+
+
+    //---------------------------------------------------------------
+    sequence_view() requires std::default_initializable<S> = default;
+
+    //-----------------------------------------------------
+    explicit
+    sequence_view(S s): s_{std::move(s)} {}
+
+
+    //---------------------------------------------------------------
+    auto
+    begin() const {
+        if constexpr(RandomAccessSequence<S>) {
+            return seq_detail::sequence_index_iterator<S>{s_, 0};
+        } else {
+            return seq_detail::sequence_input_iterator<S>{s_};
+        }
+    }
+    //-----------------------------------------------------
+    auto
+    end() const {
+        if constexpr(RandomAccessSequence<S>) {
+            return seq_detail::sequence_index_iterator<S>{s_,
+                       std::ptrdiff_t(seq_detail::remaining_size(s_))};
+        } else {
+            return std::default_sentinel;
+        }
+    }
+
+    //-----------------------------------------------------
+    std::size_t
+    size() const requires SizedSequence<S> {
+        return std::size_t(seq_detail::remaining_size(s_));
+    }
+
+    //-----------------------------------------------------
+    const S&
+    base() const noexcept {
+        return s_;
+    }
+
+
+private:
+    S s_;
+};
+
+
+//-------------------------------------------------------------------
+template<class S>
+sequence_view(S) -> sequence_view<S>;
+
+
+
+//-------------------------------------------------------------------
+/**
+ * @brief makes a std::ranges::view from a sequence generator
+ */
+template<class S>
+    requires Sequence<std::decay_t<S>>
+inline auto
+as_view(S&& s)
+{
+    return sequence_view<std::decay_t<S>>{std::forward<S>(s)};
+}
+
+
+}  // namespace am
+
+
+
+//-------------------------------------------------------------------
+template<class S>
+inline constexpr bool
+std::ranges::enable_borrowed_range<am::sequence_view<S>> = true;
+
+
+#else
+
+#define AMLIB_SEQUENCE_RANGES 0
+
+#endif
+
+
+#endif
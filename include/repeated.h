@@ -12,22 +12,105 @@
 #define AMLIB_NUMERIC_REPEATED_SEQUENCE_H_
 
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <iterator>
+#include <memory>
 #include <type_traits>
+#include <vector>
 #include <cmath>
 
+#include "concepts.h"
+#include "segmented.h"
+#include "stats.h"
+
 
 namespace am {
 
 
 /*****************************************************************************
  *
+ * @brief repetition storage policies
  *
+ * copy_period:    replays the repeated sequence by copying and re-running it
+ * memoize_period: materializes one period into a buffer once and
+ *                 serves all later repetitions from that buffer
+ * share_period:   keeps the immutable repetition parameters in one block
+ *                 that is shared between copies; only the cursor state
+ *                 (current sequence + repetition count) is stored inline
  *
  *****************************************************************************/
-template<class Sequence>
-class repeated_sequence
+struct copy_period {};
+struct memoize_period {};
+struct share_period {};
+
+
+
+namespace seq_detail {
+
+/*************************************************************************//***
+ *
+ * @brief writes 'count' copies of period[0,n) to 'out' using memcpy
+ *        on an ever doubling prefix of the output
+ *
+ *****************************************************************************/
+template<class T>
+inline std::enable_if_t<std::is_trivially_copyable<T>::value,T*>
+replicate(const T* period, std::size_t n, std::size_t count, T* out)
+{
+    const auto total = n * count;
+    if(total < 1) return out;
+
+    std::memcpy(out, period, n * sizeof(T));
+    for(std::size_t done = n; done < total; ) {
+        const auto chunk = std::min(done, total - done);
+        std::memcpy(out + done, out, chunk * sizeof(T));
+        done += chunk;
+    }
+    return out + total;
+}
+
+//---------------------------------------------------------
+template<class T>
+inline std::enable_if_t<!std::is_trivially_copyable<T>::value,T*>
+replicate(const T* period, std::size_t n, std::size_t count, T* out)
+{
+    for(; count > 0; --count) {
+        out = std::copy(period, period + n, out);
+    }
+    return out;
+}
+
+//---------------------------------------------------------
+template<class T, class OutputIterator>
+inline OutputIterator
+replicate(const T* period, std::size_t n, std::size_t count,
+          OutputIterator out)
+{
+    for(; count > 0; --count) {
+        out = std::copy(period, period + n, out);
+    }
+    return out;
+}
+
+}  // namespace seq_detail
+
+
+
+
+
+
+
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+template<class Sequence, class Storage = copy_period>
+class repeated_sequence :
+    private seq_stats::tracked<repeated_sequence<Sequence,Storage>>
 {
 public:
     //---------------------------------------------------------------
@@ -77,9 +160,12 @@ public:
     value_type
     operator [] (size_type offset) const
     {
-        const auto nfst = curSequ_.size();
-        if(offset >= nfst) {
-            return repSequ_[(offset-nfst) % repSequ_.size()];
+        AMLIB_SEQUENCE_COUNT(subscript);
+        const auto nfst = seq_detail::remaining_size(curSequ_);
+        const auto nrep = seq_detail::remaining_size(repSequ_);
+        //empty repeat sequence: nothing beyond the first pass
+        if(offset >= nfst && nrep > 0) {
+            return repSequ_[(offset-nfst) % nrep];
         }
         return curSequ_[offset];
     }
@@ -89,10 +175,13 @@ public:
     repeated_sequence&
     operator ++ ()
     {
+        AMLIB_SEQUENCE_COUNT(increment);
         ++curSequ_;
         if(curSequ_.empty() && (reps_ < maxReps_)) {
             ++reps_;
             curSequ_ = repSequ_;
+            //empty repeat sequence: no further passes
+            if(curSequ_.empty()) reps_ = maxReps_;
         }
         return *this;
     }
@@ -100,18 +189,26 @@ public:
     repeated_sequence&
     operator += (size_type offset)
     {
-        if(offset >= curSequ_.size()) {
-            offset -= curSequ_.size();
-            reps_ += offset / repSequ_.size();
-            if(reps_ <= maxReps_) {
-                offset %= repSequ_.size();
-                curSequ_ = repSequ_;
-                curSequ_ += offset;
-            } else {
-                curSequ_ += curSequ_.size();
-            }
-        } else {
+        AMLIB_SEQUENCE_COUNT(advance);
+        const auto nfst = seq_detail::remaining_size(curSequ_);
+        if(offset < nfst) {
             curSequ_ += offset;
+            return *this;
+        }
+        offset -= nfst;
+        const auto nrep = seq_detail::remaining_size(repSequ_);
+        if(nrep < 1) {
+            *this = end();
+            return *this;
+        }
+        const auto k = offset / nrep;
+
+        if((reps_ + k) < maxReps_) {
+            reps_ += k + 1;
+            curSequ_ = repSequ_;
+            curSequ_ += offset % nrep;
+        } else {
+            *this = end();
         }
         return *this;
     }
@@ -122,6 +219,28 @@ public:
         res += offset;
         return res;
     }
+    //-----------------------------------------------------
+    /**
+     * @brief writes up to 'max' values to 'out' and advances past them;
+     *        uses the batch kernels of the underlying sequences
+     */
+    size_type
+    next_batch(value_type* out, size_type max)
+    {
+        size_type n = 0;
+        for(;;) {
+            n += am::next_batch(curSequ_, out + n, max - n);
+            if(!curSequ_.empty() || reps_ >= maxReps_) break;
+            ++reps_;
+            curSequ_ = repSequ_;
+            if(curSequ_.empty()) {
+                reps_ = maxReps_;
+                break;
+            }
+            if(n >= max) break;
+        }
+        return n;
+    }
 
 
     //---------------------------------------------------------------
@@ -154,7 +273,9 @@ public:
     //-----------------------------------------------------
     size_type
     size() const {
-        return curSequ_.size() + (maxReps_ * repSequ_.size());
+        AMLIB_SEQUENCE_COUNT(size);
+        return seq_detail::remaining_size(curSequ_) +
+               ((maxReps_ - reps_) * seq_detail::remaining_size(repSequ_));
     }
     //-----------------------------------------------------
     bool
@@ -176,13 +297,17 @@ public:
     //-----------------------------------------------------
     repeated_sequence
     end() const {
-        return repeated_sequence{curSequ_.end(), repSequ_, maxReps_, maxReps_};
+        AMLIB_SEQUENCE_COUNT(end);
+        return repeated_sequence{
+            (maxReps_ > 0) ? repSequ_.end() : curSequ_.end(),
+            repSequ_, maxReps_, maxReps_};
     }
 
 
     //---------------------------------------------------------------
     bool
     operator == (const repeated_sequence& o) const {
+        AMLIB_SEQUENCE_COUNT(compare);
         return
             (reps_ == o.reps_) &&
             (curSequ_ == o.curSequ_) &&
@@ -196,6 +321,17 @@ public:
     }
 
 
+    //---------------------------------------------------------------
+    template<class F>
+    friend void
+    for_each_segment(const repeated_sequence& s, F&& f) {
+        for_each_segment(s.curSequ_, f);
+        for(auto r = s.reps_; r < s.maxReps_; ++r) {
+            for_each_segment(s.repSequ_, f);
+        }
+    }
+
+
 private:
     //---------------------------------------------------------------
     constexpr explicit
@@ -222,33 +358,597 @@ private:
 
 
 
+/*************************************************************************//***
+ *
+ * @brief repeated sequence that evaluates the underlying sequence(s) only
+ *        once; all values are kept in a buffer that is shared between
+ *        copies (so end() and operator+ are cheap)
+ *
+ *****************************************************************************/
+template<class Sequence>
+class repeated_sequence<Sequence,memoize_period> :
+    private seq_stats::tracked<repeated_sequence<Sequence,memoize_period>>
+{
+public:
+    //---------------------------------------------------------------
+    using sequence_type = Sequence;
+    //-----------------------------------------------------
+    using iterator_category = std::input_iterator_tag;
+    using difference_type = typename sequence_type::difference_type;
+    using size_type = typename sequence_type::size_type;
+    //-----------------------------------------------------
+    using value_type = std::decay_t<typename sequence_type::value_type>;
+    using reference = const value_type&;
+    using pointer = const value_type*;
+
+
+    //---------------------------------------------------------------
+    explicit
+    repeated_sequence(
+        const sequence_type& sequence = sequence_type(),
+        size_type repetitions = 0)
+    :
+        buf_{}, data_{nullptr},
+        cur_(0), stop_(0), nfst_(0), nbuf_(0),
+        reps_(0), maxReps_(repetitions)
+    {
+        auto buf = std::make_shared<std::vector<value_type>>();
+        memoize(sequence, *buf);
+        stop_ = buf->size();
+        init(std::move(buf));
+    }
+    //-----------------------------------------------------
+    explicit
+    repeated_sequence(
+        const sequence_type& first,
+        const sequence_type& repeat,
+        size_type repetitions = 0)
+    :
+        buf_{}, data_{nullptr},
+        cur_(0), stop_(0), nfst_(0), nbuf_(0),
+        reps_(0), maxReps_(repetitions)
+    {
+        auto buf = std::make_shared<std::vector<value_type>>();
+        memoize(first, *buf);
+        nfst_ = buf->size();
+        if(maxReps_ > 0) memoize(repeat, *buf);
+        stop_ = nfst_;
+        init(std::move(buf));
+    }
+
+
+    //---------------------------------------------------------------
+    const value_type&
+    operator * () const noexcept {
+        return data_[cur_];
+    }
+    //-----------------------------------------------------
+    const value_type*
+    operator -> () const noexcept {
+        return data_ + cur_;
+    }
+    //-----------------------------------------------------
+    const value_type&
+    operator [] (size_type offset) const noexcept
+    {
+        AMLIB_SEQUENCE_COUNT(subscript);
+        const auto n = stop_ - cur_;
+        const auto nper = period_size();
+        //empty period: nothing beyond the first pass
+        if(offset >= n && nper > 0) {
+            return data_[nfst_ + ((offset - n) % nper)];
+        }
+        return data_[cur_ + offset];
+    }
+
+
+    //---------------------------------------------------------------
+    repeated_sequence&
+    operator ++ () noexcept {
+        AMLIB_SEQUENCE_COUNT(increment);
+        ++cur_;
+        wrap();
+        return *this;
+    }
+    //-----------------------------------------------------
+    repeated_sequence&
+    operator += (size_type offset) noexcept
+    {
+        AMLIB_SEQUENCE_COUNT(advance);
+        const auto n = stop_ - cur_;
+        if(offset < n) {
+            cur_ += offset;
+            return *this;
+        }
+        offset -= n;
+        const auto nper = period_size();
+        const auto k = (nper > 0) ? (offset / nper) : size_type(0);
+        const auto r = (nper > 0) ? (offset % nper) : offset;
+
+        if(nper > 0 && (reps_ + k) < maxReps_) {
+            reps_ += k + 1;
+            cur_ = nfst_ + r;
+            stop_ = nbuf_;
+        } else {
+            reps_ = maxReps_;
+            cur_ = stop_ = nbuf_;
+        }
+        return *this;
+    }
+    //-----------------------------------------------------
+    repeated_sequence
+    operator + (size_type offset) const {
+        auto res = *this;
+        res += offset;
+        return res;
+    }
+    //-----------------------------------------------------
+    /**
+     * @brief writes up to 'max' values to 'out' and advances past them;
+     *        whole periods are produced with doubling memcpy
+     *        for trivially copyable value types
+     */
+    size_type
+    next_batch(value_type* out, size_type max)
+    {
+        //rest of the current pass
+        auto n = std::min(stop_ - cur_, max);
+        std::copy(data_ + cur_, data_ + cur_ + n, out);
+        cur_ += n;
+        wrap();
+        if(n >= max || empty()) return n;
+
+        //whole periods: the current pass and all remaining ones
+        const auto nper = period_size();
+        const auto k = std::min((max - n) / nper, maxReps_ - reps_ + 1);
+        if(k > 0) {
+            seq_detail::replicate(data_ + nfst_, nper, k, out + n);
+            n += k * nper;
+            reps_ += k - 1;
+            cur_ = stop_;
+            wrap();
+        }
+
+        //head of the next pass
+        const auto m = std::min(stop_ - cur_, max - n);
+        std::copy(data_ + cur_, data_ + cur_ + m, out + n);
+        cur_ += m;
+        wrap();
+        return n + m;
+    }
+
+
+    //---------------------------------------------------------------
+    size_type
+    period_size() const noexcept {
+        return nbuf_ - nfst_;
+    }
+    //-----------------------------------------------------
+    size_type
+    repetitions_required() const noexcept {
+        return maxReps_;
+    }
+    //-----------------------------------------------------
+    size_type
+    repetitions_so_far() const noexcept {
+        return reps_;
+    }
+
+
+    //---------------------------------------------------------------
+    const value_type&
+    front() const noexcept {
+        return data_[cur_];
+    }
+    //-----------------------------------------------------
+    const value_type&
+    back() const noexcept {
+        return data_[nbuf_ - 1];
+    }
+    //-----------------------------------------------------
+    size_type
+    size() const noexcept {
+        AMLIB_SEQUENCE_COUNT(size);
+        return (stop_ - cur_) + ((maxReps_ - reps_) * period_size());
+    }
+    //-----------------------------------------------------
+    bool
+    empty() const noexcept {
+        return (cur_ >= stop_);
+    }
+    //-----------------------------------------------------
+    explicit operator
+    bool() const noexcept {
+        return !empty();
+    }
+
+
+    //---------------------------------------------------------------
+    const repeated_sequence&
+    begin() const noexcept {
+        return *this;
+    }
+    //-----------------------------------------------------
+    repeated_sequence
+    end() const noexcept {
+        AMLIB_SEQUENCE_COUNT(end);
+        auto res = *this;
+        res.reps_ = maxReps_;
+        res.cur_ = res.stop_ = nbuf_;
+        return res;
+    }
+
+
+    //---------------------------------------------------------------
+    /**
+     * @brief writes all remaining values to 'out';
+     *        repetitions are produced with doubling memcpy
+     *        if 'out' is a pointer to a trivially copyable type
+     */
+    template<class OutputIterator>
+    OutputIterator
+    copy_to(OutputIterator out) const
+    {
+        out = std::copy(data_ + cur_, data_ + stop_, out);
+        return seq_detail::replicate(data_ + nfst_, period_size(),
+                                     maxReps_ - reps_, out);
+    }
+
+
+    //---------------------------------------------------------------
+    bool
+    operator == (const repeated_sequence& o) const noexcept {
+        AMLIB_SEQUENCE_COUNT(compare);
+        return
+            (data_ == o.data_) &&
+            (cur_ == o.cur_) &&
+            (stop_ == o.stop_) &&
+            (reps_ == o.reps_) &&
+            (maxReps_ == o.maxReps_);
+    }
+    //-----------------------------------------------------
+    bool
+    operator != (const repeated_sequence& o) const noexcept {
+        return !(*this == o);
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    static void
+    memoize(const sequence_type& s, std::vector<value_type>& buf) {
+        for(const auto& x : s) {
+            buf.push_back(x);
+        }
+    }
+
+    //-----------------------------------------------------
+    void
+    init(std::shared_ptr<std::vector<value_type>> buf) noexcept {
+        nbuf_ = buf->size();
+        data_ = buf->data();
+        buf_ = std::move(buf);
+        wrap();
+    }
+
+    //-----------------------------------------------------
+    void
+    wrap() noexcept {
+        if(cur_ == stop_ && reps_ < maxReps_) {
+            reps_ = (nfst_ == nbuf_) ? maxReps_ : (reps_ + 1);
+            cur_ = nfst_;
+            stop_ = nbuf_;
+        }
+    }
+
+
+    //---------------------------------------------------------------
+    std::shared_ptr<const std::vector<value_type>> buf_;
+    const value_type* data_;
+    size_type cur_, stop_, nfst_, nbuf_;
+    size_type reps_, maxReps_;
+};
+
+
+
+
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief compact repeated sequence: the repeated sequence and the number
+ *        of repetitions are immutable and shared between all copies;
+ *        each object only holds the current sequence and a repetition
+ *        counter, so nesting does not double the object size
+ *
+ *****************************************************************************/
+template<class Sequence>
+class repeated_sequence<Sequence,share_period> :
+    private seq_stats::tracked<repeated_sequence<Sequence,share_period>>
+{
+public:
+    //---------------------------------------------------------------
+    using sequence_type = Sequence;
+    //-----------------------------------------------------
+    using iterator_category = std::input_iterator_tag;
+    using difference_type = typename sequence_type::difference_type;
+    using size_type = typename sequence_type::size_type;
+    //-----------------------------------------------------
+    using value_type = typename sequence_type::value_type;
+    using reference = const value_type&;
+    using pointer = value_type*;
+
+
+    //---------------------------------------------------------------
+    explicit
+    repeated_sequence(
+        sequence_type sequence = sequence_type(),
+        size_type repetitions = 0)
+    :
+        curSequ_{sequence}, reps_(0),
+        params_{std::make_shared<const params>(
+                    params{std::move(sequence), repetitions})}
+    {}
+    //-----------------------------------------------------
+    explicit
+    repeated_sequence(
+        sequence_type first,
+        sequence_type repeat,
+        size_type repetitions = 0)
+    :
+        curSequ_{std::move(first)}, reps_(0),
+        params_{std::make_shared<const params>(
+                    params{std::move(repeat), repetitions})}
+    {}
+
+
+    //---------------------------------------------------------------
+    decltype(auto)
+    operator * () const {
+        return *curSequ_;
+    }
+    //-----------------------------------------------------
+    auto
+    operator -> () const {
+        return std::addressof(*curSequ_);
+    }
+    //-----------------------------------------------------
+    value_type
+    operator [] (size_type offset) const
+    {
+        AMLIB_SEQUENCE_COUNT(subscript);
+        const auto nfst = seq_detail::remaining_size(curSequ_);
+        const auto& rep = params_->repSequ;
+        const auto nrep = seq_detail::remaining_size(rep);
+        //empty repeat sequence: nothing beyond the first pass
+        if(offset >= nfst && nrep > 0) {
+            return rep[(offset-nfst) % nrep];
+        }
+        return curSequ_[offset];
+    }
+
+
+    //---------------------------------------------------------------
+    repeated_sequence&
+    operator ++ ()
+    {
+        AMLIB_SEQUENCE_COUNT(increment);
+        ++curSequ_;
+        if(curSequ_.empty() && (reps_ < params_->maxReps)) {
+            ++reps_;
+            curSequ_ = params_->repSequ;
+            //empty repeat sequence: no further passes
+            if(curSequ_.empty()) reps_ = params_->maxReps;
+        }
+        return *this;
+    }
+    //-----------------------------------------------------
+    repeated_sequence&
+    operator += (size_type offset)
+    {
+        AMLIB_SEQUENCE_COUNT(advance);
+        const auto nfst = seq_detail::remaining_size(curSequ_);
+        if(offset < nfst) {
+            curSequ_ += offset;
+            return *this;
+        }
+        offset -= nfst;
+        const auto nrep = seq_detail::remaining_size(params_->repSequ);
+        if(nrep < 1) {
+            *this = end();
+            return *this;
+        }
+        const auto k = offset / nrep;
+
+        if((reps_ + k) < params_->maxReps) {
+            reps_ += k + 1;
+            curSequ_ = params_->repSequ;
+            curSequ_ += offset % nrep;
+        } else {
+            *this = end();
+        }
+        return *this;
+    }
+    //-----------------------------------------------------
+    repeated_sequence
+    operator + (size_type offset) const {
+        auto res = *this;
+        res += offset;
+        return res;
+    }
+    //-----------------------------------------------------
+    /**
+     * @brief writes up to 'max' values to 'out' and advances past them;
+     *        uses the batch kernels of the underlying sequences
+     */
+    size_type
+    next_batch(value_type* out, size_type max)
+    {
+        size_type n = 0;
+        for(;;) {
+            n += am::next_batch(curSequ_, out + n, max - n);
+            if(!curSequ_.empty() || reps_ >= params_->maxReps) break;
+            ++reps_;
+            curSequ_ = params_->repSequ;
+            if(curSequ_.empty()) {
+                reps_ = params_->maxReps;
+                break;
+            }
+            if(n >= max) break;
+        }
+        return n;
+    }
+
+
+    //---------------------------------------------------------------
+    const sequence_type&
+    repeat_sequence() const noexcept {
+        return params_->repSequ;
+    }
+    //-----------------------------------------------------
+    size_type
+    repetitions_required() const noexcept {
+        return params_->maxReps;
+    }
+    //-----------------------------------------------------
+    size_type
+    repetitions_so_far() const noexcept {
+        return reps_;
+    }
+
+
+    //---------------------------------------------------------------
+    decltype(auto)
+    front() const {
+        return curSequ_.front();
+    }
+    //-----------------------------------------------------
+    value_type
+    back() const {
+        return params_->repSequ.back();
+    }
+    //-----------------------------------------------------
+    size_type
+    size() const {
+        AMLIB_SEQUENCE_COUNT(size);
+        return seq_detail::remaining_size(curSequ_) +
+               ((params_->maxReps - reps_) *
+                seq_detail::remaining_size(params_->repSequ));
+    }
+    //-----------------------------------------------------
+    bool
+    empty() const {
+        return curSequ_.empty() && (reps_ >= params_->maxReps);
+    }
+    //-----------------------------------------------------
+    explicit operator
+    bool() const {
+        return !empty();
+    }
+
+
+    //---------------------------------------------------------------
+    const repeated_sequence&
+    begin() const noexcept {
+        return *this;
+    }
+    //-----------------------------------------------------
+    repeated_sequence
+    end() const {
+        AMLIB_SEQUENCE_COUNT(end);
+        return repeated_sequence{
+            (params_->maxReps > 0) ? params_->repSequ.end() : curSequ_.end(),
+            params_->maxReps, params_};
+    }
+
+
+    //---------------------------------------------------------------
+    bool
+    operator == (const repeated_sequence& o) const {
+        AMLIB_SEQUENCE_COUNT(compare);
+        return
+            (reps_ == o.reps_) &&
+            (curSequ_ == o.curSequ_) &&
+            ((params_ == o.params_) ||
+             ((params_->maxReps == o.params_->maxReps) &&
+              (params_->repSequ == o.params_->repSequ)) );
+    }
+    //-----------------------------------------------------
+    bool
+    operator != (const repeated_sequence& o) const {
+        return !(*this == o);
+    }
+
+
+    //---------------------------------------------------------------
+    template<class F>
+    friend void
+    for_each_segment(const repeated_sequence& s, F&& f) {
+        for_each_segment(s.curSequ_, f);
+        for(auto r = s.reps_; r < s.params_->maxReps; ++r) {
+            for_each_segment(s.params_->repSequ, f);
+        }
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    struct params {
+        sequence_type repSequ;
+        size_type maxReps;
+    };
+
+    //---------------------------------------------------------------
+    explicit
+    repeated_sequence(sequence_type cur, size_type curReps,
+                      std::shared_ptr<const params> p)
+    :
+        curSequ_{std::move(cur)}, reps_(curReps), params_{std::move(p)}
+    {}
+
+
+    //---------------------------------------------------------------
+    sequence_type curSequ_;
+    size_type reps_;
+    std::shared_ptr<const params> params_;
+};
+
+
+
+
+
+
+
+
 /*****************************************************************************
  *
  * NON-MEMBER BEGIN/END
  *
  *****************************************************************************/
-template<class S>
+template<class S, class P>
 inline decltype(auto)
-begin(const repeated_sequence<S>& s) {
+begin(const repeated_sequence<S,P>& s) {
     return s.begin();
 }
 //-----------------------------------------------------
-template<class S>
+template<class S, class P>
 inline decltype(auto)
-cbegin(const repeated_sequence<S>& s) {
+cbegin(const repeated_sequence<S,P>& s) {
     return s.begin();
 }
 
 //-----------------------------------------------------
-template<class S>
+template<class S, class P>
 inline decltype(auto)
-end(const repeated_sequence<S>& s) {
+end(const repeated_sequence<S,P>& s) {
     return s.end();
 }
 //-----------------------------------------------------
-template<class S>
+template<class S, class P>
 inline decltype(auto)
-cend(const repeated_sequence<S>& s) {
+cend(const repeated_sequence<S,P>& s) {
     return s.end();
 }
 
@@ -265,14 +965,21 @@ cend(const repeated_sequence<S>& s) {
  *
  *****************************************************************************/
 template<class Sequence>
+#if AMLIB_SEQUENCE_CONCEPTS
+    requires am::Sequence<std::decay_t<Sequence>>
+#endif
 inline constexpr auto
 make_repeated_sequence(Sequence&& seq, std::size_t repetitions)
 {
-    return repeated_sequence<Sequence>{std::forward<Sequence>(seq), repetitions};
+    return repeated_sequence<std::decay_t<Sequence>>{
+               std::forward<Sequence>(seq), repetitions};
 }
 
 //-----------------------------------------------------
 template<class Sequence>
+#if AMLIB_SEQUENCE_CONCEPTS
+    requires am::Sequence<Sequence>
+#endif
 inline constexpr auto
 make_repeated_sequence(Sequence firstSeq, Sequence repSeq, std::size_t repetitions)
 {
@@ -282,6 +989,61 @@ make_repeated_sequence(Sequence firstSeq, Sequence repSeq, std::size_t repetitio
 }
 
 
+
+//-------------------------------------------------------------------
+template<class Sequence>
+#if AMLIB_SEQUENCE_CONCEPTS
+    requires am::Sequence<std::decay_t<Sequence>>
+#endif
+inline auto
+make_cached_repeated_sequence(Sequence&& seq, std::size_t repetitions)
+{
+    return repeated_sequence<std::decay_t<Sequence>,memoize_period>{
+               std::forward<Sequence>(seq), repetitions};
+}
+
+//-----------------------------------------------------
+template<class Sequence>
+#if AMLIB_SEQUENCE_CONCEPTS
+    requires am::Sequence<Sequence>
+#endif
+inline auto
+make_cached_repeated_sequence(const Sequence& firstSeq,
+                              const Sequence& repSeq,
+                              std::size_t repetitions)
+{
+    return repeated_sequence<Sequence,memoize_period>{
+               firstSeq, repSeq, repetitions};
+}
+
+
+
+//-------------------------------------------------------------------
+template<class Sequence>
+#if AMLIB_SEQUENCE_CONCEPTS
+    requires am::Sequence<std::decay_t<Sequence>>
+#endif
+inline auto
+make_compact_repeated_sequence(Sequence&& seq, std::size_t repetitions)
+{
+    return repeated_sequence<std::decay_t<Sequence>,share_period>{
+               std::forward<Sequence>(seq), repetitions};
+}
+
+//-----------------------------------------------------
+template<class Sequence>
+#if AMLIB_SEQUENCE_CONCEPTS
+    requires am::Sequence<Sequence>
+#endif
+inline auto
+make_compact_repeated_sequence(Sequence firstSeq, Sequence repSeq,
+                               std::size_t repetitions)
+{
+    return repeated_sequence<Sequence,share_period>{
+               std::move(firstSeq), std::move(repSeq), repetitions};
+}
+
+
 } //namespace am
 
 #endif
@@ -1,8 +1,12 @@
 #ifndef AMLIB_REPLICA_SEQUENCE_H_
 #define AMLIB_REPLICA_SEQUENCE_H_
 
+#include <algorithm>
+#include <cstddef>
 #include <type_traits>
 
+#include "stats.h"
+
 
 namespace am {
 
@@ -14,7 +18,8 @@ namespace am {
  *
  *****************************************************************************/
 template<class T>
-class replica_sequence
+class replica_sequence :
+    private seq_stats::tracked<replica_sequence<T>>
 {
 public:
     //---------------------------------------------------------------
@@ -37,16 +42,19 @@ public:
     //-----------------------------------------------------
     const replica_sequence&
     end() const noexcept {
+        AMLIB_SEQUENCE_COUNT(end);
         return *this;
     }
 
     //---------------------------------------------------------------
     bool operator != (const replica_sequence&) const noexcept {
+        AMLIB_SEQUENCE_COUNT(compare);
         return (i_ > 0);
     }
     //-----------------------------------------------------
     replica_sequence&
     operator ++ () noexcept {
+        AMLIB_SEQUENCE_COUNT(increment);
         --i_;
         return *this;
     }
@@ -55,6 +63,15 @@ public:
     operator * () const noexcept {
         return v_;
     }
+    //-----------------------------------------------------
+    /// writes up to 'max' copies to 'out' and advances past them
+    std::size_t
+    next_batch(value_type* out, std::size_t max) {
+        const auto n = std::min(i_, max);
+        std::fill_n(out, n, v_);
+        i_ -= n;
+        return n;
+    }
 
 private:
     value_type v_;
@@ -0,0 +1,296 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AMLIB_NUMERIC_SEGMENTED_SEQUENCE_H_
+#define AMLIB_NUMERIC_SEGMENTED_SEQUENCE_H_
+
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+
+namespace am {
+
+
+namespace seq_detail {
+
+/*****************************************************************************
+ *
+ * @brief number of remaining elements; 0 for empty sequences
+ *
+ *****************************************************************************/
+template<class Sequence>
+inline auto
+remaining_size(const Sequence& s) -> decltype(s.size())
+{
+    return s.empty() ? decltype(s.size())(0) : s.size();
+}
+
+
+
+//-------------------------------------------------------------------
+template<class...>
+struct make_void { using type = void; };
+
+template<class... Ts>
+using void_t = typename make_void<Ts...>::type;
+
+//-------------------------------------------------------------------
+template<class S, class = void>
+struct has_size : std::false_type {};
+
+template<class S>
+struct has_size<S,void_t<decltype(std::declval<const S&>().size())>> :
+    std::true_type {};
+
+//-------------------------------------------------------------------
+template<class S, class T, class = void>
+struct has_next_batch : std::false_type {};
+
+template<class S, class T>
+struct has_next_batch<S,T,void_t<decltype(std::declval<S&>().next_batch(
+    std::declval<T*>(), std::size_t(0)))>> : std::true_type {};
+
+
+//-------------------------------------------------------------------
+/// sequences with known size: one counted loop
+template<class Sequence, class F>
+inline std::size_t
+for_each_value(Sequence& s, std::size_t max, F&& f, std::true_type)
+{
+    auto n = static_cast<std::size_t>(remaining_size(s));
+    if(n > max) n = max;
+    for(auto i = n; i > 0; --i, ++s) f(*s);
+    return n;
+}
+
+//-------------------------------------------------------------------
+/// sequences without size (filtered, ...)
+template<class Sequence, class F>
+inline std::size_t
+for_each_value(Sequence& s, std::size_t max, F&& f, std::false_type)
+{
+    std::size_t n = 0;
+    for(; n < max && !s.empty(); ++n, ++s) f(*s);
+    return n;
+}
+
+//-------------------------------------------------------------------
+/// calls 'f' with up to 'max' values of 's' and advances past them
+/// @return number of values visited
+template<class Sequence, class F>
+inline std::size_t
+for_each_value(Sequence& s, std::size_t max, F&& f)
+{
+    return for_each_value(s, max, std::forward<F>(f), has_size<Sequence>{});
+}
+
+
+//-------------------------------------------------------------------
+/// sequences with a dedicated batch kernel
+template<class Sequence, class T, bool Sized>
+inline std::size_t
+next_batch(Sequence& s, T* out, std::size_t max, std::true_type,
+           std::integral_constant<bool,Sized>)
+{
+    return s.next_batch(out, max);
+}
+
+//-------------------------------------------------------------------
+/// sequences with known size: one branch-free loop
+template<class Sequence, class T>
+inline std::size_t
+next_batch(Sequence& s, T* out, std::size_t max, std::false_type,
+           std::true_type)
+{
+    auto n = static_cast<std::size_t>(remaining_size(s));
+    if(n > max) n = max;
+    for(std::size_t i = 0; i < n; ++i, ++s) out[i] = *s;
+    return n;
+}
+
+//-------------------------------------------------------------------
+/// sequences without size (filtered, ...)
+template<class Sequence, class T>
+inline std::size_t
+next_batch(Sequence& s, T* out, std::size_t max, std::false_type,
+           std::false_type)
+{
+    std::size_t n = 0;
+    for(; n < max && !s.empty(); ++n, ++s) out[n] = *s;
+    return n;
+}
+
+}  // namespace seq_detail
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief batch pull protocol:
+ *        writes up to 'max' values of 's' to 'out' and advances 's'
+ *        past them
+ * @return number of values written (< max only if 's' is exhausted)
+ *
+ *        Sequences provide a member 'next_batch(out, max)' if they have
+ *        a faster kernel than * and ++ (closed forms, bulk copies, ...);
+ *        decorators forward to the batch kernels of their underlying
+ *        sequences.
+ *
+ *****************************************************************************/
+template<class Sequence, class T>
+inline std::size_t
+next_batch(Sequence& s, T* out, std::size_t max)
+{
+    return seq_detail::next_batch(s, out, max,
+        seq_detail::has_next_batch<Sequence,T>{},
+        seq_detail::has_size<Sequence>{});
+}
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief segmented iteration protocol:
+ *        calls 'f' with each contiguous, non-empty, non-decorated
+ *        underlying sequence (= segment) in traversal order
+ *
+ *        This is the fallback for plain sequences (one segment).
+ *        Decorators (combined, repeated, ...) provide overloads that
+ *        recurse into their underlying sequences, so that algorithms
+ *        can run one tight loop per segment instead of branching
+ *        on every step.
+ *
+ *****************************************************************************/
+template<class Sequence, class F>
+inline void
+for_each_segment(const Sequence& s, F&& f)
+{
+    if(!s.empty()) f(s);
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * ALGORITHMS
+ *
+ *****************************************************************************/
+
+/*************************************************************************//***
+ *
+ * @brief writes all values of 'seq' to 'out'
+ * @return output iterator one past the last written value
+ *
+ *****************************************************************************/
+template<class Sequence, class OutputIterator>
+inline OutputIterator
+copy(const Sequence& seq, OutputIterator out)
+{
+    for_each_segment(seq, [&out](const auto& segment) {
+        auto s = segment;
+        seq_detail::for_each_value(s, std::size_t(-1), [&out](const auto& x) {
+            *out = x;
+            ++out;
+        });
+    });
+    return out;
+}
+
+
+
+/*************************************************************************//***
+ *
+ * @brief fills [first,last) with values of 'seq';
+ *        stops if either the range is full or 'seq' is exhausted
+ * @return iterator one past the last written value
+ *
+ *****************************************************************************/
+template<class Sequence, class ForwardIterator>
+inline ForwardIterator
+fill(const Sequence& seq, ForwardIterator first, ForwardIterator last)
+{
+    auto space = std::distance(first, last);
+
+    for_each_segment(seq, [&](const auto& segment) {
+        if(space < 1) return;
+        auto s = segment;
+        space -= seq_detail::for_each_value(s, std::size_t(space),
+            [&first](const auto& x) {
+                *first = x;
+                ++first;
+            });
+    });
+    return first;
+}
+
+
+
+/*************************************************************************//***
+ *
+ * @brief sum of all values of 'seq' (starting with 'init')
+ *
+ *****************************************************************************/
+template<class Sequence, class T>
+inline T
+sum(const Sequence& seq, T init)
+{
+    for_each_segment(seq, [&init](const auto& segment) {
+        auto s = segment;
+        auto acc = T(0);
+        seq_detail::for_each_value(s, std::size_t(-1), [&acc](const auto& x) {
+            acc += x;
+        });
+        init += acc;
+    });
+    return init;
+}
+
+//---------------------------------------------------------
+template<class Sequence>
+inline auto
+sum(const Sequence& seq)
+{
+    using value_t = std::decay_t<decltype(*seq)>;
+    return sum(seq, value_t(0));
+}
+
+
+
+/*************************************************************************//***
+ *
+ * @brief number of values in 'seq' that are equal to 'value'
+ *
+ *****************************************************************************/
+template<class Sequence, class T>
+inline std::size_t
+count(const Sequence& seq, const T& value)
+{
+    std::size_t c = 0;
+    for_each_segment(seq, [&](const auto& segment) {
+        auto s = segment;
+        seq_detail::for_each_value(s, std::size_t(-1), [&](const auto& x) {
+            if(x == value) ++c;
+        });
+    });
+    return c;
+}
+
+
+}  // namespace am
+
+
+#endif
@@ -0,0 +1,544 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AMLIB_NUMERIC_SOBOL_SEQUENCE_H_
+#define AMLIB_NUMERIC_SOBOL_SEQUENCE_H_
+
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "gray_code.h"
+#include "low_discrepancy.h"
+#include "stats.h"
+
+
+namespace am {
+
+
+namespace seq_detail {
+
+
+//-------------------------------------------------------------------
+/// primitive polynomial and initial direction numbers of one dimension
+struct sobol_polynomial
+{
+    unsigned degree;
+    std::uint64_t coeffs;   //inner coefficients a_1 ... a_(degree-1)
+    std::vector<std::uint64_t> m;
+};
+
+
+//-------------------------------------------------------------------
+/// dimensions 2-21 of the Joe-Kuo "new-joe-kuo-6.21201" table
+inline const std::vector<sobol_polynomial>&
+joe_kuo_polynomials()
+{
+    static const auto polys = std::vector<sobol_polynomial>{
+        {1,  0, {1}},
+        {2,  1, {1, 3}},
+        {3,  1, {1, 3, 1}},
+        {3,  2, {1, 1, 1}},
+        {4,  1, {1, 1, 3, 3}},
+        {4,  4, {1, 3, 5, 13}},
+        {5,  2, {1, 1, 5, 5, 17}},
+        {5,  4, {1, 1, 5, 5, 5}},
+        {5,  7, {1, 1, 7, 11, 19}},
+        {5, 11, {1, 1, 5, 1, 1}},
+        {5, 13, {1, 1, 1, 3, 11}},
+        {5, 14, {1, 3, 5, 5, 31}},
+        {6,  1, {1, 3, 3, 9, 7, 49}},
+        {6, 13, {1, 1, 1, 15, 21, 21}},
+        {6, 16, {1, 3, 1, 13, 27, 49}},
+        {6, 19, {1, 1, 1, 15, 7, 5}},
+        {6, 22, {1, 3, 1, 15, 13, 25}},
+        {6, 25, {1, 1, 5, 5, 19, 61}},
+        {7,  1, {1, 3, 7, 11, 23, 15, 103}},
+        {7,  4, {1, 3, 7, 13, 13, 15, 69}}
+    };
+    return polys;
+}
+
+
+}  // namespace seq_detail
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief direction numbers of the Sobol sequence in 64 bit fixed-point
+ *
+ *        stored bit-major (all dimensions of one bit are contiguous),
+ *        so that a Gray-code step is a run of independent XORs
+ *        that the compiler can vectorize
+ *
+ *        the first dimension is the van der Corput sequence, all others
+ *        are given by primitive polynomials and initial numbers m_k;
+ *        'embedded' provides 21 dimensions, more can be read from files
+ *        in the format of Joe & Kuo
+ *        (https://web.maths.unsw.edu.au/~fkuo/sobol/)
+ *
+ *****************************************************************************/
+class sobol_directions
+{
+public:
+    //---------------------------------------------------------------
+    static constexpr int bits = 64;
+
+    using polynomial = seq_detail::sobol_polynomial;
+
+
+    //---------------------------------------------------------------
+    /**
+     * @param polys polynomials of dimensions 2, 3, ...
+     *        throws std::invalid_argument if initial numbers are missing,
+     *        even or too large
+     */
+    explicit
+    sobol_directions(const std::vector<polynomial>& polys):
+        dims_{polys.size() + 1}, v_(bits * (polys.size() + 1))
+    {
+        for(int k = 0; k < bits; ++k) {
+            v_[k * dims_] = std::uint64_t(1) << (bits - 1 - k);
+        }
+
+        for(std::size_t j = 1; j < dims_; ++j) {
+            const auto& p = polys[j-1];
+            const auto s = int(p.degree);
+            if(s < 1 || s >= bits || p.m.size() < std::size_t(s)) {
+                throw std::invalid_argument{
+                    "sobol_directions: invalid polynomial degree"};
+            }
+            for(int k = 0; k < s; ++k) {
+                const auto m = p.m[k];
+                if(!(m & 1) || m >= (std::uint64_t(1) << (k+1))) {
+                    throw std::invalid_argument{
+                        "sobol_directions: invalid initial direction number"};
+                }
+                at(j,k) = m << (bits - 1 - k);
+            }
+            for(int k = s; k < bits; ++k) {
+                auto x = at(j,k-s) ^ (at(j,k-s) >> s);
+                for(int i = 1; i < s; ++i) {
+                    if((p.coeffs >> (s - 1 - i)) & 1) x ^= at(j,k-i);
+                }
+                at(j,k) = x;
+            }
+        }
+    }
+
+
+    //---------------------------------------------------------------
+    std::size_t
+    dimensions() const noexcept {
+        return dims_;
+    }
+
+    //---------------------------------------------------------------
+    /// direction numbers of all dimensions for bit k
+    const std::uint64_t*
+    row(int k) const noexcept {
+        return v_.data() + k * dims_;
+    }
+    //-----------------------------------------------------
+    std::uint64_t
+    operator () (std::size_t dim, int k) const noexcept {
+        return v_[k * dims_ + dim];
+    }
+
+
+    //---------------------------------------------------------------
+    /// 21 dimensions (Joe & Kuo)
+    static std::shared_ptr<const sobol_directions>
+    embedded()
+    {
+        static const auto dirs = std::make_shared<const sobol_directions>(
+            seq_detail::joe_kuo_polynomials());
+        return dirs;
+    }
+
+    //---------------------------------------------------------------
+    /**
+     * @brief reads a table in Joe-Kuo format:
+     *        one line per dimension (starting with dimension 2)
+     *        'd s a m_1 ... m_s'; a non-numeric first line is ignored;
+     *        reads at most 'maxDims' dimensions (including the first)
+     *        throws std::runtime_error on malformed input
+     */
+    static std::shared_ptr<const sobol_directions>
+    read(std::istream& is,
+         std::size_t maxDims = std::numeric_limits<std::size_t>::max())
+    {
+        auto polys = std::vector<polynomial>{};
+        std::string line;
+        bool first = true;
+        while(polys.size() + 1 < maxDims && std::getline(is, line)) {
+            auto ls = std::istringstream{line};
+            std::uint64_t d = 0;
+            if(!(ls >> d)) {
+                if(first || line.find_first_not_of(" \t\r") == std::string::npos) {
+                    first = false;
+                    continue;
+                }
+                throw std::runtime_error{"malformed direction numbers: " + line};
+            }
+            first = false;
+            auto p = polynomial{};
+            if(!(ls >> p.degree >> p.coeffs)) {
+                throw std::runtime_error{"malformed direction numbers: " + line};
+            }
+            p.m.resize(p.degree);
+            for(auto& m : p.m) {
+                if(!(ls >> m)) {
+                    throw std::runtime_error{"malformed direction numbers: " + line};
+                }
+            }
+            polys.push_back(std::move(p));
+        }
+        return std::make_shared<const sobol_directions>(polys);
+    }
+    //-----------------------------------------------------
+    static std::shared_ptr<const sobol_directions>
+    load(const std::string& path,
+         std::size_t maxDims = std::numeric_limits<std::size_t>::max())
+    {
+        std::ifstream is{path};
+        if(!is) throw std::runtime_error{"could not open file " + path};
+        return read(is, maxDims);
+    }
+
+
+private:
+    std::uint64_t&
+    at(std::size_t dim, int k) noexcept {
+        return v_[k * dims_ + dim];
+    }
+
+    std::size_t dims_;
+    std::vector<std::uint64_t> v_;
+};
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief Dims-dimensional Sobol points in [0,1)^Dims
+ *
+ *        points are produced in Gray-code order: ++ is one XOR per
+ *        dimension (x ^= v[ctz(n+1)]); [] and += evaluate the point of
+ *        an arbitrary index directly in O(log n), so the sequence can be
+ *        split across threads
+ *
+ *        throws std::invalid_argument if the direction table has
+ *        fewer than Dims dimensions
+ *
+ *****************************************************************************/
+template<class T, std::size_t Dims>
+class sobol_sequence :
+    private seq_stats::tracked<sobol_sequence<T,Dims>>
+{
+    static_assert(std::is_floating_point<T>::value,
+                  "sobol_sequence requires a floating-point value type");
+    static_assert(Dims > 0, "sobol_sequence requires at least 1 dimension");
+
+    using fixed_point = std::array<std::uint64_t,Dims>;
+    using directions = std::shared_ptr<const sobol_directions>;
+
+public:
+    //---------------------------------------------------------------
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::array<T,Dims>;
+    using reference = const value_type&;
+    using pointer = const value_type*;
+    using size_type = std::uint64_t;
+    using difference_type = std::int64_t;
+
+    static constexpr std::size_t dimensions = Dims;
+
+
+    //---------------------------------------------------------------
+    explicit
+    sobol_sequence(size_type count = std::numeric_limits<size_type>::max(),
+                   directions dirs = sobol_directions::embedded())
+    :
+        dirs_{std::move(dirs)}, idx_{0}, end_{count}, fix_{}, cur_{}
+    {
+        if(!dirs_ || dirs_->dimensions() < Dims) {
+            throw std::invalid_argument{
+                "sobol_sequence: not enough direction numbers"};
+        }
+        fix_.fill(0);
+        cur_.fill(T(0));
+    }
+
+
+    //---------------------------------------------------------------
+    reference
+    operator * () const noexcept {
+        return cur_;
+    }
+    //-----------------------------------------------------
+    pointer
+    operator -> () const noexcept {
+        return std::addressof(cur_);
+    }
+    //-----------------------------------------------------
+    value_type
+    operator [] (size_type offset) const noexcept {
+        AMLIB_SEQUENCE_COUNT(subscript);
+        const auto x = point(idx_ + offset);
+        auto res = value_type{};
+        for(std::size_t j = 0; j < Dims; ++j) res[j] = unit(x[j]);
+        return res;
+    }
+
+
+    //---------------------------------------------------------------
+    sobol_sequence&
+    operator ++ () noexcept {
+        AMLIB_SEQUENCE_COUNT(increment);
+        ++idx_;
+        if(idx_ > 0) {
+            const auto v = dirs_->row(seq_detail::trailing_zeros(idx_));
+            for(std::size_t j = 0; j < Dims; ++j) {
+                fix_[j] ^= v[j];
+                cur_[j] = unit(fix_[j]);
+            }
+        }
+        return *this;
+    }
+    //-----------------------------------------------------
+    sobol_sequence&
+    operator += (size_type offset) noexcept {
+        AMLIB_SEQUENCE_COUNT(advance);
+        idx_ = (offset < (end_ - idx_)) ? (idx_ + offset) : end_;
+        fix_ = point(idx_);
+        for(std::size_t j = 0; j < Dims; ++j) cur_[j] = unit(fix_[j]);
+        return *this;
+    }
+    //-----------------------------------------------------
+    sobol_sequence
+    operator + (size_type offset) const noexcept {
+        auto res = *this;
+        res += offset;
+        return res;
+    }
+    //-----------------------------------------------------
+    /**
+     * @brief writes up to 'max' points to 'out' and advances past them;
+     *        Gray-code stepping like ++
+     */
+    size_type
+    next_batch(value_type* out, size_type max) noexcept {
+        const auto n = std::min(size(), max);
+        auto x = fix_;
+        for(size_type i = 0; i < n; ++i) {
+            for(std::size_t j = 0; j < Dims; ++j) out[i][j] = unit(x[j]);
+            const auto k = idx_ + i + 1;
+            if(k > 0) {
+                const auto v = dirs_->row(seq_detail::trailing_zeros(k));
+                for(std::size_t j = 0; j < Dims; ++j) x[j] ^= v[j];
+            }
+        }
+        if(n > 0) {
+            idx_ += n;
+            fix_ = x;
+            for(std::size_t j = 0; j < Dims; ++j) cur_[j] = unit(x[j]);
+        }
+        return n;
+    }
+
+
+    //---------------------------------------------------------------
+    /**
+     * @brief writes the next n points (at most size()) to 'out'
+     *        in SoA layout: coordinate j of point i goes to
+     *        out[j * rowStride + i] (rowStride defaults to n)
+     * @return number of written points
+     */
+    size_type
+    generate_soa(T* out, size_type n, size_type rowStride = 0) const noexcept
+    {
+        if(n > size()) n = size();
+        if(rowStride < n) rowStride = n;
+        auto x = fix_;
+        for(size_type i = 0; i < n; ++i) {
+            for(std::size_t j = 0; j < Dims; ++j) {
+                out[j * rowStride + i] = unit(x[j]);
+            }
+            const auto k = idx_ + i + 1;
+            if(k > 0) {
+                const auto v = dirs_->row(seq_detail::trailing_zeros(k));
+                for(std::size_t j = 0; j < Dims; ++j) x[j] ^= v[j];
+            }
+        }
+        return n;
+    }
+
+
+    //---------------------------------------------------------------
+    /// absolute (Gray-code) index of the current point
+    size_type
+    index() const noexcept {
+        return idx_;
+    }
+    //-----------------------------------------------------
+    const directions&
+    direction_numbers() const noexcept {
+        return dirs_;
+    }
+
+
+    //---------------------------------------------------------------
+    bool
+    operator == (const sobol_sequence& o) const noexcept {
+        AMLIB_SEQUENCE_COUNT(compare);
+        return (idx_ == o.idx_) && (end_ == o.end_) && (dirs_ == o.dirs_);
+    }
+    //-----------------------------------------------------
+    bool
+    operator != (const sobol_sequence& o) const noexcept {
+        return !(*this == o);
+    }
+
+
+    //---------------------------------------------------------------
+    size_type
+    size() const noexcept {
+        AMLIB_SEQUENCE_COUNT(size);
+        return end_ - idx_;
+    }
+    //-----------------------------------------------------
+    bool
+    empty() const noexcept {
+        return idx_ >= end_;
+    }
+
+
+    //---------------------------------------------------------------
+    const sobol_sequence&
+    begin() const noexcept {
+        return *this;
+    }
+    //-----------------------------------------------------
+    sobol_sequence
+    end() const noexcept {
+        AMLIB_SEQUENCE_COUNT(end);
+        auto res = *this;
+        res.idx_ = end_;
+        return res;
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    static T
+    unit(std::uint64_t x) noexcept {
+        return seq_detail::unit_interval<T>::from_fixed(x);
+    }
+
+    //---------------------------------------------------------------
+    /// XOR of the direction numbers of the set bits of gray(n)
+    fixed_point
+    point(size_type n) const noexcept {
+        auto x = fixed_point{};
+        x.fill(0);
+        auto g = seq_detail::gray_code(n);
+        for(int k = 0; g > 0; ++k, g >>= 1) {
+            if(g & 1) {
+                const auto v = dirs_->row(k);
+                for(std::size_t j = 0; j < Dims; ++j) x[j] ^= v[j];
+            }
+        }
+        return x;
+    }
+
+
+    //---------------------------------------------------------------
+    directions dirs_;
+    size_type idx_;
+    size_type end_;
+    fixed_point fix_;
+    value_type cur_;
+};
+
+
+
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+template<class T, std::size_t Dims>
+inline decltype(auto)
+begin(const sobol_sequence<T,Dims>& s) noexcept
+{
+    return s.begin();
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t Dims>
+inline decltype(auto)
+cbegin(const sobol_sequence<T,Dims>& s) noexcept
+{
+    return s.begin();
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t Dims>
+inline decltype(auto)
+end(const sobol_sequence<T,Dims>& s) noexcept
+{
+    return s.end();
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t Dims>
+inline decltype(auto)
+cend(const sobol_sequence<T,Dims>& s) noexcept
+{
+    return s.end();
+}
+
+
+
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+template<class T, std::size_t Dims>
+inline auto
+make_sobol_sequence(std::uint64_t count,
+                    std::shared_ptr<const sobol_directions> dirs =
+                        sobol_directions::embedded())
+{
+    return sobol_sequence<T,Dims>{count, std::move(dirs)};
+}
+
+
+}  // namespace am
+
+
+#endif
@@ -0,0 +1,263 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AMLIB_NUMERIC_SEQUENCE_STATS_H_
+#define AMLIB_NUMERIC_SEQUENCE_STATS_H_
+
+
+/*****************************************************************************
+ *
+ * Opt-in instrumentation of sequence operations.
+ *
+ * If AM_SEQUENCE_STATS is defined (before including any sequence header),
+ * every sequence type counts calls to ++, +=, [], size(), end(),
+ * comparisons, copies and transcendental functions in thread-local
+ * counters (one set per sequence type and thread).
+ *
+ * Otherwise AMLIB_SEQUENCE_COUNT expands to nothing and
+ * seq_stats::tracked is an empty base class.
+ *
+ *****************************************************************************/
+
+#include <cstdint>
+
+
+namespace am {
+namespace seq_stats {
+
+
+//-------------------------------------------------------------------
+enum class op : int {
+    increment, advance, subscript, size, end, compare, copy,
+    transcendental
+};
+
+constexpr int op_count = int(op::transcendental) + 1;
+
+//-------------------------------------------------------------------
+inline const char*
+op_name(op o) noexcept
+{
+    switch(o) {
+        case op::increment:      return "++";
+        case op::advance:        return "+=";
+        case op::subscript:      return "[]";
+        case op::size:           return "size";
+        case op::end:            return "end";
+        case op::compare:        return "compare";
+        case op::copy:           return "copy";
+        case op::transcendental: return "transcendental";
+    }
+    return "";
+}
+
+
+}  // namespace seq_stats
+}  // namespace am
+
+
+
+#ifdef AM_SEQUENCE_STATS
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+
+#if defined(__GNUC__) || defined(__clang__)
+#  include <cstdlib>
+#  include <cxxabi.h>
+#endif
+
+
+namespace am {
+namespace seq_stats {
+
+
+/*************************************************************************//***
+ *
+ * @brief operation counters of one sequence type in one thread
+ *
+ *****************************************************************************/
+struct counters
+{
+    const std::type_info* type = nullptr;
+    std::uint64_t count[op_count] = {};
+    counters* next = nullptr;
+
+    std::uint64_t
+    operator [] (op o) const noexcept {
+        return count[int(o)];
+    }
+};
+
+
+namespace detail {
+
+//-------------------------------------------------------------------
+/// head of the calling thread's intrusive list of counters;
+/// registration never allocates, so counting can be noexcept
+inline counters*&
+registry() noexcept
+{
+    thread_local counters* head = nullptr;
+    return head;
+}
+
+//-------------------------------------------------------------------
+template<class Sequence>
+struct registered_counters : public counters
+{
+    registered_counters() noexcept {
+        type = &typeid(Sequence);
+        next = registry();
+        registry() = this;
+    }
+};
+
+//-------------------------------------------------------------------
+inline std::string
+demangle(const std::type_info& t)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    int status = 0;
+    char* s = abi::__cxa_demangle(t.name(), nullptr, nullptr, &status);
+    if(status == 0 && s) {
+        std::string res{s};
+        std::free(s);
+        return res;
+    }
+#endif
+    return t.name();
+}
+
+}  // namespace detail
+
+
+
+//-------------------------------------------------------------------
+/// counters of sequence type 'Sequence' in the calling thread
+template<class Sequence>
+inline counters&
+local() noexcept
+{
+    thread_local detail::registered_counters<Sequence> c;
+    return c;
+}
+
+//-------------------------------------------------------------------
+template<class Sequence>
+inline void
+count(op o) noexcept
+{
+    ++local<Sequence>().count[int(o)];
+}
+
+//-------------------------------------------------------------------
+/// number of 'o' operations of sequence type 'Sequence' in this thread
+template<class Sequence>
+inline std::uint64_t
+get(op o)
+{
+    return local<Sequence>()[o];
+}
+
+
+//-------------------------------------------------------------------
+/// resets all counters of the calling thread
+inline void
+reset()
+{
+    for(auto c = detail::registry(); c; c = c->next) {
+        for(auto& x : c->count) x = 0;
+    }
+}
+
+
+//-------------------------------------------------------------------
+/// writes all non-zero counters of the calling thread to 'os'
+inline void
+dump(std::ostream& os)
+{
+    auto sorted = std::map<std::string,const counters*>{};
+    for(auto c = detail::registry(); c; c = c->next) {
+        sorted.emplace(detail::demangle(*c->type), c);
+    }
+    for(const auto& e : sorted) {
+        bool any = false;
+        for(auto x : e.second->count) any = any || (x > 0);
+        if(!any) continue;
+
+        os << e.first << '\n';
+        for(int i = 0; i < op_count; ++i) {
+            if(e.second->count[i] > 0) {
+                os << "    " << op_name(op(i)) << ": "
+                   << e.second->count[i] << '\n';
+            }
+        }
+    }
+}
+
+
+
+/*************************************************************************//***
+ *
+ * @brief (empty) base class of all sequence types that counts copies
+ *
+ *****************************************************************************/
+template<class Sequence>
+class tracked
+{
+protected:
+    constexpr tracked() noexcept = default;
+
+    tracked(const tracked&) noexcept {
+        count<Sequence>(op::copy);
+    }
+    tracked(tracked&&) noexcept = default;
+
+    tracked& operator = (const tracked&) noexcept {
+        count<Sequence>(op::copy);
+        return *this;
+    }
+    tracked& operator = (tracked&&) noexcept = default;
+};
+
+
+}  // namespace seq_stats
+}  // namespace am
+
+
+#define AMLIB_SEQUENCE_COUNT(o) \
+    ::am::seq_stats::count<std::decay_t<decltype(*this)>>( \
+        ::am::seq_stats::op::o)
+
+
+#else
+
+
+namespace am {
+namespace seq_stats {
+
+template<class Sequence>
+class tracked {};
+
+}  // namespace seq_stats
+}  // namespace am
+
+
+#define AMLIB_SEQUENCE_COUNT(o)
+
+
+#endif
+
+
+#endif
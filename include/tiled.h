@@ -0,0 +1,399 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AMLIB_NUMERIC_TILED_SEQUENCE_H_
+#define AMLIB_NUMERIC_TILED_SEQUENCE_H_
+
+
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+#include "concepts.h"
+#include "num_equality.h"
+#include "segmented.h"
+#include "stats.h"
+
+
+namespace am {
+
+
+/*************************************************************************//***
+ *
+ * @brief repeats an underlying sequence a number of times ('tiles') and
+ *        adds a constant offset to all values of each repetition:
+ *        v(i) = s[i % s.size()] + (i / s.size()) * offset
+ *
+ *        e.g. tiles of {0..7} with offset 16: 0..7, 16..23, 32..39, ...
+ *
+ *****************************************************************************/
+template<class Sequence>
+class tiled_sequence :
+    private seq_stats::tracked<tiled_sequence<Sequence>>
+{
+public:
+    //---------------------------------------------------------------
+    using sequence_type = Sequence;
+    //-----------------------------------------------------
+    using iterator_category = std::input_iterator_tag;
+    using difference_type = typename sequence_type::difference_type;
+    using size_type = typename sequence_type::size_type;
+    //-----------------------------------------------------
+    using value_type = std::decay_t<typename sequence_type::value_type>;
+    using reference = const value_type&;
+    using pointer = value_type*;
+
+
+    //---------------------------------------------------------------
+    constexpr explicit
+    tiled_sequence(
+        sequence_type sequence = sequence_type(),
+        size_type tiles = 1,
+        value_type offset = value_type(0))
+    :
+        curSequ_{tiles > 0 ? sequence : sequence.end()},
+        tileSequ_{std::move(sequence)},
+        tile_((tiles > 0 && tileSequ_.empty()) ? (tiles - 1) : 0),
+        numTiles_(tiles),
+        offset_{offset}, shift_(value_type(tile_) * offset)
+    {}
+
+
+    //---------------------------------------------------------------
+    value_type
+    operator * () const {
+        return *curSequ_ + shift_;
+    }
+    //-----------------------------------------------------
+    value_type
+    operator [] (size_type offset) const
+    {
+        AMLIB_SEQUENCE_COUNT(subscript);
+        const auto nfst = curSequ_.size();
+        if(offset >= nfst) {
+            offset -= nfst;
+            const auto n = tileSequ_.size();
+            if(n < 1) return curSequ_[offset + nfst] + shift_;
+            return tileSequ_[offset % n] + shift_ +
+                   (value_type((offset / n) + 1) * offset_);
+        }
+        return curSequ_[offset] + shift_;
+    }
+
+
+    //---------------------------------------------------------------
+    tiled_sequence&
+    operator ++ ()
+    {
+        AMLIB_SEQUENCE_COUNT(increment);
+        ++curSequ_;
+        if(curSequ_.empty() && ((tile_ + 1) < numTiles_)) {
+            ++tile_;
+            shift_ += offset_;
+            curSequ_ = tileSequ_;
+        }
+        return *this;
+    }
+    //-----------------------------------------------------
+    tiled_sequence&
+    operator += (size_type offset)
+    {
+        AMLIB_SEQUENCE_COUNT(advance);
+        const auto nfst = curSequ_.size();
+        if(offset < nfst) {
+            curSequ_ += offset;
+            return *this;
+        }
+        offset -= nfst;
+        const auto n = tileSequ_.size();
+        if(n < 1) {
+            *this = end();
+            return *this;
+        }
+        const auto k = offset / n;
+
+        if((tile_ + k + 1) < numTiles_) {
+            tile_ += k + 1;
+            shift_ = value_type(tile_) * offset_;
+            curSequ_ = tileSequ_;
+            curSequ_ += offset % n;
+        } else {
+            *this = end();
+        }
+        return *this;
+    }
+    //-----------------------------------------------------
+    tiled_sequence
+    operator + (size_type offset) const {
+        auto res = *this;
+        res += offset;
+        return res;
+    }
+    //-----------------------------------------------------
+    /**
+     * @brief writes up to 'max' values to 'out' and advances past them;
+     *        each tile is one batch of the underlying sequence followed
+     *        by a vectorizable add loop
+     */
+    size_type
+    next_batch(value_type* out, size_type max)
+    {
+        size_type n = 0;
+        for(;;) {
+            const auto m = am::next_batch(curSequ_, out + n, max - n);
+            for(size_type i = n; i < n + m; ++i) {
+                out[i] += shift_;
+            }
+            n += m;
+            if(!curSequ_.empty() || (tile_ + 1) >= numTiles_) break;
+            ++tile_;
+            shift_ += offset_;
+            curSequ_ = tileSequ_;
+            if(n >= max) break;
+        }
+        return n;
+    }
+
+
+    //---------------------------------------------------------------
+    const sequence_type&
+    tile_sequence() const noexcept {
+        return tileSequ_;
+    }
+    //-----------------------------------------------------
+    const value_type&
+    tile_offset() const noexcept {
+        return offset_;
+    }
+    //-----------------------------------------------------
+    size_type
+    tiles() const noexcept {
+        return numTiles_;
+    }
+    //-----------------------------------------------------
+    size_type
+    current_tile() const noexcept {
+        return tile_;
+    }
+
+
+    //---------------------------------------------------------------
+    value_type
+    front() const {
+        return *(*this);
+    }
+    //-----------------------------------------------------
+    value_type
+    back() const {
+        return tileSequ_.back() + (value_type(numTiles_ - 1) * offset_);
+    }
+    //-----------------------------------------------------
+    size_type
+    size() const {
+        AMLIB_SEQUENCE_COUNT(size);
+        return empty()
+            ? size_type(0)
+            : curSequ_.size() + ((numTiles_ - tile_ - 1) * tileSequ_.size());
+    }
+    //-----------------------------------------------------
+    bool
+    empty() const {
+        return curSequ_.empty() && ((tile_ + 1) >= numTiles_);
+    }
+    //-----------------------------------------------------
+    explicit operator
+    bool() const {
+        return !empty();
+    }
+
+
+    //---------------------------------------------------------------
+    const tiled_sequence&
+    begin() const noexcept {
+        return *this;
+    }
+    //-----------------------------------------------------
+    tiled_sequence
+    end() const {
+        AMLIB_SEQUENCE_COUNT(end);
+        const auto last = (numTiles_ > 0) ? (numTiles_ - 1) : size_type(0);
+        return tiled_sequence{tileSequ_.end(), tileSequ_, last, numTiles_,
+                              offset_, value_type(last) * offset_};
+    }
+
+
+    //---------------------------------------------------------------
+    /**
+     * @brief writes all remaining values to 'out'
+     */
+    template<class OutputIterator>
+    OutputIterator
+    copy_to(OutputIterator out) const
+    {
+        if(empty()) return out;
+
+        for(auto s = curSequ_; !s.empty(); ++s, ++out) {
+            *out = *s + shift_;
+        }
+        auto shift = shift_;
+        for(auto t = tile_ + 1; t < numTiles_; ++t) {
+            shift += offset_;
+            for(auto s = tileSequ_; !s.empty(); ++s, ++out) {
+                *out = *s + shift;
+            }
+        }
+        return out;
+    }
+    //-----------------------------------------------------
+    /**
+     * @brief writes all remaining values to 'out';
+     *        only the first full tile is generated from the underlying
+     *        sequence, all others are computed from it with a
+     *        vectorizable add loop
+     */
+    value_type*
+    copy_to(value_type* out) const
+    {
+        if(empty()) return out;
+
+        const auto nfst = curSequ_.size();
+        auto s = curSequ_;
+        for(size_type i = 0; i < nfst; ++i, ++s) {
+            out[i] = *s + shift_;
+        }
+        out += nfst;
+        if((tile_ + 1) >= numTiles_) return out;
+
+        const auto n = tileSequ_.size();
+        const value_type* base = out;
+        s = tileSequ_;
+        for(size_type i = 0; i < n; ++i, ++s) {
+            out[i] = *s + shift_ + offset_;
+        }
+        out += n;
+
+        auto delta = offset_;
+        for(auto t = tile_ + 2; t < numTiles_; ++t, delta += offset_) {
+            for(size_type i = 0; i < n; ++i) {
+                out[i] = base[i] + delta;
+            }
+            out += n;
+        }
+        return out;
+    }
+
+
+    //---------------------------------------------------------------
+    bool
+    operator == (const tiled_sequence& o) const {
+        AMLIB_SEQUENCE_COUNT(compare);
+        return
+            (tile_ == o.tile_) &&
+            (numTiles_ == o.numTiles_) &&
+            (curSequ_ == o.curSequ_) &&
+            (tileSequ_ == o.tileSequ_) &&
+            default_equality<value_type>::equal(offset_, o.offset_);
+    }
+    //-----------------------------------------------------
+    bool
+    operator != (const tiled_sequence& o) const {
+        return !(*this == o);
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    constexpr explicit
+    tiled_sequence(
+        sequence_type cur, sequence_type tile,
+        size_type curTile, size_type numTiles,
+        value_type offset, value_type shift)
+    :
+        curSequ_{std::move(cur)}, tileSequ_{std::move(tile)},
+        tile_(curTile), numTiles_(numTiles),
+        offset_{offset}, shift_{shift}
+    {}
+
+
+    //---------------------------------------------------------------
+    sequence_type curSequ_;
+    sequence_type tileSequ_;
+    size_type tile_, numTiles_;
+    value_type offset_;
+    value_type shift_;
+};
+
+
+
+
+
+
+
+
+/*****************************************************************************
+ *
+ * NON-MEMBER BEGIN/END
+ *
+ *****************************************************************************/
+template<class S>
+inline decltype(auto)
+begin(const tiled_sequence<S>& s) {
+    return s.begin();
+}
+//-----------------------------------------------------
+template<class S>
+inline decltype(auto)
+cbegin(const tiled_sequence<S>& s) {
+    return s.begin();
+}
+
+//-----------------------------------------------------
+template<class S>
+inline decltype(auto)
+end(const tiled_sequence<S>& s) {
+    return s.end();
+}
+//-----------------------------------------------------
+template<class S>
+inline decltype(auto)
+cend(const tiled_sequence<S>& s) {
+    return s.end();
+}
+
+
+
+
+
+
+
+
+/*****************************************************************************
+ *
+ * FACTORIES
+ *
+ *****************************************************************************/
+template<class Sequence, class Offset>
+#if AMLIB_SEQUENCE_CONCEPTS
+    requires am::Sequence<std::decay_t<Sequence>>
+#endif
+inline constexpr auto
+make_tiled_sequence(Sequence&& seq, std::size_t tiles, Offset&& offset)
+{
+    using seq_t = std::decay_t<Sequence>;
+    using value_t = std::decay_t<typename seq_t::value_type>;
+
+    return tiled_sequence<seq_t>{std::forward<Sequence>(seq), tiles,
+                                 value_t(std::forward<Offset>(offset))};
+}
+
+
+} //namespace am
+
+#endif
@@ -0,0 +1,158 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include "adaptors.h"
+#include "linear.h"
+#include "combined.h"
+#include "repeated.h"
+
+#include <vector>
+#include <iostream>
+
+
+
+//-------------------------------------------------------------------
+template<class Sequence, class T>
+void check_values(const Sequence& g, const std::vector<T>& expected,
+                  const char* msg)
+{
+    auto v = std::vector<T>{};
+    for(auto x : g) v.push_back(x);
+
+    if(v != expected) throw std::logic_error(msg);
+}
+
+
+//-------------------------------------------------------------------
+template<class Sequence, class T>
+void check(const Sequence& g, const std::vector<T>& expected,
+           const char* msg)
+{
+    check_values(g, expected, msg);
+
+    if(g.size() != expected.size()) throw std::logic_error(msg);
+
+    for(std::size_t i = 0; i < expected.size(); ++i) {
+        if(g[i] != expected[i] || *(g + i) != expected[i]) {
+            throw std::logic_error(msg);
+        }
+    }
+    if((g + expected.size()) != g.end()) throw std::logic_error(msg);
+}
+
+
+//-------------------------------------------------------------------
+void sequence_adaptors()
+{
+    using namespace am;
+    using lin_t = linear_sequence<int>;
+
+    check(lin_t{0,1,5} | transform([](int x) { return x * x; }),
+          std::vector<int>{0,1,4,9,16,25}, "transform");
+
+    check_values(lin_t{0,1,10} | filter([](int x) { return x % 3 == 0; }),
+                 std::vector<int>{0,3,6,9}, "filter");
+
+    check(lin_t{0,1,10} | take(4),
+          std::vector<int>{0,1,2,3}, "take");
+
+    check(lin_t{0,1,2} | take(4),
+          std::vector<int>{0,1,2}, "take");
+
+    check(lin_t{0,1,10} | drop(7),
+          std::vector<int>{7,8,9,10}, "drop");
+
+    check(lin_t{0,1,10} | stride(3),
+          std::vector<int>{0,3,6,9}, "stride");
+
+    check(lin_t{0,1,9} | stride(3),
+          std::vector<int>{0,3,6,9}, "stride");
+
+    check(lin_t{0,1,3} | zip(lin_t{10,10,100}),
+          std::vector<std::pair<int,int>>{{0,10},{1,20},{2,30},{3,40}}, "zip");
+
+    check(lin_t{5,-1,3} | enumerate(),
+          std::vector<std::pair<std::size_t,int>>{{0,5},{1,4},{2,3}},
+          "enumerate");
+
+    //sources without size
+    check_values(ascending_sequence<int>{0,9}
+                     | filter([](int x) { return x % 4 == 1; })
+                     | enumerate(),
+                 std::vector<std::pair<std::size_t,int>>{{0,1},{1,5},{2,9}},
+                 "filter | enumerate");
+
+    check_values(lin_t{0,1,20}
+                     | filter([](int x) { return x % 2 == 0; })
+                     | stride(3),
+                 std::vector<int>{0,6,12,18}, "filter | stride");
+
+    check_values(lin_t{0,1,20}
+                     | filter([](int x) { return x % 2 == 0; })
+                     | stride(4) | take(2),
+                 std::vector<int>{0,8}, "filter | stride | take");
+
+    //pipelines
+    check_values(lin_t{0,1,100}
+                     | filter([](int x) { return x % 2 == 0; })
+                     | transform([](int x) { return x / 2; })
+                     | drop(3) | take(5),
+                 std::vector<int>{3,4,5,6,7}, "pipeline");
+
+    check(lin_t{0,1,100} | stride(10) | transform([](int x) { return -x; })
+              | take(4) | enumerate(),
+          std::vector<std::pair<std::size_t,int>>{{0,0},{1,-10},{2,-20},{3,-30}},
+          "pipeline");
+
+    //adaptors within decorators
+    {
+        auto g = make_repeated_sequence(
+            lin_t{0,1,2} | transform([](int x) { return 10 * x; }), 2);
+
+        check(g, std::vector<int>{0,10,20, 0,10,20, 0,10,20},
+              "repeated transform");
+
+        if(am::sum(g) != 90) {
+            throw std::logic_error("transform: segmented sum");
+        }
+    }
+
+    {
+        auto g = make_combined_sequence(lin_t{0,1,2}, lin_t{5,1,6})
+                     | transform([](int x) { return x + 1; });
+
+        int segments = 0;
+        for_each_segment(g, [&](const auto&) { ++segments; });
+        if(segments != 2) {
+            throw std::logic_error("transform: for_each_segment");
+        }
+
+        auto v = std::vector<int>{};
+        am::copy(g, std::back_inserter(v));
+        if(v != std::vector<int>{1,2,3,6,7}) {
+            throw std::logic_error("transform: copy");
+        }
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        sequence_adaptors();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what();
+        return 1;
+    }
+}
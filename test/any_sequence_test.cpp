@@ -0,0 +1,175 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include "any_sequence.h"
+#include "adaptors.h"
+#include "combined.h"
+#include "fibonacci.h"
+#include "linear.h"
+#include "parallel.h"
+#include "primes.h"
+#include "repeated.h"
+#include "tiled.h"
+
+#include <cstdint>
+#include <vector>
+#include <iostream>
+
+
+
+//-------------------------------------------------------------------
+template<class T, std::size_t B, class Sequence>
+void check(const am::any_sequence<T,B>& s, const Sequence& ref,
+           const char* msg)
+{
+    auto expected = std::vector<T>{};
+    for(auto x : ref) expected.push_back(T(x));
+    const auto n = expected.size();
+
+    auto v = std::vector<T>{};
+    for(auto x : s) v.push_back(x);
+    if(v != expected || s.size() != n || s.empty() != (n == 0)) {
+        throw std::logic_error(msg);
+    }
+
+    for(std::size_t i = 0; i < n; ++i) {
+        if(*(s + i) != expected[i] || (s + i).size() != n - i) {
+            throw std::logic_error(msg);
+        }
+    }
+    if(!(s + n).empty() || (s + n) != s.end() || (s + (n + 5)) != s.end()) {
+        throw std::logic_error(msg);
+    }
+
+    //batches after partial iteration
+    for(std::size_t b : {1, 5, 16, 100}) {
+        auto t = s;
+        ++t; ++t; ++t;
+        auto got = std::vector<T>(n);
+        const auto first = std::min(n, std::size_t(3));
+        std::size_t k = first;
+        for(std::size_t m; (m = am::next_batch(t, got.data() + k,
+                                std::min(b, n - k))) > 0; k += m) {}
+        got.erase(got.begin(), got.begin() + first);
+        if(k != n || !t.empty() ||
+           !std::equal(got.begin(), got.begin() + (n - first),
+                       expected.begin() + first))
+        {
+            throw std::logic_error(msg);
+        }
+    }
+
+    auto u = std::vector<T>(n);
+    am::parallel_fill(s, u.data(), n, 3);
+    if(u != expected) throw std::logic_error(msg);
+}
+
+
+
+//-------------------------------------------------------------------
+void any_sequence_values()
+{
+    using namespace am;
+    using lin_t = linear_sequence<int>;
+
+    check(any_sequence<int>{lin_t{-5, 3, 400}}, lin_t{-5, 3, 400}, "linear");
+    check(any_sequence<int>{lin_t{0, 1, -1}}, lin_t{0, 1, -1}, "linear: empty");
+    check(any_sequence<int>{}, lin_t{0, 1, -1}, "default");
+
+    //value conversion
+    check(any_sequence<double>{lin_t{0, 1, 99}}, lin_t{0, 1, 99}, "convert");
+
+    const auto comb = make_combined_sequence(
+        make_repeated_sequence(lin_t{0, 1, 9}, 4),
+        make_tiled_sequence(lin_t{0, 2, 8}, 3, 100));
+    check(any_sequence<int>{comb}, comb, "combined");
+
+    //sequences without size
+    const auto odd = lin_t{0, 1, 299} | filter([](int x) { return x % 2; });
+    check(any_sequence<int>{odd}, odd, "filter");
+
+    check(any_sequence<std::uint64_t>{fibonacci_sequence<>{60}},
+          fibonacci_sequence<>{60}, "fibonacci");
+
+    check(any_sequence<std::uint64_t>{prime_sequence<>{2, 5000}},
+          prime_sequence<>{2, 5000}, "primes");
+}
+
+
+
+//-------------------------------------------------------------------
+void any_sequence_storage()
+{
+    using namespace am;
+    using lin_t = linear_sequence<int>;
+
+    //typical sequences are stored inline
+    auto a = any_sequence<int>{lin_t{0, 1, 99}};
+    auto c = any_sequence<int>{make_combined_sequence(
+        make_repeated_sequence(lin_t{0, 1, 9}, 4),
+        make_tiled_sequence(lin_t{0, 2, 8}, 3, 100))};
+    if(!a.stored_inline() || !c.stored_inline()) {
+        throw std::logic_error("any_sequence: inline storage");
+    }
+
+    //larger ones go to the heap
+    auto h = any_sequence<int,8>{
+        make_combined_sequence(lin_t{0,1,9}, lin_t{10,1,19})};
+    if(h.stored_inline() || h.size() != 20) {
+        throw std::logic_error("any_sequence: heap storage");
+    }
+
+    //copies are independent
+    ++h;
+    auto h2 = h;
+    h2 += 10;
+    if(*h != 1 || *h2 != 11 || h.size() != 19 || h2.size() != 9) {
+        throw std::logic_error("any_sequence: copy");
+    }
+
+    //moves leave the source empty
+    auto m = std::move(h);
+    auto mi = std::move(a);
+    if(*m != 1 || !h.empty() || *mi != 0 || mi.size() != 100 || !a.empty()) {
+        throw std::logic_error("any_sequence: move");
+    }
+
+    //assignment replaces the wrapped sequence;
+    //any_sequences of other types are wrapped as well
+    m = c;
+    mi = std::move(h2);
+    if(*m != 0 || m.size() != c.size() || *mi != 11 || mi.size() != 9) {
+        throw std::logic_error("any_sequence: assignment");
+    }
+
+    //skipping within and past the buffered block
+    auto s = any_sequence<int>{lin_t{0, 1, 999}};
+    if(*s != 0 || *(s += 5) != 5 || *(s += 100) != 105 ||
+       *(s += 894) != 999 || !(s += 1).empty())
+    {
+        throw std::logic_error("any_sequence: advance");
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        any_sequence_values();
+        any_sequence_storage();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what();
+        return 1;
+    }
+}
@@ -0,0 +1,261 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include "adaptors.h"
+#include "cached.h"
+#include "combination.h"
+#include "combined.h"
+#include "compressed.h"
+#include "fibonacci.h"
+#include "geometric.h"
+#include "gray_code.h"
+#include "interleaved_bits.h"
+#include "linear.h"
+#include "linspace.h"
+#include "low_discrepancy.h"
+#include "permutation.h"
+#include "primes.h"
+#include "random.h"
+#include "repeated.h"
+#include "replica.h"
+#include "segmented.h"
+#include "sobol.h"
+#include "tiled.h"
+
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include <iostream>
+
+
+
+//-------------------------------------------------------------------
+/**
+ * @brief pulls (at most) the first 'n' values in batches of different
+ *        sizes and compares them to element-wise iteration;
+ *        checks the position after the batches
+ */
+template<class Sequence>
+void check_batches(const Sequence& s, std::size_t n, const char* msg)
+{
+    using T = std::decay_t<typename Sequence::value_type>;
+
+    auto expected = std::vector<T>{};
+    auto t = s;
+    for(; expected.size() < n && !t.empty(); ++t) expected.push_back(*t);
+    const bool more = !t.empty();
+    const auto next = more ? T(*t) : T{};
+
+    for(std::size_t b : {1, 2, 7, 64, 100, 1000}) {
+        auto buf = std::unique_ptr<T[]>{new T[b]};
+        auto got = std::vector<T>{};
+        auto u = s;
+        while(got.size() < expected.size()) {
+            const auto want = std::min(b, expected.size() - got.size());
+            const auto k = am::next_batch(u, buf.get(), want);
+            if(k > want) throw std::logic_error(msg);
+            got.insert(got.end(), buf.get(), buf.get() + k);
+            if(k < want) break;
+        }
+        if(got != expected || u.empty() == more || (more && !(*u == next))) {
+            throw std::logic_error(msg);
+        }
+        //exhausted sequences yield nothing
+        if(!more && am::next_batch(u, buf.get(), b) != 0) {
+            throw std::logic_error(msg);
+        }
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+void generator_batches()
+{
+    using namespace am;
+
+    for(int n : {0, 1, 5, 100, 1000}) {
+        check_batches(linear_sequence<int>{-3, 7, 7*n - 4}, n+1, "linear");
+        check_batches(make_ascending_sequence(2, n), n+1, "ascending");
+        check_batches(make_descending_sequence(n, -3), n+1, "descending");
+    }
+    check_batches(linear_sequence<double>{0.5, 0.25, 100.0}, 1000, "linear: fp");
+    check_batches(linear_sequence<int>{}, 300, "linear: unbounded");
+
+    check_batches(make_geometric_sequence(1.0, 2.0, 1e30), 200, "geometric");
+    check_batches(fibonacci_sequence<>{80}, 100, "fibonacci");
+    check_batches(fibonacci_sequence<>{}, 60, "fibonacci: unbounded");
+
+    check_batches(offset_interleaved_bit_sequence{10, 3, 5}, 100, "bits");
+    check_batches(offset_interleaved_bit_sequence{100, 0, 0}, 200, "bits: dense");
+    check_batches(offset_interleaved_bit_sequence{17, 70, 9}, 2000, "bits: sparse");
+
+    check_batches(random_sequence<>{42, 500}, 600, "random");
+    check_batches(random_sequence<double>{7}, 300, "random: unbounded");
+
+    check_batches(linspace(-1.0, 2.0, 301), 400, "linspace");
+
+    check_batches(make_halton_sequence<double,3>(700), 800, "halton");
+    check_batches(make_kronecker_sequence<double,2>(700), 800, "kronecker");
+    check_batches(make_sobol_sequence<double,4>(700), 800, "sobol");
+
+    check_batches(make_combination_sequence(12, 5), 1000, "combination");
+    check_batches(make_combination_sequence(7, 0), 10, "combination: empty set");
+    check_batches(permutation_sequence<6>{}, 800, "permutation");
+    check_batches(make_gray_code_sequence<std::uint16_t>(10), 2000, "gray code");
+
+    check_batches(prime_sequence<>{}, 5000, "primes");
+    check_batches(prime_sequence<>{1000000000000ull}, 3000, "primes: large");
+    check_batches(prime_sequence<std::uint32_t>{3, 1000}, 1000, "primes: range");
+
+    //logspace batches share exp evaluations; values match up to rounding
+    auto lg = logspace(1.0, 1e8, 301);
+    double v[301];
+    if(next_batch(lg, v, 301) != 301 || !lg.empty() ||
+       v[0] != 1.0 || v[300] != 1e8 || std::abs(v[150] / 1e4 - 1) > 1e-13)
+    {
+        throw std::logic_error("logspace");
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+void decorator_batches()
+{
+    using namespace am;
+    using lin_t = linear_sequence<int>;
+
+    for(std::size_t r : {0, 1, 3, 50}) {
+        check_batches(make_repeated_sequence(lin_t{0,1,9}, r), 1000, "repeated");
+        check_batches(make_repeated_sequence(lin_t{5,1,9}, lin_t{0,1,9}, r),
+                      1000, "repeated: first");
+        check_batches(make_cached_repeated_sequence(lin_t{0,1,9}, r), 1000,
+                      "repeated: memoized");
+        check_batches(make_cached_repeated_sequence(lin_t{7,1,9}, lin_t{0,1,9}, r),
+                      1000, "repeated: memoized first");
+        check_batches(make_compact_repeated_sequence(lin_t{0,1,9}, r), 1000,
+                      "repeated: compact");
+        check_batches(make_tiled_sequence(lin_t{0,1,7}, r, 16), 1000, "tiled");
+    }
+    check_batches(make_repeated_sequence(lin_t{0,1,9}, 3) + 13, 1000,
+                  "repeated: offset");
+    check_batches(make_cached_repeated_sequence(lin_t{0,1,9}, 3) + 13, 1000,
+                  "repeated: memoized offset");
+    check_batches(make_tiled_sequence(lin_t{0,1,7}, 5, 16) + 11, 1000,
+                  "tiled: offset");
+
+    //empty repeat sequence: batches must not walk the repetitions
+    check_batches(make_repeated_sequence(lin_t{0,1,2}, lin_t{1,1,0},
+                                         3000000000u), 10,
+                  "repeated: empty period");
+    check_batches(make_cached_repeated_sequence(lin_t{0,1,2}, lin_t{1,1,0},
+                                                3000000000u), 10,
+                  "repeated: memoized empty period");
+    check_batches(make_compact_repeated_sequence(lin_t{0,1,2}, lin_t{1,1,0},
+                                                 3000000000u), 10,
+                  "repeated: compact empty period");
+
+    check_batches(make_combined_sequence(lin_t{0,1,9}, lin_t{20,2,40}), 100,
+                  "combined");
+    check_batches(make_combined_sequence(lin_t{0,1,9}, lin_t{1,1,1},
+                                         lin_t{20,2,40}, lin_t{-5,1,-1}),
+                  100, "combined: N");
+    check_batches(make_combined_sequence(std::vector<lin_t>{
+                      lin_t{0,1,9}, lin_t{1,1,1}, lin_t{20,2,40}}),
+                  100, "combined: dynamic");
+    check_batches(make_combined_sequence(
+                      make_repeated_sequence(lin_t{0,1,3}, 5),
+                      make_tiled_sequence(lin_t{0,1,3}, 5, 100)),
+                  100, "combined: nested");
+
+    const auto lin = lin_t{0,1,299};
+    check_batches(lin | transform([](int x) { return 0.5 * x; }), 400,
+                  "transform");
+    check_batches(lin | filter([](int x) { return x % 3 == 1; }), 400,
+                  "filter");
+    check_batches(lin | filter([](int x) { return x > 1000; }), 400,
+                  "filter: none");
+    check_batches(lin | take(150), 400, "take");
+    check_batches(lin | stride(7), 400, "stride");
+    check_batches(lin | zip(lin_t{5,1,100}), 400, "zip");
+    check_batches(lin | filter([](int x) { return x % 3 == 1; })
+                      | zip(lin_t{5,1,100}), 400, "zip: no size");
+    check_batches(lin_t{5,1,100}
+                      | zip(lin | filter([](int x) { return x % 3; })),
+                  400, "zip: no size second");
+    check_batches(lin | enumerate(), 400, "enumerate");
+    check_batches(lin | filter([](int x) { return x % 2 == 0; })
+                      | transform([](int x) { return x / 2; }),
+                  400, "filter | transform");
+
+    check_batches(make_cached_sequence<16>(lin), 400, "cached");
+    check_batches(make_cached_sequence<16>(lin) + 3, 400, "cached: offset");
+
+    const auto data = std::vector<int>{1,2,3,4,1,2,3,4,9,9,9,0,5,10,15,7};
+    check_batches(compress(data.data(), data.size()), 100, "compressed");
+    check_batches(compress(data.data(), data.size()) + 5, 100,
+                  "compressed: offset");
+}
+
+
+
+//-------------------------------------------------------------------
+void batch_state()
+{
+    using namespace am;
+    using lin_t = linear_sequence<int>;
+
+    //buffered values are copied, the rest is pulled in one batch
+    auto c = make_cached_sequence<16>(lin_t{0,1,99});
+    int buf[100];
+    if(c[3] != 3 || next_batch(c, buf, 10) != 10 || buf[9] != 9 ||
+       c.hits() != 4 || c.misses() != 2 || c.lookback(10) != 0 ||
+       c.lookback_size() != 10 || *c != 10)
+    {
+        throw std::logic_error("cached: batch state");
+    }
+
+    //Gray codes continue with the right changed bit
+    auto g = make_gray_code_sequence<std::uint8_t>(8);
+    std::uint8_t codes[10];
+    if(next_batch(g, codes, 10) != 10 || g.index() != 10 ||
+       *g != 15 || g.changed_bit() != 1)
+    {
+        throw std::logic_error("gray code: batch state");
+    }
+
+    //replicas have no end detection besides the batch result
+    auto r = replicas(7, 5);
+    int seven[8];
+    if(next_batch(r, seven, 8) != 5 || seven[4] != 7 ||
+       next_batch(r, seven, 8) != 0)
+    {
+        throw std::logic_error("replicas");
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        generator_batches();
+        decorator_batches();
+        batch_state();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what();
+        return 1;
+    }
+}
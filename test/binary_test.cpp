@@ -0,0 +1,172 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include "binary.h"
+#include "linear.h"
+#include "combined.h"
+#include "repeated.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include <iostream>
+
+
+
+//-------------------------------------------------------------------
+template<class Sequence>
+void check_roundtrip(const Sequence& g, std::size_t chunkBytes)
+{
+    using value_t = std::decay_t<decltype(*g)>;
+
+    const char* filename = "binary_test.tmp";
+
+    auto expected = std::vector<value_t>{};
+    for(auto x : g) expected.push_back(x);
+
+    if(am::write_binary(g, filename, chunkBytes) != expected.size()) {
+        throw std::logic_error("write_binary: count");
+    }
+
+    {
+        auto s = am::open_binary_sequence<value_t>(filename);
+
+        if(s.size() != expected.size()) {
+            throw std::logic_error("mapped_sequence: size");
+        }
+        auto v = std::vector<value_t>{};
+        for(auto x : s) v.push_back(x);
+        if(v != expected) {
+            throw std::logic_error("mapped_sequence: values");
+        }
+        for(std::size_t i = 0; i < expected.size(); i += 7) {
+            if(s[i] != expected[i] || *(s + i) != expected[i]) {
+                throw std::logic_error("mapped_sequence: random access");
+            }
+        }
+        if((s + expected.size()) != s.end() || !(s + expected.size()).empty()) {
+            throw std::logic_error("mapped_sequence: end");
+        }
+    }
+
+    //wrong value type
+    bool thrown = false;
+    try {
+        am::open_binary_sequence<char>(filename);
+    }
+    catch(std::runtime_error&) {
+        thrown = true;
+    }
+
+    std::remove(filename);
+
+    if(!thrown) throw std::logic_error("mapped_sequence: type check");
+}
+
+
+//-------------------------------------------------------------------
+/// claims more values than its batches deliver
+struct short_sequence
+{
+    using value_type = int;
+
+    int operator * () const { return i_; }
+    short_sequence& operator ++ () { ++i_; return *this; }
+    bool empty() const { return i_ >= 10; }
+    std::size_t size() const { return 100; }
+
+    std::size_t next_batch(int* out, std::size_t max) {
+        std::size_t n = 0;
+        for(; n < max && !empty(); ++n, ++*this) out[n] = i_;
+        return n;
+    }
+
+    int i_ = 0;
+};
+
+
+//-------------------------------------------------------------------
+void binary_header_checks()
+{
+    const char* filename = "binary_test.tmp";
+
+    //header count matches the values actually written
+    if(am::write_binary(short_sequence{}, filename, 16) != 10 ||
+       am::open_binary_sequence<int>(filename).size() != 10)
+    {
+        std::remove(filename);
+        throw std::logic_error("write_binary: short sequence");
+    }
+
+    //unknown format version
+    auto f = std::fopen(filename, "r+b");
+    const std::uint32_t version = 2;
+    std::fseek(f, offsetof(am::binary_header, version), SEEK_SET);
+    std::fwrite(&version, sizeof(version), 1, f);
+    std::fclose(f);
+
+    bool thrown = false;
+    try {
+        am::open_binary_sequence<int>(filename);
+    }
+    catch(std::runtime_error&) {
+        thrown = true;
+    }
+    std::remove(filename);
+
+    if(!thrown) throw std::logic_error("mapped_sequence: version check");
+}
+
+
+//-------------------------------------------------------------------
+void binary_io()
+{
+    using namespace am;
+    using lin_t = linear_sequence<int>;
+
+    check_roundtrip(lin_t{0,1,10000}, 1 << 12);
+    check_roundtrip(lin_t{0,1,10000}, 1000);
+    check_roundtrip(lin_t{1,1,0}, 1 << 12);
+
+    check_roundtrip(make_combined_sequence(
+                        lin_t{0,1,500}, lin_t{-3,-1,-900}), 1 << 10);
+
+    check_roundtrip(make_repeated_sequence(
+                        linear_sequence<double>{0.5,0.25,20.0}, 30), 100);
+
+    check_roundtrip(linear_sequence<std::uint64_t>{1,3,1000000}, 1 << 16);
+
+    //missing file
+    bool thrown = false;
+    try {
+        open_binary_sequence<int>("does_not_exist.tmp");
+    }
+    catch(std::runtime_error&) {
+        thrown = true;
+    }
+    if(!thrown) throw std::logic_error("mapped_sequence: missing file");
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        binary_io();
+        binary_header_checks();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what();
+        return 1;
+    }
+}
@@ -0,0 +1,152 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include "cached.h"
+#include "adaptors.h"
+#include "linear.h"
+#include "fibonacci.h"
+#include "geometric.h"
+
+#include <cstdint>
+#include <vector>
+#include <iostream>
+
+
+
+//-------------------------------------------------------------------
+template<class Sequence, class T>
+void check(const Sequence& s, const std::vector<T>& expected,
+           const char* msg)
+{
+    auto v = std::vector<T>{};
+    for(auto x : s) v.push_back(x);
+    if(v != expected) throw std::logic_error(msg);
+
+    if(s.size() != expected.size()) throw std::logic_error(msg);
+
+    for(std::size_t i = 0; i < expected.size(); ++i) {
+        if(s[i] != expected[i] || *(s + i) != expected[i] ||
+           (s + i).size() != expected.size() - i)
+        {
+            throw std::logic_error(msg);
+        }
+    }
+    if((s + expected.size()) != s.end()) throw std::logic_error(msg);
+    if(!(s + (expected.size() + 5)).empty()) throw std::logic_error(msg);
+}
+
+
+
+//-------------------------------------------------------------------
+void cached_values()
+{
+    using namespace am;
+
+    for(int n : {0, 1, 7, 63, 64, 65, 300, 1000}) {
+        auto expected = std::vector<int>{};
+        for(int i = 0; i < n; ++i) expected.push_back(3 * i - 5);
+
+        check(make_cached_sequence(linear_sequence<int>{-5, 3, 3*n - 6}),
+              expected, "cached: linear");
+
+        check(make_cached_sequence<8>(linear_sequence<int>{-5, 3, 3*n - 6}),
+              expected, "cached: small capacity");
+    }
+
+    auto fib = std::vector<std::uint64_t>{0,1,1,2,3,5,8,13,21,34,55,89};
+    check(make_cached_sequence(fibonacci_sequence<>{fib.size()}),
+          fib, "cached: fibonacci");
+
+    auto geo = make_cached_sequence(
+        make_geometric_sequence(1.0, 2.0, 1e6));
+    for(std::size_t i = 0; i < 20; ++i) {
+        if(geo[i] != double(std::uint64_t(1) << i)) {
+            throw std::logic_error("cached: geometric");
+        }
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+void cached_evaluations()
+{
+    using namespace am;
+
+    int evals = 0;
+    const auto counted = make_transformed_sequence(
+        linear_sequence<int>{0, 1, 1999},
+        [&evals](int x) { ++evals; return x; });
+
+    auto s = make_cached_sequence<64>(counted);
+
+    //first access evaluates one chunk; the rest are hits
+    for(int i = 0; i < 16; ++i) {
+        if(s[std::size_t(i)] != i) throw std::logic_error("cached: []");
+    }
+    if(evals != 16 || s.misses() != 1 || s.hits() != 15) {
+        throw std::logic_error("cached: chunk evaluation");
+    }
+
+    //repeated access of recent values never re-evaluates
+    for(int k = 0; k < 3; ++k) {
+        for(int i = 0; i < 200; ++i, ++s) {
+            if(*s != k * 200 + i) throw std::logic_error("cached: *");
+            for(std::size_t j = 1; j <= 40 && j <= s.lookback_size(); ++j) {
+                if(s.lookback(j) != k * 200 + i - int(j)) {
+                    throw std::logic_error("cached: lookback");
+                }
+            }
+            if(s[10] != k * 200 + i + 10) throw std::logic_error("cached: [10]");
+        }
+        if(s.lookback_size() < 32) throw std::logic_error("cached: history");
+    }
+    //values up to index 609 were needed, evaluated in chunks of 16
+    if(evals != 624) throw std::logic_error("cached: evaluation count");
+
+    //far subscripts fall through, skipping discards the history
+    const auto before = evals;
+    if(s[500] != 1100 || evals != before + 1) {
+        throw std::logic_error("cached: far subscript");
+    }
+    s += 100;
+    if(*s != 700 || s.lookback_size() != 0) {
+        throw std::logic_error("cached: skip");
+    }
+    bool thrown = false;
+    try { s.lookback(1); } catch(std::out_of_range&) { thrown = true; }
+    if(!thrown) throw std::logic_error("cached: lookback range");
+
+    //end() and comparisons are cheap and position based
+    auto t = s + 10;
+    if(t == s || *t != 710 || t.lookback_size() != 10 ||
+       (s + 10) != t || s.end() != t.end() || (t + 5000) != s.end())
+    {
+        throw std::logic_error("cached: compare");
+    }
+    s.reset_counters();
+    if(s.hits() != 0 || s.misses() != 0) throw std::logic_error("cached: reset");
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        cached_values();
+        cached_evaluations();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what();
+        return 1;
+    }
+}
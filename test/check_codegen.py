@@ -0,0 +1,166 @@
+#!/usr/bin/python
+
+###############################################################################
+#
+# zero-overhead check: compiles the reference kernels in codegen_test.cpp
+# to assembly and compares each '<name>_seq' kernel (sequence generators)
+# with its hand-written counterpart '<name>_raw'
+#
+# a kernel pair fails if
+#   - the raw loop was vectorized but the generator loop was not
+#   - the innermost loop of the generator kernel has more than
+#     <slack> instructions more than the raw one
+#   - the generator kernel has more than <ratio> times as many
+#     instructions as the raw one (setup code, e.g. for end())
+#
+# usage:
+#    ./check_codegen.py [-c <compiler>] [-o <compiler-options>]
+#                       [-s <slack>] [-r <ratio>]
+#
+# requires a gcc or clang compatible compiler targeting x86-64
+#
+# (c) 2013-2017 Andre Mueller
+#
+###############################################################################
+
+from __future__ import print_function
+
+import re
+import os
+import subprocess
+import tempfile
+from os import path
+from sys import argv, exit
+
+compiler   = "g++"
+compileopt = "-std=c++14 -O3"
+slack      = 2
+ratio      = 4.0
+source     = path.join(path.dirname(path.abspath(__file__)), "codegen_test.cpp")
+incpath    = path.join(path.dirname(path.abspath(__file__)), "..", "include")
+
+i = 1
+while i < len(argv):
+    if argv[i] == "-c" and i+1 < len(argv):
+        compiler = argv[i+1]; i += 1
+    elif argv[i] == "-o" and i+1 < len(argv):
+        compileopt = argv[i+1]; i += 1
+    elif argv[i] == "-s" and i+1 < len(argv):
+        slack = int(argv[i+1]); i += 1
+    elif argv[i] == "-r" and i+1 < len(argv):
+        ratio = float(argv[i+1]); i += 1
+    else:
+        print("usage: " + argv[0] + " [-c <compiler>] [-o <compiler-options>]"
+              " [-s <slack>] [-r <ratio>]")
+        exit(2)
+    i += 1
+
+# pairs with known overhead; reported, but don't fail the check
+known = {
+    "linear_double": "end() comparison of floating-point values "
+                     "uses approximate equality"
+}
+
+
+funcrxp   = re.compile(r'^_?([a-z]\w*_(?:seq|raw)):\s*$')
+labelrxp  = re.compile(r'^(\.?L\w+):')
+jumprxp   = re.compile(r'^j\w*\s+(\.?L\w+)')
+vectorrxp = re.compile(r'^v?(p(add|sub|mul)[bwdq]|(add|sub|mul)p[sd])\s.*%[xyz]mm')
+
+
+def functions(asm):
+    """ returns {name: [instruction or ('label', name)]} """
+    funcs = {}
+    cur = None
+    for line in asm.split('\n'):
+        m = funcrxp.match(line)
+        if m:
+            cur = m.group(1)
+            funcs[cur] = []
+            continue
+        if cur is None:
+            continue
+        if line.strip() == ".cfi_endproc":
+            cur = None
+            continue
+        m = labelrxp.match(line)
+        if m:
+            funcs[cur].append(('label', m.group(1)))
+        elif line.startswith('\t') and not line.startswith('\t.'):
+            funcs[cur].append(('ins', line.strip()))
+    return funcs
+
+
+def analyze(items):
+    """ returns (instruction count, innermost loop size, vectorized) """
+    labels = {}
+    loops = []
+    count = 0
+    vectorized = False
+    for kind, val in items:
+        if kind == 'label':
+            labels[val] = count
+            continue
+        m = jumprxp.match(val)
+        if m and m.group(1) in labels:
+            loops.append(count - labels[m.group(1)] + 1)
+        if vectorrxp.match(val):
+            vectorized = True
+        count += 1
+    return (count, min(loops) if loops else 0, vectorized)
+
+
+# compile
+fd, asmfile = tempfile.mkstemp(suffix=".s")
+os.close(fd)
+cmd = [compiler] + compileopt.split() + ["-S", "-I", incpath, source, "-o", asmfile]
+if subprocess.call(cmd) != 0:
+    print("ERROR: compilation failed: " + " ".join(cmd))
+    exit(1)
+with open(asmfile, 'r') as f:
+    funcs = functions(f.read())
+os.remove(asmfile)
+
+# compare
+names = sorted(set(n[:-4] for n in funcs.keys()))
+if len(names) < 1:
+    print("ERROR: no kernels found in assembly")
+    exit(1)
+
+failed = 0
+print("%-20s %14s %14s %10s" % ("kernel", "instructions", "inner loop", "vectorized"))
+for name in names:
+    if name + "_seq" not in funcs or name + "_raw" not in funcs:
+        print("ERROR: incomplete kernel pair " + name)
+        failed += 1
+        continue
+    seq = analyze(funcs[name + "_seq"])
+    raw = analyze(funcs[name + "_raw"])
+
+    problems = []
+    if raw[2] and not seq[2]:
+        problems.append("not vectorized")
+    if seq[1] > raw[1] + slack:
+        problems.append("inner loop overhead")
+    if seq[0] > ratio * raw[0]:
+        problems.append("code size")
+
+    status = ""
+    if problems:
+        if name in known:
+            status = "known: " + known[name]
+        else:
+            status = "FAILED: " + ", ".join(problems)
+            failed += 1
+    elif name in known:
+        status = "no overhead anymore; remove from known list"
+
+    print("%-20s %6d / %-6d %6d / %-6d %4s / %-4s %s" %
+          (name, seq[0], raw[0], seq[1], raw[1],
+           "yes" if seq[2] else "no", "yes" if raw[2] else "no", status))
+
+print("-----------------------------------------------------------------")
+if failed > 0:
+    print(str(failed) + " kernel(s) with overhead over hand-written loops")
+    exit(1)
+print("No kernel with (new) overhead over hand-written loops.")
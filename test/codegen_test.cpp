@@ -0,0 +1,179 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+/*
+ * reference kernels for codegen verification:
+ * each kernel 'x_seq' uses sequence generators, 'x_raw' is the equivalent
+ * hand-written loop
+ *
+ * - as a regular test this checks that both produce the same values
+ * - check_codegen.py compiles this file to assembly and checks that
+ *   the '_seq' kernels are not worse than their '_raw' counterparts
+ *   (vectorization, size of the innermost loop)
+ */
+
+#include "linear.h"
+#include "combined.h"
+#include "segmented.h"
+
+#include <vector>
+#include <iostream>
+
+
+#if defined(__GNUC__) || defined(__clang__)
+#  define AM_KERNEL extern "C" __attribute__((noinline))
+#else
+#  define AM_KERNEL extern "C"
+#endif
+
+
+//-------------------------------------------------------------------
+AM_KERNEL void
+ascending_seq(int* out, int n) {
+    for(auto x : am::ascending_sequence<int>{0, n-1}) *out++ = x;
+}
+AM_KERNEL void
+ascending_raw(int* out, int n) {
+    for(int i = 0; i < n; ++i) *out++ = i;
+}
+
+//-------------------------------------------------------------------
+AM_KERNEL void
+ascending_increment_seq(int* out, int n) {
+    for(auto s = am::ascending_sequence<int>{0, n-1}; !s.empty(); ++s) {
+        *out++ = *s;
+    }
+}
+AM_KERNEL void
+ascending_increment_raw(int* out, int n) {
+    for(int i = 0; i < n; ++i) *out++ = i;
+}
+
+//-------------------------------------------------------------------
+AM_KERNEL void
+descending_seq(int* out, int n) {
+    for(auto x : am::descending_sequence<int>{n-1, 0}) *out++ = x;
+}
+AM_KERNEL void
+descending_raw(int* out, int n) {
+    for(int i = n-1; i >= 0; --i) *out++ = i;
+}
+
+//-------------------------------------------------------------------
+AM_KERNEL void
+linear_seq(int* out, int n) {
+    for(auto x : am::linear_sequence<int>{3, 2, 3 + 2*(n-1)}) *out++ = x;
+}
+AM_KERNEL void
+linear_raw(int* out, int n) {
+    for(int i = 0; i < n; ++i) *out++ = 3 + 2*i;
+}
+
+//-------------------------------------------------------------------
+AM_KERNEL void
+linear_fill_seq(int* out, int n) {
+    am::fill(am::linear_sequence<int>{3, 2, 3 + 2*(n-1)}, out, out + n);
+}
+AM_KERNEL void
+linear_fill_raw(int* out, int n) {
+    for(int i = 0; i < n; ++i) *out++ = 3 + 2*i;
+}
+
+//-------------------------------------------------------------------
+// end() comparison goes through num_equality.h
+AM_KERNEL void
+linear_double_seq(double* out, int n) {
+    for(auto x : am::linear_sequence<double>{0.5, 0.25, 0.5 + 0.25*(n-1)}) {
+        *out++ = x;
+    }
+}
+AM_KERNEL void
+linear_double_raw(double* out, int n) {
+    double x = 0.5;
+    for(int i = 0; i < n; ++i, x += 0.25) *out++ = x;
+}
+
+//-------------------------------------------------------------------
+AM_KERNEL void
+combined_fill_seq(int* out, int n) {
+    am::fill(am::make_combined_sequence(
+                 am::ascending_sequence<int>{0, n-1},
+                 am::ascending_sequence<int>{0, n-1}),
+             out, out + 2*n);
+}
+AM_KERNEL void
+combined_fill_raw(int* out, int n) {
+    for(int i = 0; i < n; ++i) *out++ = i;
+    for(int i = 0; i < n; ++i) *out++ = i;
+}
+
+//-------------------------------------------------------------------
+AM_KERNEL long long
+ascending_sum_seq(int n) {
+    long long s = 0;
+    for(auto x : am::ascending_sequence<int>{0, n-1}) s += x;
+    return s;
+}
+AM_KERNEL long long
+ascending_sum_raw(int n) {
+    long long s = 0;
+    for(int i = 0; i < n; ++i) s += i;
+    return s;
+}
+
+
+
+
+//-------------------------------------------------------------------
+template<class T, class K1, class K2>
+void check_kernels(K1 k1, K2 k2, int n, int outSize, const char* msg)
+{
+    auto a = std::vector<T>(outSize, T(-1));
+    auto b = std::vector<T>(outSize, T(-1));
+    k1(a.data(), n);
+    k2(b.data(), n);
+    if(a != b) throw std::logic_error(msg);
+}
+
+
+//-------------------------------------------------------------------
+void codegen_kernels()
+{
+    for(int n : {0, 1, 7, 1000}) {
+        check_kernels<int>(ascending_seq, ascending_raw, n, n+1, "ascending");
+        check_kernels<int>(ascending_increment_seq, ascending_increment_raw,
+                           n, n+1, "ascending_increment");
+        check_kernels<int>(descending_seq, descending_raw, n, n+1, "descending");
+        check_kernels<int>(linear_seq, linear_raw, n, n+1, "linear");
+        check_kernels<int>(linear_fill_seq, linear_fill_raw, n, n+1, "linear_fill");
+        check_kernels<double>(linear_double_seq, linear_double_raw,
+                              n, n+1, "linear_double");
+        check_kernels<int>(combined_fill_seq, combined_fill_raw,
+                           n, 2*n+1, "combined_fill");
+
+        if(ascending_sum_seq(n) != ascending_sum_raw(n)) {
+            throw std::logic_error("ascending_sum");
+        }
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        codegen_kernels();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what();
+        return 1;
+    }
+}
@@ -0,0 +1,146 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include "combination.h"
+#include "random.h"
+#include "parallel.h"
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include <iostream>
+
+
+
+//-------------------------------------------------------------------
+int popcount(std::uint64_t x)
+{
+    int n = 0;
+    for(; x; x &= x - 1) ++n;
+    return n;
+}
+
+
+//-------------------------------------------------------------------
+void combination_enumeration()
+{
+    using namespace am;
+
+    for(unsigned n = 0; n <= 12; ++n) {
+        for(unsigned k = 0; k <= n; ++k) {
+            //brute force: all n-bit masks with k set bits in increasing order
+            auto expected = std::vector<std::uint64_t>{};
+            for(std::uint64_t m = 0; m < (std::uint64_t(1) << n); ++m) {
+                if(popcount(m) == int(k)) expected.push_back(m);
+            }
+
+            const auto s = make_combination_sequence(n, k);
+            if(s.size() != expected.size()) {
+                throw std::logic_error("combination: size");
+            }
+            auto v = std::vector<std::uint64_t>{};
+            for(auto m : s) v.push_back(m);
+            if(v != expected) throw std::logic_error("combination: iteration");
+
+            for(std::size_t i = 0; i < v.size(); ++i) {
+                if(s[i] != v[i] || *(s + i) != v[i] ||
+                   combination_sequence::index_of(v[i]) != i)
+                {
+                    throw std::logic_error("combination: random access");
+                }
+            }
+            if(!(s + v.size()).empty() || s + (v.size() + 5) != s.end()) {
+                throw std::logic_error("combination: end");
+            }
+        }
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+void combination_limits()
+{
+    using namespace am;
+
+    //exact sizes
+    if(combination_sequence{64, 32}.size() != 1832624140942590534ull ||
+       combination_sequence{64, 0}.size() != 1 ||
+       combination_sequence{64, 64}.size() != 1 ||
+       combination_sequence{64, 1}.size() != 64 ||
+       combination_sequence{50, 25}.size() != 126410606437752ull)
+    {
+        throw std::logic_error("combination: binomial");
+    }
+
+    if(*combination_sequence{64, 64} != ~std::uint64_t(0)) {
+        throw std::logic_error("combination: full set");
+    }
+
+    //the highest subsets of 64 items
+    const auto s = combination_sequence{64, 63};
+    auto t = s + 60;
+    for(std::uint64_t i = 60; i < 64; ++i, ++t) {
+        if(*t != s[i] || *t != ~(std::uint64_t(1) << (63 - i))) {
+            throw std::logic_error("combination: 64 items");
+        }
+    }
+    if(!t.empty()) throw std::logic_error("combination: 64 items end");
+
+    //random unranking in a huge space
+    const auto h = combination_sequence{64, 32};
+    for(auto r : make_random_sequence(1, 1000)) {
+        const auto i = r % h.size();
+        const auto m = h[i];
+        auto x = h + i;
+        if(popcount(m) != 32 || combination_sequence::index_of(m) != i ||
+           *x != m)
+        {
+            throw std::logic_error("combination: unranking");
+        }
+        if(i + 1 < h.size() && *(++x) != h[i+1]) {
+            throw std::logic_error("combination: Gosper step");
+        }
+    }
+
+    bool thrown = false;
+    try { combination_sequence{65, 2}; }
+    catch(std::invalid_argument&) { thrown = true; }
+    if(!thrown) throw std::logic_error("combination: n > 64");
+
+    thrown = false;
+    try { combination_sequence{5, 6}; }
+    catch(std::invalid_argument&) { thrown = true; }
+    if(!thrown) throw std::logic_error("combination: k > n");
+
+    //splitting across threads
+    const auto p = combination_sequence{24, 6};
+    auto a = std::vector<std::uint64_t>(p.size());
+    auto b = std::vector<std::uint64_t>{};
+    am::parallel_fill(p, a.data(), a.size(), 4);
+    for(auto m : p) b.push_back(m);
+    if(a != b) throw std::logic_error("combination: parallel_fill");
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        combination_enumeration();
+        combination_limits();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what();
+        return 1;
+    }
+}
@@ -62,11 +62,89 @@ void combined_sequence_generation()
 
 
 
+//-------------------------------------------------------------------
+template<class Seq>
+void check_against(const Seq& g, const std::vector<double>& expected)
+{
+    using seq_detail::approx_equal;
+
+    auto v = std::vector<double>{};
+    for(auto x : g) v.push_back(x);
+
+    if(v.size() != expected.size() || g.size() != expected.size()) {
+        throw std::logic_error("combined_sequence: size");
+    }
+    for(std::size_t i = 0; i < expected.size(); ++i) {
+        if(!approx_equal(v[i], expected[i]) ||
+           !approx_equal(double(g[i]), expected[i]) ||
+           !approx_equal(double(*(g + i)), expected[i]))
+        {
+            throw std::logic_error("combined_sequence: values");
+        }
+        auto s = g + i;
+        for(std::size_t j = 0; (i+j) < expected.size(); ++j) {
+            if(!approx_equal(double(s[j]), expected[i+j])) {
+                throw std::logic_error("combined_sequence: random access");
+            }
+        }
+    }
+    if((g + expected.size()) != g.end()) {
+        throw std::logic_error("combined_sequence: end");
+    }
+}
+
+
+//-------------------------------------------------------------------
+void variadic_combined_sequence_generation()
+{
+    {
+        auto g = make_combined_sequence(
+            make_linear_sequence(8, -1, 1),
+            make_linear_sequence(1.0, 1.0, 3.0),
+            make_linear_sequence(5, 1, 4),          //empty
+            make_linear_sequence(10, 10, 50));
+
+        static_assert(decltype(g)::segments() == 4, "");
+
+        check_against(g, {8,7,6,5,4,3,2,1, 1,2,3, 10,20,30,40,50});
+    }
+
+    {
+        auto segs = std::vector<linear_sequence<int>>{};
+        auto expected = std::vector<double>{};
+        for(int i = 0; i < 20; ++i) {
+            segs.push_back(make_linear_sequence(100*i, 1, 100*i + (i % 4)));
+            for(int j = 0; j <= (i % 4); ++j) expected.push_back(100*i + j);
+        }
+        segs.insert(segs.begin() + 5, make_linear_sequence(1, 1, 0));
+
+        auto g = make_combined_sequence(segs);
+        if(g.segments() != 21) {
+            throw std::logic_error("dynamic_combined_sequence");
+        }
+        check_against(g, expected);
+    }
+
+    {
+        auto g = make_combined_sequence(std::vector<linear_sequence<int>>{});
+        int buf[4];
+        if(g.segments() != 0 || !g.empty() || (g + 3) != g.end() ||
+           am::next_batch(g, buf, 4) != 0)
+        {
+            throw std::logic_error("dynamic_combined_sequence: empty");
+        }
+        check_against(g, {});
+    }
+}
+
+
+
 //-------------------------------------------------------------------
 int main()
 {
     try {
         combined_sequence_generation();
+        variadic_combined_sequence_generation();
     }
     catch(std::exception& e) {
         std::cerr << e.what();
@@ -0,0 +1,173 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include "compressed.h"
+#include "linear.h"
+#include "combined.h"
+#include "repeated.h"
+#include "segmented.h"
+#include "random.h"
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <iostream>
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void check_roundtrip(const std::vector<T>& data, std::size_t maxRuns,
+                     const char* msg)
+{
+    auto c = am::compress(data.data(), data.size());
+
+    if(c.runs().size() > maxRuns || c.size() != data.size()) {
+        throw std::logic_error(msg);
+    }
+
+    //never much larger than the input
+    const auto overhead = 2 * (sizeof(am::linear_run<T>) + sizeof(std::size_t));
+    if(c.table_bytes() > data.size() * sizeof(T) + overhead) {
+        throw std::logic_error(msg);
+    }
+
+    //iteration
+    auto v = std::vector<T>{};
+    for(auto x : c) v.push_back(x);
+    if(v != data) throw std::logic_error(msg);
+
+    //random access
+    for(std::size_t i = 0; i < data.size(); ++i) {
+        if(c[i] != data[i] || *(c + i) != data[i]) {
+            throw std::logic_error(msg);
+        }
+    }
+
+    //bulk decoding from every start position
+    for(std::size_t i = 0; i <= data.size(); i += 1 + data.size() / 50) {
+        auto w = std::vector<T>(data.size() - i + 1, T(-1));
+        auto last = (c + i).copy_to(w.data());
+        if(last != (w.data() + data.size() - i) ||
+           !std::equal(data.begin() + i, data.end(), w.begin()) ||
+           w.back() != T(-1))
+        {
+            throw std::logic_error(msg);
+        }
+
+        auto u = std::vector<T>{};
+        (c + i).copy_to(std::back_inserter(u));
+        if(!std::equal(data.begin() + i, data.end(), u.begin(), u.end())) {
+            throw std::logic_error(msg);
+        }
+    }
+}
+
+
+//-------------------------------------------------------------------
+template<class Sequence>
+auto materialize(const Sequence& s)
+{
+    auto v = std::vector<std::decay_t<decltype(*s)>>{};
+    am::copy(s, std::back_inserter(v));
+    return v;
+}
+
+
+//-------------------------------------------------------------------
+void sequence_compression()
+{
+    using namespace am;
+    using lin_t = linear_sequence<int>;
+
+    check_roundtrip(std::vector<int>{}, 0, "empty");
+    check_roundtrip(std::vector<int>{7}, 1, "single");
+    check_roundtrip(std::vector<int>{7,3}, 1, "pair");
+
+    check_roundtrip(materialize(lin_t{0,3,300000}), 1, "linear");
+
+    check_roundtrip(materialize(make_combined_sequence(
+                        lin_t{0,1,999}, lin_t{5000,-7,-2000},
+                        lin_t{42,1,42}, lin_t{-10,10,1000})),
+                    4, "piecewise linear");
+
+    check_roundtrip(materialize(make_repeated_sequence(lin_t{0,1,99}, 999)),
+                    1, "repeated block");
+
+    check_roundtrip(materialize(make_combined_sequence(
+                        make_repeated_sequence(lin_t{0,2,8}, 9),
+                        lin_t{100,1,200},
+                        make_repeated_sequence(lin_t{0,2,8}, 9))),
+                    3, "repeated blocks");
+
+    check_roundtrip(std::vector<int>{1,1,1,1,1}, 1, "constant");
+    check_roundtrip(std::vector<int>{0,1,0,1,0,1,0}, 4, "alternating");
+
+    //wrap-around of signed values
+    const auto imin = std::numeric_limits<std::int64_t>::min();
+    const auto imax = std::numeric_limits<std::int64_t>::max();
+    check_roundtrip(std::vector<std::int64_t>{imin, 0, imax, imin, imax, -1},
+                    4, "extreme values");
+
+    check_roundtrip(std::vector<std::uint8_t>{250,252,254,0,2,4,3},
+                    2, "unsigned wrap-around");
+
+    //incompressible data is stored as literals
+    auto noise = std::vector<std::int64_t>{};
+    am::copy(random_sequence<std::int64_t>{7, 10000}, std::back_inserter(noise));
+    check_roundtrip(noise, 1, "random");
+    auto bytes = std::vector<std::uint8_t>{};
+    am::copy(random_sequence<std::uint8_t>{3, 10000}, std::back_inserter(bytes));
+    check_roundtrip(bytes, 1, "random bytes");
+
+    //literal stretches between progressions
+    auto mixed = std::vector<int>{};
+    for(int k = 0; k < 50; ++k) {
+        for(int i = 0; i < 100; ++i) mixed.push_back(1000 * k + 3 * i);
+        for(int i = 0; i < k % 7; ++i) mixed.push_back(int(noise[k*7 + i] % 1000));
+    }
+    check_roundtrip(mixed, 100, "mixed");
+    {
+        const auto c = compress(mixed.data(), mixed.size());
+        std::size_t lits = 0;
+        for(const auto& r : c.runs()) {
+            if(r.is_literal()) lits += r.length;
+            else if(r.length < 100) throw std::logic_error("mixed: runs");
+        }
+        if(lits != c.literals().size() || lits > 50 * 6) {
+            throw std::logic_error("mixed: literals");
+        }
+    }
+
+    //short repeated patterns still pay off as runs
+    auto pattern = std::vector<int>{};
+    for(int k = 0; k < 100; ++k) {
+        pattern.insert(pattern.end(), {0, 2, 4, 6});
+    }
+    check_roundtrip(pattern, 1, "repeated pattern");
+    if(compress(pattern.data(), pattern.size()).runs().front().is_literal()) {
+        throw std::logic_error("repeated pattern: literal");
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        sequence_compression();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what();
+        return 1;
+    }
+}
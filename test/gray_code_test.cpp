@@ -0,0 +1,123 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include "gray_code.h"
+#include "random.h"
+
+#include <cstdint>
+#include <vector>
+#include <iostream>
+
+
+
+//-------------------------------------------------------------------
+template<class UInt>
+void check_gray_codes(const am::gray_code_sequence<UInt>& s, const char* msg)
+{
+    const auto n = s.size();
+    auto seen = std::vector<bool>(n, false);
+    UInt prev = 0;
+    std::uint64_t i = 0;
+    for(auto t = s; !t.empty(); ++t, ++i) {
+        const auto g = *t;
+        if(g >= n || seen[g] || t.index() != i ||
+           g != s[i] || *(s + i) != g ||
+           am::gray_code_sequence<UInt>::index_of(g) != i)
+        {
+            throw std::logic_error(msg);
+        }
+        seen[g] = true;
+
+        //exactly one bit flipped: the reported one
+        if(i == 0) {
+            if(t.changed_bit() != -1 || g != 0) throw std::logic_error(msg);
+        }
+        else {
+            if(UInt(prev ^ g) != UInt(UInt(1) << t.changed_bit()) ||
+               (s + i).changed_bit() != t.changed_bit())
+            {
+                throw std::logic_error(msg);
+            }
+        }
+        prev = g;
+    }
+    if(i != n) throw std::logic_error(msg);
+}
+
+
+//-------------------------------------------------------------------
+void gray_code_sequences()
+{
+    using namespace am;
+
+    check_gray_codes(gray_code_sequence<std::uint8_t>{}, "gray code: 8 bit");
+    check_gray_codes(gray_code_sequence<std::uint16_t>{}, "gray code: 16 bit");
+    check_gray_codes(make_gray_code_sequence(10), "gray code: 10 bit");
+    check_gray_codes(make_gray_code_sequence<unsigned>(0), "gray code: 0 bit");
+
+    if(gray_code_sequence<std::uint8_t>{}.size() != 256 ||
+       gray_code_sequence<std::uint32_t>{}.size() != (std::uint64_t(1) << 32))
+    {
+        throw std::logic_error("gray code: size");
+    }
+
+    //bit widths beyond UInt are clamped
+    check_gray_codes(make_gray_code_sequence<std::uint8_t>(12),
+                     "gray code: clamped");
+    if(make_gray_code_sequence<std::uint8_t>(12).size() != 256 ||
+       make_gray_code_sequence<std::uint16_t>(100).size() != 65536 ||
+       make_gray_code_sequence<>(100).size() != gray_code_sequence<>{}.size())
+    {
+        throw std::logic_error("gray code: clamped size");
+    }
+
+    //incremental evaluation: weighted sum of the selected items
+    const int w[] = {3, -5, 7, 11, -13, 17};
+    int sum = 0;
+    for(auto s = make_gray_code_sequence(6); !s.empty(); ++s) {
+        if(s.changed_bit() >= 0) {
+            const auto b = s.changed_bit();
+            sum += ((*s >> b) & 1) ? w[b] : -w[b];
+        }
+        int ref = 0;
+        for(int b = 0; b < 6; ++b) if((*s >> b) & 1) ref += w[b];
+        if(sum != ref) throw std::logic_error("gray code: incremental sum");
+    }
+
+    //64 bit codes: inverse and consecutive codes
+    const auto s = gray_code_sequence<>{};
+    for(auto r : make_random_sequence(5, 1000)) {
+        const auto i = r % (s.size() - 1);
+        auto t = s + i;
+        const auto g = *t;
+        ++t;
+        if(gray_code_sequence<>::index_of(g) != i ||
+           (g ^ *t) != (std::uint64_t(1) << t.changed_bit()) ||
+           *t != s[i+1])
+        {
+            throw std::logic_error("gray code: 64 bit");
+        }
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        gray_code_sequences();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what();
+        return 1;
+    }
+}
@@ -0,0 +1,149 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include "linspace.h"
+#include "segmented.h"
+#include "parallel.h"
+
+#include <cmath>
+#include <vector>
+#include <iostream>
+
+
+
+//-------------------------------------------------------------------
+bool close(double x, double y, double tol = 1e-13)
+{
+    return std::abs(x - y) <= tol * std::max(1.0, std::max(std::abs(x), std::abs(y)));
+}
+
+
+//-------------------------------------------------------------------
+template<class Sequence, class Ref>
+void check_spaced(const Sequence& s, std::size_t n, Ref ref, const char* msg)
+{
+    using T = typename Sequence::value_type;
+
+    if(s.size() != n || s.empty() != (n == 0)) throw std::logic_error(msg);
+
+    auto v = std::vector<T>{};
+    for(auto x : s) v.push_back(x);
+    if(v.size() != n) throw std::logic_error(msg);
+
+    //exact end points
+    if(n > 0 && (v.front() != s.front() || (n > 1 && v.back() != s.back()))) {
+        throw std::logic_error(msg);
+    }
+
+    for(std::size_t i = 0; i < n; ++i) {
+        if(!close(v[i], ref(i)) || s[i] != v[i] || *(s + i) != v[i] ||
+           (s + i).size() != n - i)
+        {
+            throw std::logic_error(msg);
+        }
+    }
+    if(!(s + n).empty() || s + (n + 3) != s.end()) throw std::logic_error(msg);
+
+    //bulk fill from every start position
+    for(std::size_t i = 0; i <= n; i += 1 + n / 7) {
+        auto w = std::vector<T>(n - i + 1, T(-1));
+        auto last = (s + i).generate(w.data(), n + 5);
+        if(last != w.data() + (n - i) || w.back() != T(-1)) {
+            throw std::logic_error(msg);
+        }
+        for(std::size_t k = i; k < n; ++k) {
+            if(!close(w[k-i], v[k])) throw std::logic_error(msg);
+        }
+        if(i < n && (w.front() != v[i] || w[n-i-1] != v.back())) {
+            throw std::logic_error(msg);
+        }
+    }
+
+    auto u = std::vector<T>(n);
+    am::parallel_fill(s, u.data(), n, 3);
+    if(u != v) throw std::logic_error(msg);
+}
+
+
+
+//-------------------------------------------------------------------
+void linspace_sequences()
+{
+    using namespace am;
+
+    for(std::size_t n : {0, 1, 2, 3, 10, 11, 1001}) {
+        const double a = -1.5, b = 2.25;
+        check_spaced(linspace(a, b, n), n, [&](std::size_t i) {
+            return n > 1 ? a + (b - a) * double(i) / double(n - 1) : a;
+        }, "linspace");
+
+        //the bulk fill is exact for linspace
+        auto w = std::vector<double>(n);
+        linspace(a, b, n).copy_to(w.data());
+        for(std::size_t i = 0; i < n; ++i) {
+            if(w[i] != linspace(a, b, n)[i]) throw std::logic_error("linspace: bulk");
+        }
+    }
+
+    //counts that are off by one with stride + bound
+    for(int n = 2; n < 200; ++n) {
+        const auto s = linspace(0.0, 0.1 * (n - 1), std::size_t(n));
+        if(s.size() != std::size_t(n) || s[std::size_t(n-1)] != 0.1 * (n - 1)) {
+            throw std::logic_error("linspace: count");
+        }
+    }
+
+    //decreasing
+    check_spaced(linspace(1.0f, -1.0f, 5), 5, [](std::size_t i) {
+        return 1.0 - 0.5 * double(i);
+    }, "linspace: decreasing");
+}
+
+
+
+//-------------------------------------------------------------------
+void logspace_sequences()
+{
+    using namespace am;
+
+    for(std::size_t n : {0, 1, 2, 3, 10, 63, 64, 65, 1001}) {
+        const double a = 0.001, b = 1000.0;
+        check_spaced(logspace(a, b, n), n, [&](std::size_t i) {
+            return n > 1 ? a * std::pow(b / a, double(i) / double(n - 1)) : a;
+        }, "logspace");
+    }
+
+    //negative values
+    check_spaced(logspace(-1.0, -1024.0, 11), 11, [](std::size_t i) {
+        return -std::pow(2.0, double(i));
+    }, "logspace: negative");
+
+    //decreasing
+    const auto d = logspace(1e6, 1.0, 7);
+    if(d[0] != 1e6 || d[6] != 1.0 || !close(d[3], 1e3) || !close(d.ratio(), 0.1)) {
+        throw std::logic_error("logspace: decreasing");
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        linspace_sequences();
+        logspace_sequences();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what();
+        return 1;
+    }
+}
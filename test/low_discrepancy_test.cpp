@@ -0,0 +1,187 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include "low_discrepancy.h"
+#include "parallel.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <iostream>
+
+
+
+//-------------------------------------------------------------------
+/// textbook radical inverse
+double radical_inverse(std::uint64_t n, std::uint64_t base)
+{
+    double r = 0, f = 1.0 / base;
+    for(; n > 0; n /= base, f /= base) r += f * double(n % base);
+    return r;
+}
+
+
+//-------------------------------------------------------------------
+template<class Sequence>
+void check_access(const Sequence& s, const char* msg)
+{
+    auto v = std::vector<typename Sequence::value_type>{};
+    for(const auto& x : s) v.push_back(x);
+    if(v.size() != s.size()) throw std::logic_error(msg);
+
+    //++, [] and += must produce exactly the same points
+    for(std::size_t i = 0; i < v.size(); i += 1 + v.size() / 97) {
+        if(s[i] != v[i] || *(s + i) != v[i] || (s + i).index() != i) {
+            throw std::logic_error(msg);
+        }
+        auto t = s + i;
+        for(std::size_t k = i; k < std::min(v.size(), i + 300); ++k, ++t) {
+            if(*t != v[k]) throw std::logic_error(msg);
+        }
+    }
+
+    //splitting across threads
+    auto w = std::vector<typename Sequence::value_type>(v.size());
+    am::parallel_fill(s, w.data(), w.size(), 4);
+    if(w != v) throw std::logic_error(msg);
+}
+
+
+
+//-------------------------------------------------------------------
+void halton()
+{
+    using namespace am;
+
+    const auto s = halton_sequence<double,4>{20000};
+    check_access(s, "halton: access");
+
+    const std::uint64_t bases[] = {2, 3, 5, 7};
+    std::uint64_t i = 0;
+    for(const auto& p : s) {
+        for(int j = 0; j < 4; ++j) {
+            if(s.base(j) != bases[j] ||
+               std::abs(p[j] - radical_inverse(i, bases[j])) > 1e-14)
+            {
+                throw std::logic_error("halton: radical inverse");
+            }
+        }
+        ++i;
+    }
+
+    //first points in base 2 and 3
+    const auto h = make_halton_sequence<double,2>(5);
+    const double expected[5][2] = {
+        {0,0}, {0.5,1/3.0}, {0.25,2/3.0}, {0.75,1/9.0}, {0.125,4/9.0}
+    };
+    for(int k = 0; k < 5; ++k) {
+        if(std::abs(h[k][0] - expected[k][0]) > 1e-15 ||
+           std::abs(h[k][1] - expected[k][1]) > 1e-15)
+        {
+            throw std::logic_error("halton: first points");
+        }
+    }
+
+    //reversed digits: base 3, index 1 -> digit 2 -> 2/3
+    const auto r = make_halton_sequence<double,2>(100, halton_digits::reversed);
+    check_access(r, "halton (reversed): access");
+    if(r[1][0] != 0.5 || std::abs(r[1][1] - 2/3.0) > 1e-15 ||
+       std::abs(r[3][1] - 2/9.0) > 1e-15)
+    {
+        throw std::logic_error("halton (reversed): values");
+    }
+
+    //large indices (carry through all digits)
+    auto big = halton_sequence<double,32>{} + ((std::uint64_t(1) << 40) - 1);
+    const auto next = big[1];
+    ++big;
+    if(*big != next || (*big)[0] != radical_inverse(std::uint64_t(1) << 40, 2)) {
+        throw std::logic_error("halton: large index");
+    }
+    for(auto x : *big) {
+        if(x < 0.0 || x >= 1.0) throw std::logic_error("halton: range");
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+void kronecker()
+{
+    using namespace am;
+
+    const auto s = kronecker_sequence<double,3>{20000};
+    check_access(s, "kronecker: access");
+
+    //generalized golden ratio for d=3: phi^4 = phi + 1
+    const double phi = 1.2207440846057596;
+    const double alpha[] = {1/phi, 1/(phi*phi), 1/(phi*phi*phi)};
+    std::uint64_t i = 0;
+    for(const auto& p : s) {
+        for(int j = 0; j < 3; ++j) {
+            double e = 0.5 + double(i) * alpha[j];
+            e -= std::floor(e);
+            auto d = std::abs(p[j] - e);
+            if(d > 0.5) d = 1 - d;
+            if(p[j] < 0.0 || p[j] >= 1.0 || d > 1e-9) {
+                throw std::logic_error("kronecker: values");
+            }
+        }
+        ++i;
+    }
+
+    //golden ratio Weyl sequence
+    const auto g = make_kronecker_sequence<double,1>(1000, 0.0);
+    if(g[0][0] != 0.0 || std::abs(g[1][0] - 0.6180339887498949) > 1e-12) {
+        throw std::logic_error("kronecker: golden ratio");
+    }
+
+    //batch generation
+    auto w = std::vector<double>(3 * 1001, -1.0);
+    auto last = (s + 50).generate(w.data(), 1000);
+    if(last != w.data() + 3000 || w[3000] != -1.0) {
+        throw std::logic_error("kronecker: generate");
+    }
+    for(std::size_t k = 0; k < 1000; ++k) {
+        const auto p = s[50 + k];
+        if(w[3*k] != p[0] || w[3*k+1] != p[1] || w[3*k+2] != p[2]) {
+            throw std::logic_error("kronecker: generate values");
+        }
+    }
+    if((s + 19990).generate(w.data(), 1000) != w.data() + 30) {
+        throw std::logic_error("kronecker: generate (clamped)");
+    }
+
+    const auto f = kronecker_sequence<float,2>{5000};
+    check_access(f, "kronecker<float>: access");
+
+    //tiny negative offsets wrap to 0 instead of 1
+    const auto z = kronecker_sequence<float,2>{10, -1e-9f};
+    const auto z0 = kronecker_sequence<float,2>{10, 0.0f};
+    if(*z != *z0 || z[7] != z0[7]) {
+        throw std::logic_error("kronecker: offset rounding to 1");
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        halton();
+        kronecker();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what();
+        return 1;
+    }
+}
@@ -0,0 +1,122 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include "num_equality.h"
+#include "linear.h"
+#include "geometric.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <iostream>
+
+
+
+//-------------------------------------------------------------------
+template<class Sequence>
+std::size_t count_values(const Sequence& g)
+{
+    std::size_t n = 0;
+    for(auto x : g) { (void)x; ++n; }
+    return n;
+}
+
+
+//-------------------------------------------------------------------
+void equality_policies()
+{
+    using namespace am;
+
+    //exact
+    static_assert(exact_equality::equal(3, 3), "");
+    static_assert(!exact_equality::equal(3, 4), "");
+    static_assert(std::is_same<default_equality<int>,exact_equality>::value, "");
+    static_assert(std::is_same<default_equality<double>,absolute_equality<>>::value, "");
+
+    //absolute (old behavior)
+    if(!absolute_equality<>::equal(1.0, 1.0 + 1e-15) ||
+        absolute_equality<>::equal(1.0, 1.0 + 1e-12) ||
+        absolute_equality<>::equal(1e20, std::nextafter(1e20, 2e20)))
+    {
+        throw std::logic_error("absolute_equality");
+    }
+
+    //relative
+    if(!relative_equality<>::equal(1e20, 1e20 * (1 + 1e-15)) ||
+        relative_equality<>::equal(1e20, 1e20 * (1 + 1e-12)) ||
+       !relative_equality<>::equal(0.0, -0.0) ||
+        relative_equality<>::equal(0.0, 1e-300))
+    {
+        throw std::logic_error("relative_equality");
+    }
+
+    //ULP
+    {
+        double x = 1e20;
+        double y = x;
+        for(int i = 0; i < 4; ++i) y = std::nextafter(y, 2e20);
+        if(!ulp_equality<4>::equal(x, y) ||
+            ulp_equality<3>::equal(x, y) ||
+           !ulp_equality<0>::equal(0.0, -0.0) ||
+           !ulp_equality<2>::equal(-std::numeric_limits<double>::denorm_min(),
+                                   std::numeric_limits<double>::denorm_min()) ||
+            ulp_equality<4>::equal(-1.0, 1.0) ||
+            ulp_equality<4>::equal(std::nan(""), std::nan("")))
+        {
+            throw std::logic_error("ulp_equality<double>");
+        }
+
+        float a = -2.5f;
+        float b = std::nextafter(std::nextafter(a, -3.0f), -3.0f);
+        if(!ulp_equality<2>::equal(a, b) || ulp_equality<1>::equal(a, b)) {
+            throw std::logic_error("ulp_equality<float>");
+        }
+
+        if(!ulp_equality<2>::equal(10, 12) || ulp_equality<2>::equal(-1, 2)) {
+            throw std::logic_error("ulp_equality<int>");
+        }
+    }
+
+    //sequences with explicit policies
+    {
+        using lin_rel = linear_sequence<double,relative_equality<>>;
+        using lin_ulp = linear_sequence<double,ulp_equality<16>>;
+
+        if(count_values(linear_sequence<int>{0,3,30}) != 11 ||
+           count_values(lin_rel{0.5,0.25,25.5}) != 101 ||
+           count_values(lin_ulp{0.5,0.25,25.5}) != 101 ||
+           count_values(geometric_sequence<double,relative_equality<>>{
+                            1.0, 2.0, 1024.0}) != 11)
+        {
+            throw std::logic_error("sequence equality policy");
+        }
+
+        //large magnitudes: absolute tolerance would be exact compare here
+        auto g = lin_rel{1e20, 1e18, 2e20};
+        if(count_values(g) != 101 || g.end() != (g + 101)) {
+            throw std::logic_error("relative policy: large values");
+        }
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        equality_policies();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what();
+        return 1;
+    }
+}
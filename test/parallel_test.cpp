@@ -0,0 +1,133 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include "parallel.h"
+#include "linear.h"
+#include "geometric.h"
+#include "combined.h"
+#include "repeated.h"
+
+#include <atomic>
+#include <cmath>
+#include <vector>
+#include <iostream>
+
+
+
+//-------------------------------------------------------------------
+// jump-ahead of floating-point sequences (pow) may differ
+// from repeated stepping in the last few bits
+struct same_value {
+    bool operator () (int a, int b) const { return a == b; }
+
+    bool operator () (double a, double b) const {
+        return std::abs(a - b) <= 1e-9 * std::abs(b);
+    }
+};
+
+
+//-------------------------------------------------------------------
+template<class Sequence, class T>
+void check_fill(const Sequence& g, std::size_t n, std::size_t threads,
+                const std::vector<T>& init)
+{
+    auto expected = std::vector<T>{};
+    auto s = g;
+    for(std::size_t i = 0; i < n && !s.empty(); ++i, ++s) {
+        expected.push_back(*s);
+    }
+
+    //unaligned output start
+    auto v = init;
+    auto out = am::parallel_fill(g, v.data() + 1, n, threads);
+    if(out != (v.data() + 1 + expected.size()) ||
+       !std::equal(expected.begin(), expected.end(), v.begin() + 1,
+                   same_value{}) ||
+       !std::equal(v.begin() + 1 + expected.size(), v.end(),
+                   init.begin() + 1 + expected.size()))
+    {
+        throw std::logic_error("parallel_fill");
+    }
+
+    //non-pointer output iterator
+    auto w = init;
+    am::parallel_fill(g, w.begin(), n, threads);
+    if(!std::equal(expected.begin(), expected.end(), w.begin(),
+                   same_value{}))
+    {
+        throw std::logic_error("parallel_fill");
+    }
+}
+
+
+//-------------------------------------------------------------------
+void parallel_generation()
+{
+    using namespace am;
+    using lin_t = linear_sequence<int>;
+
+    const auto init = std::vector<int>(100002, -1);
+
+    for(std::size_t threads : {1, 2, 3, 8}) {
+        check_fill(lin_t{0,1,99999}, 100000, threads, init);
+        check_fill(lin_t{0,1,99999}, 50000, threads, init);
+        check_fill(lin_t{7,3,1000}, 100000, threads, init);
+
+        check_fill(make_combined_sequence(
+                       lin_t{0,1,20000}, lin_t{5,-1,-30000}, lin_t{1,1,9}),
+                   100000, threads, init);
+
+        check_fill(make_repeated_sequence(lin_t{0,1,999}, 80), 100000,
+                   threads, init);
+
+        check_fill(geometric_sequence<double>{1.0, 1.0001, 1e10},
+                   100000, threads, std::vector<double>(100002, 0.0));
+    }
+
+    //parallel_for_each
+    for(std::size_t threads : {1, 4}) {
+        std::atomic<long long> sum{0};
+        std::atomic<std::size_t> count{0};
+
+        parallel_for_each(make_repeated_sequence(lin_t{1,1,1000}, 99),
+            [&](int x) { sum += x; ++count; }, threads);
+
+        if(count != 100000 || sum != 100 * 500500LL) {
+            throw std::logic_error("parallel_for_each");
+        }
+    }
+
+    //exceptions are propagated
+    bool thrown = false;
+    try {
+        parallel_for_each(lin_t{0,1,100000}, [](int x) {
+            if(x == 77777) throw std::runtime_error("x");
+        }, 4);
+    }
+    catch(std::runtime_error&) {
+        thrown = true;
+    }
+    if(!thrown) throw std::logic_error("parallel_for_each: exception");
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        parallel_generation();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what();
+        return 1;
+    }
+}
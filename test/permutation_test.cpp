@@ -0,0 +1,131 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include "permutation.h"
+#include "random.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <iostream>
+
+
+
+//-------------------------------------------------------------------
+template<std::size_t N>
+void check_enumeration()
+{
+    using perm_t = std::array<std::uint8_t,N>;
+    using seq_t = am::permutation_sequence<N>;
+
+    auto p = perm_t{};
+    for(std::size_t i = 0; i < N; ++i) p[i] = std::uint8_t(i);
+
+    const auto s = seq_t{};
+    auto v = std::vector<perm_t>{};
+    for(auto x : s) v.push_back(x);
+
+    //same order as std::next_permutation
+    std::size_t i = 0;
+    do {
+        if(i >= v.size() || v[i] != p) {
+            throw std::logic_error("permutation: lexicographic order");
+        }
+        ++i;
+    } while(std::next_permutation(p.begin(), p.end()));
+    if(i != v.size() || s.size() != v.size()) {
+        throw std::logic_error("permutation: size");
+    }
+
+    for(std::size_t k = 0; k < v.size(); ++k) {
+        if(s[k] != v[k] || *(s + k) != v[k] || seq_t::index_of(v[k]) != k) {
+            throw std::logic_error("permutation: random access");
+        }
+    }
+    if(!(s + v.size()).empty() || s + (v.size() + 1) != s.end()) {
+        throw std::logic_error("permutation: end");
+    }
+}
+
+
+//-------------------------------------------------------------------
+template<std::size_t N>
+void check_unranking()
+{
+    using seq_t = am::permutation_sequence<N>;
+
+    const auto s = seq_t{};
+    for(auto r : am::make_random_sequence(N, 500)) {
+        const auto i = r % s.size();
+        auto p = s[i];
+        if(seq_t::index_of(p) != i) throw std::logic_error("permutation: unrank");
+
+        auto x = s + i;
+        for(unsigned e = 0; e < N; ++e) {
+            if(x.element(e) != p[e]) throw std::logic_error("permutation: element");
+        }
+        if(i + 1 < s.size()) {
+            std::next_permutation(p.begin(), p.end());
+            if(*(++x) != p) throw std::logic_error("permutation: step");
+        }
+    }
+
+    //last permutation
+    auto last = *(s + (s.size() - 1));
+    for(std::size_t k = 0; k < N; ++k) {
+        if(last[k] != N - 1 - k) throw std::logic_error("permutation: last");
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+void permutation_sequence_test()
+{
+    check_enumeration<0>();
+    check_enumeration<1>();
+    check_enumeration<2>();
+    check_enumeration<3>();
+    check_enumeration<5>();
+    check_enumeration<8>();
+
+    check_unranking<10>();
+    check_unranking<16>();
+    check_unranking<17>();
+    check_unranking<20>();
+
+    if(am::permutation_sequence<20>{}.size() != 2432902008176640000ull) {
+        throw std::logic_error("permutation: 20!");
+    }
+
+    //partitioning among threads
+    const auto s = am::permutation_sequence<9>{};
+    auto a = std::vector<std::array<std::uint8_t,9>>(s.size());
+    auto b = std::vector<std::array<std::uint8_t,9>>{};
+    am::parallel_fill(s, a.data(), a.size(), 4);
+    for(auto p : s) b.push_back(p);
+    if(a != b) throw std::logic_error("permutation: parallel_fill");
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        permutation_sequence_test();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what();
+        return 1;
+    }
+}
@@ -0,0 +1,162 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include "primes.h"
+
+#include <cstdint>
+#include <vector>
+#include <iostream>
+
+
+
+//-------------------------------------------------------------------
+std::vector<std::uint64_t> reference_primes(std::uint64_t n)
+{
+    auto composite = std::vector<bool>(n + 1, false);
+    auto res = std::vector<std::uint64_t>{};
+    for(std::uint64_t i = 2; i <= n; ++i) {
+        if(composite[i]) continue;
+        res.push_back(i);
+        for(auto j = i * i; j <= n; j += i) composite[j] = true;
+    }
+    return res;
+}
+
+
+//-------------------------------------------------------------------
+bool is_prime(std::uint64_t n)
+{
+    if(n < 2) return false;
+    for(std::uint64_t d = 2; d * d <= n; ++d) {
+        if(n % d == 0) return false;
+    }
+    return true;
+}
+
+
+
+//-------------------------------------------------------------------
+void prime_enumeration()
+{
+    using namespace am;
+
+    //several segments
+    const std::uint64_t n = 3000000;
+    const auto ref = reference_primes(n);
+
+    const auto s = prime_sequence<std::uint32_t>{2, n};
+    auto v = std::vector<std::uint64_t>{};
+    for(auto p : s) v.push_back(p);
+    if(v != ref) throw std::logic_error("primes: enumeration");
+    if(s.size() != ref.size()) throw std::logic_error("primes: size");
+
+    //jumps within and across segments
+    for(std::size_t i = 0; i < ref.size(); i += 997) {
+        if(s[i] != ref[i] || *(s + i) != ref[i] || (s + i).size() != ref.size() - i) {
+            throw std::logic_error("primes: random access");
+        }
+    }
+    for(std::size_t i : {0, 1, 2, 3, 4, 75000, 78497, 78498, 78499}) {
+        if(s[i] != ref[i]) throw std::logic_error("primes: segment boundary");
+    }
+    if(!(s + ref.size()).empty() || s + (ref.size() + 10) != s.end()) {
+        throw std::logic_error("primes: end");
+    }
+
+    //sub-ranges
+    for(auto lo : {0, 1, 2, 3, 4, 6, 7, 8, 29, 30, 31, 983040, 983041}) {
+        for(auto hi : {0, 1, 2, 5, 6, 30, 31, 983039, 983040, 983041, 1000000}) {
+            auto w = std::vector<std::uint64_t>{};
+            for(auto p : make_prime_sequence<int>(lo, hi)) w.push_back(p);
+            auto e = std::vector<std::uint64_t>{};
+            for(auto p : ref) {
+                if(p >= std::uint64_t(lo) && p <= std::uint64_t(hi)) e.push_back(p);
+            }
+            if(w != e) throw std::logic_error("primes: sub-range");
+        }
+    }
+
+    //value type limit
+    const auto u16 = prime_sequence<std::uint16_t>{65000};
+    if(u16[0] != 65003 || u16.size() != 49 || (u16 + 48).size() != 1 ||
+       u16[48] != 65521)
+    {
+        throw std::logic_error("primes: 16 bit");
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+void prime_large_values()
+{
+    using namespace am;
+
+    //starting far out sieves only the segment(s) needed
+    const std::uint64_t start = 1000000000000ull;
+    auto s = prime_sequence<>{start};
+    if(*s != 1000000000039ull) throw std::logic_error("primes: 10^12");
+    std::uint64_t prev = *s;
+    for(int i = 0; i < 200; ++i) {
+        ++s;
+        for(auto x = prev + 1; x < *s; ++x) {
+            if(is_prime(x)) throw std::logic_error("primes: gap");
+        }
+        if(!is_prime(*s)) throw std::logic_error("primes: not prime");
+        prev = *s;
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+void prime_parallel()
+{
+    using namespace am;
+
+    //pi(10^7)
+    if(count_primes(0, 10000000, 1) != 664579 ||
+       count_primes(0, 10000000, 4) != 664579 ||
+       count_primes(5, 5, 2) != 1 || count_primes(8, 10, 2) != 0 ||
+       count_primes(10, 2) != 0)
+    {
+        throw std::logic_error("primes: count");
+    }
+
+    const auto ref = reference_primes(4000000);
+    const auto all = collect_primes<std::uint64_t>(0, 4000000, 3);
+    if(all != ref) throw std::logic_error("primes: collect");
+
+    const auto part = collect_primes<std::uint32_t>(1234567, 3456789);
+    auto e = std::vector<std::uint32_t>{};
+    for(auto p : ref) if(p >= 1234567 && p <= 3456789) e.push_back(std::uint32_t(p));
+    if(part != e) throw std::logic_error("primes: collect range");
+
+    auto seq = std::vector<std::uint32_t>{};
+    for(auto p : prime_sequence<std::uint32_t>{1234567, 3456789}) seq.push_back(p);
+    if(seq != part) throw std::logic_error("primes: sequence vs. parallel");
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        prime_enumeration();
+        prime_large_values();
+        prime_parallel();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what();
+        return 1;
+    }
+}
@@ -0,0 +1,176 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include "random.h"
+#include "segmented.h"
+#include "parallel.h"
+
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <iostream>
+
+
+
+//-------------------------------------------------------------------
+/// sequential SplitMix64 reference generator
+struct splitmix_reference
+{
+    explicit splitmix_reference(std::uint64_t s): state{s} {}
+
+    std::uint64_t operator () () {
+        state += 0x9E3779B97F4A7C15ull;
+        return am::seq_detail::splitmix64(state);
+    }
+
+    std::uint64_t state;
+};
+
+
+
+//-------------------------------------------------------------------
+void random_sequence_values()
+{
+    using namespace am;
+
+    //counter-based values == sequential SplitMix64 stream
+    //seeded with the first output of SplitMix64(seed)
+    for(std::uint64_t seed : {0ull, 1ull, 42ull, 0xFFFFFFFFFFFFFFFFull}) {
+        auto init = splitmix_reference{seed};
+        auto ref = splitmix_reference{init()};
+        auto s = random_sequence<>{seed, 1000};
+        std::size_t n = 0;
+        for(auto x : s) {
+            if(x != ref()) throw std::logic_error("random_sequence: reference");
+            ++n;
+        }
+        if(n != 1000) throw std::logic_error("random_sequence: size");
+    }
+
+    //adjacent seeds produce different streams
+    if(*random_sequence<>{1} == *random_sequence<>{2} ||
+       random_sequence<>{1}[7] == random_sequence<>{2}[7])
+    {
+        throw std::logic_error("random_sequence: seeds");
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+void random_sequence_access()
+{
+    using namespace am;
+
+    const auto s = make_random_sequence<std::uint32_t>(7, 5000);
+    auto v = std::vector<std::uint32_t>{};
+    for(auto x : s) v.push_back(x);
+    if(v.size() != 5000 || s.size() != 5000) {
+        throw std::logic_error("random_sequence: iteration");
+    }
+
+    //random access and jumps
+    for(std::size_t i = 0; i < v.size(); i += 37) {
+        if(s[i] != v[i] || *(s + i) != v[i] || (s + i).index() != i ||
+           (s + i).size() != v.size() - i)
+        {
+            throw std::logic_error("random_sequence: random access");
+        }
+    }
+    if(s + 10000 != s.end() || !(s + 5000).empty()) {
+        throw std::logic_error("random_sequence: end");
+    }
+
+    //batch generation
+    auto w = std::vector<std::uint32_t>(v.size() + 1, 0);
+    auto last = (s + 100).generate(w.data(), 2000);
+    if(last != w.data() + 2000 ||
+       !std::equal(w.begin(), w.begin() + 2000, v.begin() + 100))
+    {
+        throw std::logic_error("random_sequence: generate");
+    }
+    last = (s + 4990).generate(w.data(), 2000);
+    if(last != w.data() + 10) {
+        throw std::logic_error("random_sequence: generate (clamped)");
+    }
+
+    w.assign(v.size(), 0);
+    am::fill(s, w.begin(), w.end());
+    if(w != v) throw std::logic_error("random_sequence: fill");
+
+    //splitting into independent chunks
+    w.assign(v.size(), 0);
+    am::parallel_fill(s, w.data(), w.size(), 4);
+    if(w != v) throw std::logic_error("random_sequence: parallel_fill");
+}
+
+
+
+//-------------------------------------------------------------------
+void random_sequence_distribution()
+{
+    using namespace am;
+
+    const std::size_t n = 1 << 16;
+
+    auto d = std::vector<double>(n);
+    random_sequence<double>{3, n}.copy_to(d.data());
+    double sum = 0;
+    for(auto x : d) {
+        if(x < 0.0 || x >= 1.0) throw std::logic_error("random_sequence: [0,1)");
+        sum += x;
+    }
+    if(std::abs(sum / n - 0.5) > 0.01) {
+        throw std::logic_error("random_sequence: mean");
+    }
+
+    for(auto x : random_sequence<float>{5, n}) {
+        if(x < 0.0f || x >= 1.0f) throw std::logic_error("random_sequence: float");
+    }
+
+    //all bits are used
+    std::uint64_t ored = 0, anded = ~std::uint64_t(0);
+    for(auto x : random_sequence<std::uint64_t>{9, 256}) {
+        ored |= x;
+        anded &= x;
+    }
+    if(ored != ~std::uint64_t(0) || anded != 0) {
+        throw std::logic_error("random_sequence: bits");
+    }
+
+    int neg = 0;
+    for(auto x : random_sequence<std::int16_t>{11, 1000}) {
+        if(x < 0) ++neg;
+    }
+    if(neg < 400 || neg > 600) throw std::logic_error("random_sequence: sign");
+
+    int heads = 0;
+    for(auto x : random_sequence<bool>{13, 1000}) {
+        if(x) ++heads;
+    }
+    if(heads < 400 || heads > 600) throw std::logic_error("random_sequence: bool");
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        random_sequence_values();
+        random_sequence_access();
+        random_sequence_distribution();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what();
+        return 1;
+    }
+}
@@ -0,0 +1,109 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+/*
+ * the ranges integration requires C++20;
+ * compile with e.g. run_tests.py -o "-std=c++20 -O3 -Wall" to test it
+ */
+
+#include "ranges.h"
+#include "linear.h"
+#include "geometric.h"
+#include "fibonacci.h"
+#include "combined.h"
+#include "repeated.h"
+
+#include <vector>
+#include <iostream>
+#include <stdexcept>
+
+
+#if AMLIB_SEQUENCE_RANGES
+
+#include <algorithm>
+#include <numeric>
+#include <ranges>
+
+
+//-------------------------------------------------------------------
+void sequence_ranges()
+{
+    using namespace am;
+    using lin_t = linear_sequence<int>;
+
+    static_assert(Sequence<lin_t>);
+    static_assert(RandomAccessSequence<lin_t>);
+    static_assert(Sequence<fibonacci_sequence<int>>);
+    static_assert(!Sequence<std::vector<int>>);
+
+    using lin_view = sequence_view<lin_t>;
+    static_assert(std::ranges::view<lin_view>);
+    static_assert(std::ranges::random_access_range<lin_view>);
+    static_assert(std::ranges::sized_range<lin_view>);
+    static_assert(std::ranges::borrowed_range<lin_view>);
+    static_assert(std::ranges::input_range<
+                      sequence_view<fibonacci_sequence<int>>>);
+
+    {
+        auto v = std::vector<int>{};
+        std::ranges::copy(as_view(lin_t{0,2,20}), std::back_inserter(v));
+        if(v.size() != 11 || v.front() != 0 || v.back() != 20) {
+            throw std::logic_error("ranges: copy");
+        }
+    }
+
+    {
+        auto r = as_view(make_combined_sequence(lin_t{0,1,3}, lin_t{10,1,12}))
+               | std::views::reverse
+               | std::views::transform([](int x) { return 2 * x; });
+
+        auto v = std::vector<int>(r.begin(), r.end());
+        if(v != std::vector<int>{24,22,20,6,4,2,0}) {
+            throw std::logic_error("ranges: views");
+        }
+    }
+
+    {
+        auto r = as_view(make_repeated_sequence(lin_t{1,1,3}, 2));
+        if(r.size() != 9 || r[4] != 2 ||
+           std::accumulate(r.begin(), r.end(), 0) != 18)
+        {
+            throw std::logic_error("ranges: repeated");
+        }
+    }
+
+    {
+        auto v = std::vector<int>{};
+        for(auto x : as_view(fibonacci_sequence<int>{8})) v.push_back(x);
+        if(v != std::vector<int>{0,1,1,2,3,5,8,13}) {
+            throw std::logic_error("ranges: input range");
+        }
+    }
+}
+
+#else
+
+void sequence_ranges() {}
+
+#endif
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        sequence_ranges();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what();
+        return 1;
+    }
+}
@@ -11,6 +11,8 @@
 
 #include "repeated.h"
 #include "linear.h"
+#include "geometric.h"
+#include "combined.h"
 
 #include <vector>
 #include <iostream>
@@ -75,11 +77,186 @@ void repeated_sequence_generation()
 
 
 
+//-------------------------------------------------------------------
+template<class Seq1, class Seq2>
+void compare_sequences(const Seq1& a, const Seq2& b)
+{
+    using am::seq_detail::approx_equal;
+
+    auto va = std::vector<double>{};
+    for(auto x : a) va.push_back(x);
+
+    auto vb = std::vector<double>{};
+    for(auto x : b) vb.push_back(x);
+
+    if(va.size() != vb.size() || b.size() != vb.size()) {
+        throw std::logic_error("repeated_sequence: size");
+    }
+    for(std::size_t i = 0; i < va.size(); ++i) {
+        if(!approx_equal(va[i], vb[i]) ||
+           !approx_equal(va[i], double(b[i])) ||
+           !approx_equal(va[i], double(*(b + i))))
+        {
+            throw std::logic_error("repeated_sequence: values");
+        }
+    }
+    if((b + vb.size()) != b.end()) {
+        throw std::logic_error("repeated_sequence: end");
+    }
+}
+
+
+//-------------------------------------------------------------------
+template<class Seq1, class Seq2>
+void compare_cached_sequences(const Seq1& a, const Seq2& b)
+{
+    using am::seq_detail::approx_equal;
+
+    compare_sequences(a, b);
+
+    auto va = std::vector<double>{};
+    for(auto x : a) va.push_back(x);
+
+    auto vc = std::vector<typename Seq2::value_type>(b.size());
+    if(b.copy_to(vc.data()) != (vc.data() + vc.size())) {
+        throw std::logic_error("cached repeated_sequence: copy_to");
+    }
+    for(std::size_t i = 0; i < va.size(); ++i) {
+        if(!approx_equal(va[i], double(vc[i]))) {
+            throw std::logic_error("cached repeated_sequence: copy_to");
+        }
+    }
+}
+
+
+//-------------------------------------------------------------------
+void cached_repeated_sequence_generation()
+{
+    using namespace am;
+
+    for(std::size_t reps = 0; reps < 7; ++reps) {
+        compare_cached_sequences(
+            make_repeated_sequence(make_linear_sequence(8, -1, 1), reps),
+            make_cached_repeated_sequence(make_linear_sequence(8, -1, 1), reps));
+
+        compare_cached_sequences(
+            make_repeated_sequence(make_linear_sequence(8, -1, 1),
+                                   make_linear_sequence(5, -1, 1), reps),
+            make_cached_repeated_sequence(make_linear_sequence(8, -1, 1),
+                                          make_linear_sequence(5, -1, 1), reps));
+
+        compare_cached_sequences(
+            make_repeated_sequence(make_geometric_sequence(128.0, 0.5, 1.0), reps),
+            make_cached_repeated_sequence(make_geometric_sequence(128.0, 0.5, 1.0), reps));
+    }
+
+    {
+        auto g = make_cached_repeated_sequence(make_linear_sequence(0, 1, 3), 2);
+        g += 5;
+        if(*g != 1 || g.size() != 7 || g.repetitions_so_far() != 1) {
+            throw std::logic_error("cached repeated_sequence: +=");
+        }
+        g += 7;
+        if(g != g.end() || !g.empty()) {
+            throw std::logic_error("cached repeated_sequence: +=");
+        }
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+void compact_repeated_sequence_generation()
+{
+    using namespace am;
+
+    for(std::size_t reps = 0; reps < 7; ++reps) {
+        compare_sequences(
+            make_repeated_sequence(make_linear_sequence(8, -1, 1), reps),
+            make_compact_repeated_sequence(make_linear_sequence(8, -1, 1), reps));
+
+        compare_sequences(
+            make_repeated_sequence(make_linear_sequence(8, -1, 1),
+                                   make_linear_sequence(5, -1, 1), reps),
+            make_compact_repeated_sequence(make_linear_sequence(8, -1, 1),
+                                           make_linear_sequence(5, -1, 1), reps));
+    }
+
+    {
+        using lin_t = linear_sequence<int>;
+        using full_t = repeated_sequence<combined_sequence<
+                           repeated_sequence<lin_t>,lin_t>>;
+        using compact_t = repeated_sequence<combined_sequence<
+                              repeated_sequence<lin_t,share_period>,lin_t>,
+                              share_period>;
+
+        static_assert(sizeof(compact_t) < sizeof(full_t),
+                      "compact repeated_sequence not smaller");
+
+        auto full = full_t{ combined_sequence<repeated_sequence<lin_t>,lin_t>{
+                        make_repeated_sequence(lin_t{0,1,3}, 2), lin_t{10,1,12}},
+                        3 };
+
+        auto compact = compact_t{
+            combined_sequence<repeated_sequence<lin_t,share_period>,lin_t>{
+                make_compact_repeated_sequence(lin_t{0,1,3}, 2), lin_t{10,1,12}},
+            3 };
+
+        auto vf = std::vector<int>{};
+        for(auto x : full) vf.push_back(x);
+        auto vc = std::vector<int>{};
+        for(auto x : compact) vc.push_back(x);
+
+        if(vf != vc || vc.size() != 60) {
+            throw std::logic_error("compact repeated_sequence: nested");
+        }
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+template<class Seq>
+void check_empty_period(Seq g, const char* msg)
+{
+    auto v = std::vector<int>{};
+    for(auto x : g) v.push_back(x);
+
+    if(v != std::vector<int>{0,1,2} || g.size() != 3 || g[2] != 2 ||
+       *(g + 1) != 1 || !(g + 3).empty() || !(g + 10).empty() ||
+       (g + 10) != g.end())
+    {
+        throw std::logic_error(msg);
+    }
+}
+
+//-------------------------------------------------------------------
+void empty_period_repeated_sequences()
+{
+    using namespace am;
+    using lin_t = linear_sequence<int>;
+
+    const auto fst = lin_t{0,1,2};
+    const auto none = lin_t{1,1,0};
+
+    check_empty_period(make_repeated_sequence(fst, none, 4),
+                       "repeated_sequence: empty period");
+    check_empty_period(make_cached_repeated_sequence(fst, none, 4),
+                       "cached repeated_sequence: empty period");
+    check_empty_period(make_compact_repeated_sequence(fst, none, 4),
+                       "compact repeated_sequence: empty period");
+}
+
+
+
 //-------------------------------------------------------------------
 int main()
 {
     try {
         repeated_sequence_generation();
+        cached_repeated_sequence_generation();
+        compact_repeated_sequence_generation();
+        empty_period_repeated_sequences();
     }
     catch(std::exception& e) {
         std::cerr << e.what();
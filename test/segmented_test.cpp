@@ -0,0 +1,142 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include "segmented.h"
+#include "adaptors.h"
+#include "linear.h"
+#include "fibonacci.h"
+#include "combined.h"
+#include "repeated.h"
+
+#include <vector>
+#include <iostream>
+
+
+
+//-------------------------------------------------------------------
+template<class Sequence>
+void check_algorithms(const Sequence& g)
+{
+    auto expected = std::vector<int>{};
+    for(auto x : g) expected.push_back(x);
+
+    auto v = std::vector<int>{};
+    am::copy(g, std::back_inserter(v));
+    if(v != expected) {
+        throw std::logic_error("segmented: copy");
+    }
+
+    auto w = std::vector<int>(expected.size() / 2, -1);
+    if(am::fill(g, w.begin(), w.end()) != w.end() ||
+       !std::equal(w.begin(), w.end(), expected.begin()))
+    {
+        throw std::logic_error("segmented: fill");
+    }
+
+    auto u = std::vector<int>(expected.size() + 5, -1);
+    if(am::fill(g, u.begin(), u.end()) != (u.begin() + expected.size()) ||
+       !std::equal(expected.begin(), expected.end(), u.begin()))
+    {
+        throw std::logic_error("segmented: fill");
+    }
+
+    long long s = 0;
+    for(auto x : expected) s += x;
+    if(am::sum(g, 0LL) != s) {
+        throw std::logic_error("segmented: sum");
+    }
+
+    if(am::count(g, 3) != std::size_t(std::count(expected.begin(), expected.end(), 3))) {
+        throw std::logic_error("segmented: count");
+    }
+}
+
+
+//-------------------------------------------------------------------
+void segmented_iteration()
+{
+    using namespace am;
+    using lin_t = linear_sequence<int>;
+
+    check_algorithms(lin_t{0,1,20});
+    check_algorithms(fibonacci_sequence<int>{15});
+
+    {
+        auto g = make_combined_sequence(lin_t{0,1,5}, lin_t{3,1,8});
+        check_algorithms(g);
+        check_algorithms(g + 3);
+        check_algorithms(g + 8);
+    }
+
+    {
+        auto g = make_repeated_sequence(
+            make_combined_sequence(lin_t{0,1,5}, lin_t{3,-1,1}), 3);
+
+        int segments = 0;
+        for_each_segment(g, [&](const lin_t&) { ++segments; });
+        if(segments != 8) {
+            throw std::logic_error("segmented: for_each_segment");
+        }
+        check_algorithms(g);
+        check_algorithms(g + 7);
+    }
+
+    {
+        auto g = make_compact_repeated_sequence(lin_t{0,1,4}, 2);
+        check_algorithms(g);
+        check_algorithms(g + 6);
+    }
+
+    {
+        auto g = make_combined_sequence(
+            lin_t{0,1,3}, lin_t{3,1,2}, lin_t{3,1,5},
+            make_repeated_sequence(lin_t{7,1,9}, 2));
+
+        int segments = 0;
+        for_each_segment(g, [&](const auto&) { ++segments; });
+        if(segments != 5) {
+            throw std::logic_error("segmented: for_each_segment");
+        }
+        check_algorithms(g);
+        check_algorithms(g + 5);
+        check_algorithms(g + 9);
+    }
+
+    {
+        auto g = make_combined_sequence(std::vector<lin_t>{
+            lin_t{0,1,3}, lin_t{3,1,2}, lin_t{3,1,5}, lin_t{-2,-1,-5}});
+        check_algorithms(g);
+        check_algorithms(g + 5);
+    }
+
+    //segments without size
+    {
+        const auto odd = lin_t{0,1,20} | filter([](int x) { return x % 2; });
+        check_algorithms(odd);
+        check_algorithms(odd | transform([](int x) { return x / 3; }));
+        check_algorithms(make_combined_sequence(
+            lin_t{3,1,6} | transform([](int x) { return 2 * x; }), odd));
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        segmented_iteration();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what();
+        return 1;
+    }
+}
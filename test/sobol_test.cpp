@@ -0,0 +1,187 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include "sobol.h"
+#include "parallel.h"
+
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <iostream>
+
+
+
+//-------------------------------------------------------------------
+/// x^s + a_1 x^(s-1) + ... + a_(s-1) x + 1 is primitive over GF(2)
+bool is_primitive(unsigned s, std::uint64_t a)
+{
+    const std::uint64_t poly = (std::uint64_t(1) << s) | (a << 1) | 1;
+    const std::uint64_t period = (std::uint64_t(1) << s) - 1;
+    std::uint64_t x = 1;
+    for(std::uint64_t k = 1; k <= period; ++k) {
+        x <<= 1;
+        if(x >> s) x ^= poly;
+        if(x == 1) return k == period;
+    }
+    return false;
+}
+
+
+//-------------------------------------------------------------------
+void sobol_direction_numbers()
+{
+    using namespace am;
+
+    const auto& polys = seq_detail::joe_kuo_polynomials();
+    const auto dirs = sobol_directions::embedded();
+    if(dirs->dimensions() != 21) throw std::logic_error("sobol: dimensions");
+
+    for(std::size_t j = 0; j < polys.size(); ++j) {
+        const auto& p = polys[j];
+        if(!is_primitive(p.degree, p.coeffs)) {
+            throw std::logic_error("sobol: polynomial not primitive");
+        }
+        //integer recurrence m_k = 2a_1 m_(k-1) ^ ... ^ 2^s m_(k-s) ^ m_(k-s)
+        auto m = p.m;
+        const unsigned s = p.degree;
+        for(unsigned k = s; k < 60; ++k) {
+            auto x = (m[k-s] << s) ^ m[k-s];
+            for(unsigned i = 1; i < s; ++i) {
+                if((p.coeffs >> (s-1-i)) & 1) x ^= m[k-i] << i;
+            }
+            m.push_back(x);
+        }
+        for(int k = 0; k < 60; ++k) {
+            if((*dirs)(j+1, k) != (m[k] << (63 - k))) {
+                throw std::logic_error("sobol: direction numbers");
+            }
+        }
+    }
+
+    //reading Joe-Kuo format
+    auto is = std::istringstream{
+        "d       s       a       m_i\n"
+        "2       1       0       1\n"
+        "3       2       1       1 3\n"
+        "4       3       1       1 3 1\n"
+        "5       3       2       1 1 1\n"};
+    const auto d2 = sobol_directions::read(is, 4);
+    if(d2->dimensions() != 4) throw std::logic_error("sobol: read");
+    for(int k = 0; k < 64; ++k) {
+        for(int j = 0; j < 4; ++j) {
+            if((*d2)(j,k) != (*dirs)(j,k)) throw std::logic_error("sobol: read");
+        }
+    }
+
+    bool thrown = false;
+    try {
+        auto bad = std::istringstream{"2 2 1 1 2\n"};
+        sobol_directions::read(bad);
+    }
+    catch(std::invalid_argument&) { thrown = true; }
+    if(!thrown) throw std::logic_error("sobol: invalid direction numbers");
+
+    thrown = false;
+    try { sobol_sequence<double,5>{100, d2}; }
+    catch(std::invalid_argument&) { thrown = true; }
+    if(!thrown) throw std::logic_error("sobol: too few dimensions");
+}
+
+
+
+//-------------------------------------------------------------------
+void sobol_points()
+{
+    using namespace am;
+
+    const auto s = sobol_sequence<double,21>{1 << 12};
+    auto v = std::vector<std::array<double,21>>{};
+    for(const auto& p : s) v.push_back(p);
+    if(v.size() != (1 << 12)) throw std::logic_error("sobol: size");
+
+    //Gray-code order: point 2 is the natural point 3
+    if(v[1][0] != 0.5 || v[1][1] != 0.5 || v[2][0] != 0.75 || v[2][1] != 0.25) {
+        throw std::logic_error("sobol: first points");
+    }
+
+    //++, [] and += agree
+    for(std::size_t i = 0; i < v.size(); i += 41) {
+        if(s[i] != v[i] || *(s + i) != v[i] || (s + i).index() != i) {
+            throw std::logic_error("sobol: random access");
+        }
+    }
+
+    //each 1D projection of the first 2^m points is stratified
+    for(int m = 0; m <= 12; ++m) {
+        const std::size_t n = std::size_t(1) << m;
+        for(std::size_t j = 0; j < 21; ++j) {
+            auto hit = std::vector<bool>(n, false);
+            for(std::size_t i = 0; i < n; ++i) {
+                hit[std::size_t(v[i][j] * n)] = true;
+            }
+            for(bool h : hit) if(!h) throw std::logic_error("sobol: 1D strata");
+        }
+    }
+
+    //dimensions 1 and 2 form a (0,m,2)-net for every m
+    for(int m = 1; m <= 10; ++m) {
+        const std::size_t n = std::size_t(1) << m;
+        for(int a = 0; a <= m; ++a) {
+            const std::size_t nx = std::size_t(1) << a, ny = n / nx;
+            auto hit = std::vector<int>(n, 0);
+            for(std::size_t i = 0; i < n; ++i) {
+                ++hit[std::size_t(v[i][0] * nx) * ny + std::size_t(v[i][1] * ny)];
+            }
+            for(int h : hit) if(h != 1) throw std::logic_error("sobol: 2D net");
+        }
+    }
+
+    //SoA batch
+    auto w = std::vector<double>(21 * 1000, -1.0);
+    if((s + 7).generate_soa(w.data(), 1000) != 1000) {
+        throw std::logic_error("sobol: generate_soa");
+    }
+    for(std::size_t i = 0; i < 1000; ++i) {
+        for(std::size_t j = 0; j < 21; ++j) {
+            if(w[j*1000 + i] != v[7+i][j]) throw std::logic_error("sobol: SoA");
+        }
+    }
+    if((s + 4090).generate_soa(w.data(), 1000, 1000) != 6) {
+        throw std::logic_error("sobol: generate_soa (clamped)");
+    }
+
+    //splitting across threads
+    auto u = std::vector<std::array<double,21>>(v.size());
+    am::parallel_fill(s, u.data(), u.size(), 3);
+    if(u != v) throw std::logic_error("sobol: parallel_fill");
+
+    //far jump ahead
+    auto far = make_sobol_sequence<float,3>(~std::uint64_t(0)) + 0xFFFFFFFFull;
+    const auto next = far[1];
+    ++far;
+    if(*far != next) throw std::logic_error("sobol: jump ahead");
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        sobol_direction_numbers();
+        sobol_points();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what();
+        return 1;
+    }
+}
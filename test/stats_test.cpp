@@ -0,0 +1,136 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AM_SEQUENCE_STATS
+#define AM_SEQUENCE_STATS
+#endif
+
+#include "stats.h"
+#include "linear.h"
+#include "geometric.h"
+#include "combined.h"
+#include "repeated.h"
+#include "adaptors.h"
+#include "interleaved_bits.h"
+
+#include <sstream>
+#include <thread>
+#include <iostream>
+
+
+
+//-------------------------------------------------------------------
+void sequence_stats()
+{
+    using namespace am;
+    using seq_stats::op;
+    using lin_t = linear_sequence<int>;
+    using geo_t = geometric_sequence<double>;
+
+    seq_stats::reset();
+
+    {
+        auto g = lin_t{0,1,9};
+        int sum = 0;
+        for(auto s = g; !s.empty(); ++s) sum += *s;
+        sum += g[3];
+        g += 2;
+
+        if(seq_stats::get<lin_t>(op::increment) != 10 ||
+           seq_stats::get<lin_t>(op::subscript) != 1 ||
+           seq_stats::get<lin_t>(op::advance) != 1 ||
+           seq_stats::get<lin_t>(op::copy) != 1)
+        {
+            throw std::logic_error("stats: linear");
+        }
+    }
+
+    {
+        auto g = geo_t{1.0, 2.0, 1024.0};
+        auto x = g[3];
+        g += 2;
+        (void)x;
+        if(seq_stats::get<geo_t>(op::transcendental) != 2) {
+            throw std::logic_error("stats: geometric transcendental");
+        }
+    }
+
+    //wrap-around of repeated sequences copies the period sequence
+    {
+        auto g = make_repeated_sequence(lin_t{0,1,2}, 3);
+        seq_stats::reset();
+        for(; !g.empty(); ++g) {}
+
+        using rep_t = decltype(g);
+        if(seq_stats::get<rep_t>(op::increment) != 12 ||
+           seq_stats::get<lin_t>(op::copy) != 3)
+        {
+            throw std::logic_error("stats: repeated");
+        }
+    }
+
+    //adaptors and bit sequences are instrumented as well
+    {
+        const auto f = lin_t{0,1,9} | filter([](int x) { return x % 2 == 0; });
+        auto b = offset_interleaved_bit_sequence{3, 1};
+        seq_stats::reset();
+        for(auto s = f; !s.empty(); ++s) {}
+        for(; !b.empty(); ++b) {}
+
+        if(seq_stats::get<std::decay_t<decltype(f)>>(op::increment) != 5 ||
+           seq_stats::get<std::decay_t<decltype(f)>>(op::copy) != 1 ||
+           seq_stats::get<offset_interleaved_bit_sequence>(op::increment) != 5)
+        {
+            throw std::logic_error("stats: adaptors");
+        }
+    }
+
+    //counters are per thread
+    {
+        seq_stats::reset();
+        std::thread t{[] {
+            for(auto s = lin_t{0,1,99}; !s.empty(); ++s) {}
+        }};
+        t.join();
+        if(seq_stats::get<lin_t>(op::increment) != 0) {
+            throw std::logic_error("stats: thread-local");
+        }
+    }
+
+    //dump
+    {
+        seq_stats::reset();
+        for(auto s = lin_t{0,1,4}; !s.empty(); ++s) {}
+
+        std::ostringstream os;
+        seq_stats::dump(os);
+        const auto str = os.str();
+        if(str.find("linear_sequence") == std::string::npos ||
+           str.find("++: 5") == std::string::npos ||
+           str.find("geometric") != std::string::npos)
+        {
+            throw std::logic_error("stats: dump");
+        }
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        sequence_stats();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what();
+        return 1;
+    }
+}
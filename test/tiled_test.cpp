@@ -0,0 +1,111 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include "tiled.h"
+#include "linear.h"
+
+#include <vector>
+#include <iostream>
+
+
+
+//-------------------------------------------------------------------
+void tiled_sequence_generation()
+{
+    using namespace am;
+
+    {
+        auto v = std::vector<int>{};
+        for(auto x : make_tiled_sequence(make_linear_sequence(0,1,7), 4, 16)) {
+            v.push_back(x);
+        }
+        auto expected = std::vector<int>{};
+        for(int t = 0; t < 4; ++t) {
+            for(int i = 0; i < 8; ++i) expected.push_back(16*t + i);
+        }
+        if(v != expected) {
+            throw std::logic_error("tiled_sequence");
+        }
+    }
+
+    {
+        auto g = make_tiled_sequence(make_linear_sequence(0,2,6), 3, 100);
+        auto expected = std::vector<int>{0,2,4,6, 100,102,104,106,
+                                         200,202,204,206};
+
+        if(g.size() != expected.size() || g.back() != 206) {
+            throw std::logic_error("tiled_sequence: size");
+        }
+        for(std::size_t i = 0; i < expected.size(); ++i) {
+            if(g[i] != expected[i] || *(g + i) != expected[i]) {
+                throw std::logic_error("tiled_sequence: random access");
+            }
+            for(std::size_t j = 0; i+j < expected.size(); ++j) {
+                if((g + i)[j] != expected[i+j]) {
+                    throw std::logic_error("tiled_sequence: random access");
+                }
+            }
+        }
+        if((g + expected.size()) != g.end()) {
+            throw std::logic_error("tiled_sequence: end");
+        }
+
+        for(std::size_t i = 0; i <= expected.size(); ++i) {
+            auto s = g + i;
+            auto v = std::vector<int>(s.size());
+            if(s.copy_to(v.data()) != v.data() + v.size()) {
+                throw std::logic_error("tiled_sequence: copy_to");
+            }
+            if(v != std::vector<int>(expected.begin() + i, expected.end())) {
+                throw std::logic_error("tiled_sequence: copy_to");
+            }
+            auto w = std::vector<int>{};
+            s.copy_to(std::back_inserter(w));
+            if(w != v) {
+                throw std::logic_error("tiled_sequence: copy_to");
+            }
+        }
+    }
+
+    {
+        auto g = make_tiled_sequence(make_linear_sequence(0,1,7), 0, 16);
+        if(!g.empty() || g.size() != 0 || g != g.end()) {
+            throw std::logic_error("tiled_sequence: empty");
+        }
+    }
+
+    //empty tile
+    {
+        auto g = make_tiled_sequence(make_linear_sequence(0,1,-1), 3, 16);
+        if(!g.empty() || g.size() != 0 || g != g.end() ||
+           (g + 5) != g.end() || (g += 2) != g.end())
+        {
+            throw std::logic_error("tiled_sequence: empty tile");
+        }
+        auto v = std::vector<int>{};
+        for(auto x : g) v.push_back(x);
+        if(!v.empty()) throw std::logic_error("tiled_sequence: empty tile");
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        tiled_sequence_generation();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what();
+        return 1;
+    }
+}